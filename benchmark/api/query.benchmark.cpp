@@ -64,6 +64,66 @@ static void API_queryRenderedFeaturesLayerFromHighDensity(::benchmark::State& st
     }
 }
 
+// The same query as API_queryRenderedFeaturesAll, answered by the worker threads.
+static void API_queryRenderedFeaturesAllAsync(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(bench.box, {}, [&] (std::vector<Feature> features) {
+            ::benchmark::DoNotOptimize(features);
+            bench.loop.stop();
+        });
+        bench.loop.run();
+    }
+}
+
+// The same query as API_queryRenderedFeaturesAll, converting only the ids of the features.
+static void API_queryRenderedFeaturesAllIDs(::benchmark::State& state) {
+    QueryBenchmark bench;
+    RenderedQueryOptions options;
+    options.properties = std::vector<std::string>();
+    options.includeGeometry = false;
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->queryRenderedFeatures(bench.box, options);
+    }
+}
+
+// The same query as API_queryRenderedFeaturesAll, reading one property through handles.
+static void API_queryRenderedFeatureHandlesAll(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        for (const auto& feature : bench.frontend.getRenderer()->queryRenderedFeatureHandles(bench.box, {})) {
+            ::benchmark::DoNotOptimize(feature.getValue("class"));
+        }
+    }
+}
+
+static void API_querySourceFeaturesRoads(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.frontend.getRenderer()->querySourceFeatures("composite", {{{ "road" }}, {}});
+    }
+}
+
+// The same query as API_querySourceFeaturesRoads, reading one property through handles.
+static void API_querySourceFeatureHandlesRoads(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        for (const auto& feature : bench.frontend.getRenderer()->querySourceFeatureHandles("composite", {{{ "road" }}, {}})) {
+            ::benchmark::DoNotOptimize(feature.getValue("class"));
+        }
+    }
+}
+
 BENCHMARK(API_queryRenderedFeaturesAll);
+BENCHMARK(API_queryRenderedFeaturesAllAsync);
+BENCHMARK(API_queryRenderedFeaturesAllIDs);
+BENCHMARK(API_queryRenderedFeatureHandlesAll);
 BENCHMARK(API_queryRenderedFeaturesLayerFromLowDensity);
 BENCHMARK(API_queryRenderedFeaturesLayerFromHighDensity);
+BENCHMARK(API_querySourceFeaturesRoads);
+BENCHMARK(API_querySourceFeatureHandlesRoads);
@@ -5,6 +5,7 @@
 #include <mbgl/gl/headless_frontend.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/renderer/renderer.hpp>
+#include <mbgl/renderer/frame_profile.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
 #include <mbgl/storage/default_file_source.hpp>
@@ -13,6 +14,9 @@
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <climits>
+#include <unistd.h>
+
 using namespace mbgl;
 
 namespace {
@@ -36,6 +40,44 @@ static void prepare(Map& map, optional<std::string> json = {}) {
                                                            decodeImage(util::read_file("benchmark/fixtures/api/default_marker.png")), 1.0));
 }
  
+// The streets fixture style, with its tiles read from the local fixture directory instead of
+// the asset file source.
+static std::string localTilesStyle() {
+    char cwd[PATH_MAX + 1];
+    std::string style = util::read_file("test/fixtures/api/water.json");
+    const std::string assets = "asset://";
+    const std::string local = "file://" + std::string(getcwd(cwd, sizeof(cwd))) + "/test/fixtures/api/assets/";
+    style.replace(style.find(assets), assets.size(), local);
+    return style;
+}
+
+// Opaque fills of a polygon covering the world, so that every tile at the rendered zoom level
+// holds the same geometry, buffer included. With `masked` set, a line layer on the same source
+// that draws nothing forces a clipping mask on every tile again.
+static std::string opaqueFillsStyle(bool masked) {
+    std::string style = R"STYLE({
+  "version": 8,
+  "sources": {
+    "world": {
+      "type": "geojson",
+      "data": {
+        "type": "Polygon",
+        "coordinates": [ [ [ -180, -85 ], [ 180, -85 ], [ 180, 85 ], [ -180, 85 ], [ -180, -85 ] ] ]
+      }
+    }
+  },
+  "layers": [
+    { "id": "lower", "type": "fill", "source": "world",
+      "paint": { "fill-color": "#00f", "fill-antialias": false } },
+    { "id": "upper", "type": "fill", "source": "world",
+      "paint": { "fill-color": "#0f0", "fill-antialias": false } })STYLE";
+    if (masked) {
+        style += R"STYLE(,
+    { "id": "outline", "type": "line", "source": "world", "filter": [ "==", "missing", 1 ] })STYLE";
+    }
+    return style + "\n  ]\n}";
+}
+
 } // end namespace
 
 static void API_renderStill_reuse_map(::benchmark::State& state) {
@@ -73,6 +115,82 @@ static void API_renderStill_recreate_map(::benchmark::State& state) {
     }
 }
 
+// Renders a fresh map each iteration so that every tile is read from disk again.
+static void API_renderStill_local_tiles(::benchmark::State& state) {
+    RenderBenchmark bench;
+    const std::string style = localTilesStyle();
+
+    while (state.KeepRunning()) {
+        HeadlessFrontend frontend { { 512, 512 }, 1, bench.fileSource, bench.threadPool };
+        Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Still };
+        map.getStyle().loadJSON(style);
+        map.setLatLngZoom({ 37.85, -122.52 }, 10); // Tile 10/163/395
+        frontend.render(map);
+    }
+}
+
+static void API_renderStill_encode_png(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Still };
+    prepare(map);
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(encodePNG(frontend.render(map)));
+    }
+}
+
+static void API_renderStill_encode_png_pipelined(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Still };
+    prepare(map);
+
+    // Keep one encode in flight while the next frame renders.
+    std::future<std::string> previous;
+    while (state.KeepRunning()) {
+        auto next = frontend.renderPNG(map);
+        if (previous.valid()) {
+            ::benchmark::DoNotOptimize(previous.get());
+        }
+        previous = std::move(next);
+    }
+    if (previous.valid()) {
+        ::benchmark::DoNotOptimize(previous.get());
+    }
+}
+
+// Reports the draw calls of the clipping mask pass and of the whole frame; the time per
+// iteration is the frame time. Argument 1 adds a layer that needs a mask on every tile.
+static void API_renderStill_clipping_masks(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Still };
+    map.getStyle().loadJSON(opaqueFillsStyle(state.range(0) != 0));
+    map.setLatLngZoom({ 0, 0 }, 4);
+
+    std::size_t maskDraws = 0;
+    std::size_t drawCalls = 0;
+    frontend.getRenderer()->setFrameProfiling([&] (const FrameProfile& profile) {
+        drawCalls = profile.spans.front().drawCalls;
+        for (const auto& span : profile.spans) {
+            if (span.category == FrameProfile::Category::Pass && span.name == "clipping masks") {
+                maskDraws = span.drawCalls;
+            }
+        }
+    });
+
+    while (state.KeepRunning()) {
+        frontend.render(map);
+    }
+
+    state.SetLabel(std::to_string(maskDraws) + " mask draws, " + std::to_string(drawCalls) + " draw calls");
+}
+
 BENCHMARK(API_renderStill_reuse_map);
 BENCHMARK(API_renderStill_reuse_map_switch_styles);
 BENCHMARK(API_renderStill_recreate_map);
+BENCHMARK(API_renderStill_local_tiles);
+BENCHMARK(API_renderStill_encode_png);
+BENCHMARK(API_renderStill_encode_png_pipelined);
+BENCHMARK(API_renderStill_clipping_masks)->Arg(0)->Arg(1);
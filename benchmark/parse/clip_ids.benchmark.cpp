@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/algorithm/generate_clip_ids.hpp>
+#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+class ClippedRenderable {
+public:
+    ClippedRenderable(const UnwrappedTileID& id_)
+        : id(id_) {
+    }
+
+    UnwrappedTileID id;
+    ClipID clip;
+    bool used = true;
+};
+
+// Two sources covering a pitched view: a ring of z14 tiles with overzoomed z15 children in the
+// center, and a second source with a lower maxzoom covering the same area with z13 parents.
+std::vector<ClippedRenderable> tiles(uint8_t z, uint32_t x0, uint32_t y0, uint32_t count) {
+    std::vector<ClippedRenderable> result;
+    for (uint32_t x = x0; x < x0 + count; ++x) {
+        for (uint32_t y = y0; y < y0 + count; ++y) {
+            result.emplace_back(UnwrappedTileID{ z, x, y });
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+static void ClipIDGeneration(benchmark::State& state) {
+    auto first = tiles(14, 4096, 5824, 8);
+    auto children = tiles(15, 8196, 11652, 4);
+    first.insert(first.end(), children.begin(), children.end());
+    auto second = tiles(13, 2048, 2912, 4);
+
+    algorithm::ClipIDCache::Groups<ClippedRenderable> groups {
+        { first.begin(), first.end() },
+        { second.begin(), second.end() }
+    };
+
+    while (state.KeepRunning()) {
+        algorithm::ClipIDGenerator generator;
+        for (const auto& group : groups) {
+            generator.update(group);
+        }
+        benchmark::DoNotOptimize(generator.getClipIDs());
+    }
+}
+
+static void ClipIDCacheRestore(benchmark::State& state) {
+    auto first = tiles(14, 4096, 5824, 8);
+    auto children = tiles(15, 8196, 11652, 4);
+    first.insert(first.end(), children.begin(), children.end());
+    auto second = tiles(13, 2048, 2912, 4);
+
+    algorithm::ClipIDCache::Groups<ClippedRenderable> groups {
+        { first.begin(), first.end() },
+        { second.begin(), second.end() }
+    };
+
+    algorithm::ClipIDGenerator generator;
+    for (const auto& group : groups) {
+        generator.update(group);
+    }
+
+    algorithm::ClipIDCache cache;
+    cache.store(groups, generator.getClipIDs());
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(cache.restore(groups));
+    }
+}
+
+BENCHMARK(ClipIDGeneration);
+BENCHMARK(ClipIDCacheRestore);
@@ -2,10 +2,13 @@
 
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/style/conversion/filter.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
 
 #include <rapidjson/document.h>
 
@@ -38,5 +41,82 @@ static void Parse_EvaluateFilter(benchmark::State& state) {
     }
 }
 
+// Filters of every layer in the benchmark style, paired with the source layer they apply to.
+static std::vector<std::pair<std::string, style::Filter>> styleFilters() {
+    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
+    doc.Parse<0>(util::read_file("benchmark/fixtures/api/style.json").c_str());
+
+    std::vector<std::pair<std::string, style::Filter>> result;
+    const JSValue& layers = doc["layers"];
+    for (rapidjson::SizeType i = 0; i < layers.Size(); ++i) {
+        const JSValue& layer = layers[i];
+        if (!layer.HasMember("source-layer")) {
+            continue;
+        }
+        style::Filter filter;
+        if (layer.HasMember("filter")) {
+            style::conversion::Error error;
+            filter = *style::conversion::convert<style::Filter, JSValue>(layer["filter"], error);
+        }
+        result.emplace_back(layer["source-layer"].GetString(), std::move(filter));
+    }
+    return result;
+}
+
+// Evaluates every style layer's filter against every feature of its source layer in the
+// streets fixtures, the way GeometryTileWorker does during layout.
+template <class Evaluate>
+static void evaluateStyleFilters(benchmark::State& state, Evaluate&& evaluate) {
+    const auto filters = styleFilters();
+    std::vector<std::unique_ptr<VectorTileData>> tiles;
+    for (const auto& path : { "test/fixtures/api/assets/streets/0-0-0.vector.pbf",
+                              "test/fixtures/api/assets/streets/10-163-395.vector.pbf" }) {
+        tiles.push_back(std::make_unique<VectorTileData>(std::make_shared<std::string>(util::read_file(path))));
+    }
+
+    std::size_t evaluated = 0;
+    std::size_t matched = 0;
+    while (state.KeepRunning()) {
+        for (const auto& tile : tiles) {
+            for (const auto& entry : filters) {
+                auto layer = tile->getLayer(entry.first);
+                if (!layer) {
+                    continue;
+                }
+                matched += evaluate(entry.second, *layer);
+                evaluated += layer->featureCount();
+            }
+        }
+    }
+
+    benchmark::DoNotOptimize(matched);
+    state.SetItemsProcessed(evaluated);
+}
+
+static void Parse_EvaluateStyleFilters(benchmark::State& state) {
+    evaluateStyleFilters(state, [] (const style::Filter& filter, const GeometryTileLayer& layer) {
+        std::size_t matched = 0;
+        for (std::size_t i = 0; i < layer.featureCount(); i++) {
+            auto feature = layer.getFeature(i);
+            matched += filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); });
+        }
+        return matched;
+    });
+}
+
+static void Parse_EvaluateCompiledStyleFilters(benchmark::State& state) {
+    evaluateStyleFilters(state, [] (const style::Filter& filter, const GeometryTileLayer& layer) {
+        const style::CompiledFilter compiled(filter);
+        const auto keyIndices = compiled.resolveKeys(layer);
+        std::size_t matched = 0;
+        for (std::size_t i = 0; i < layer.featureCount(); i++) {
+            matched += compiled(*layer.getFeature(i), keyIndices);
+        }
+        return matched;
+    });
+}
+
 BENCHMARK(Parse_Filter);
 BENCHMARK(Parse_EvaluateFilter);
+BENCHMARK(Parse_EvaluateStyleFilters);
+BENCHMARK(Parse_EvaluateCompiledStyleFilters);
@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/function/camera_function.hpp>
+#include <mbgl/style/function/source_function.hpp>
+#include <mbgl/style/function/composite_function.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/color.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// The properties a data-driven style typically styles by, decoded from every feature of
+// the streets fixture so that the benchmarks measure function evaluation alone.
+class StyledFeature {
+public:
+    PropertyMap properties;
+
+    optional<Value> getValue(const std::string& key) const {
+        auto it = properties.find(key);
+        return it == properties.end() ? optional<Value>() : it->second;
+    }
+};
+
+std::vector<StyledFeature> streetsFeatures() {
+    const VectorTileData tile(std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    std::vector<StyledFeature> features;
+    for (const auto& name : tile.layerNames()) {
+        auto layer = tile.getLayer(name);
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            auto feature = layer->getFeature(i);
+            StyledFeature result;
+            for (const auto& key : { "class", "type", "scalerank", "localrank" }) {
+                if (auto value = feature->getValue(key)) {
+                    result.properties.emplace(key, *value);
+                }
+            }
+            features.push_back(std::move(result));
+        }
+    }
+    return features;
+}
+
+std::map<CategoricalValue, Color> classColors() {
+    std::map<CategoricalValue, Color> result;
+    for (const auto& name : { "motorway", "trunk", "primary", "secondary", "tertiary", "street",
+                              "street_limited", "service", "path", "rail", "park", "school",
+                              "hospital", "wood", "grass", "cemetery", "pitch", "industrial" }) {
+        result.emplace(std::string(name), Color::red());
+    }
+    return result;
+}
+
+} // namespace
+
+// A camera function with the given number of stops, evaluated at every zoom level
+// over a range the way render layers evaluate them each frame.
+static void Function_EvaluateCamera(benchmark::State& state) {
+    std::map<float, float> stops;
+    for (int i = 0; i < state.range_x(); ++i) {
+        stops.emplace(float(i) * 22 / state.range_x(), float(i));
+    }
+    const CameraFunction<float> function(ExponentialStops<float>(stops, 1.5f));
+
+    std::size_t evaluated = 0;
+    while (state.KeepRunning()) {
+        for (float zoom = 0; zoom < 22; zoom += 0.1f) {
+            benchmark::DoNotOptimize(function.evaluate(zoom));
+            evaluated++;
+        }
+    }
+    state.SetItemsProcessed(evaluated);
+}
+
+// Source functions of each stop type, evaluated for every feature the way
+// SourceFunctionPaintPropertyBinder does when populating vertex buffers.
+static void Function_EvaluateSource(benchmark::State& state) {
+    const auto features = streetsFeatures();
+    const SourceFunction<Color> color("class", CategoricalStops<Color>(classColors()), Color::black());
+    const SourceFunction<float> width("scalerank", ExponentialStops<float>({{ 0, 1 }, { 2, 4 }, { 4, 8 }, { 6, 16 }}, 1.2f));
+    const SourceFunction<float> opacity("localrank", IntervalStops<float>({{ 0, 1 }, { 5, 0.8f }, { 10, 0.5f }, { 20, 0.2f }}));
+
+    std::size_t evaluated = 0;
+    while (state.KeepRunning()) {
+        for (const auto& feature : features) {
+            benchmark::DoNotOptimize(color.evaluate(feature, Color::black()));
+            benchmark::DoNotOptimize(width.evaluate(feature, 1.0f));
+            benchmark::DoNotOptimize(opacity.evaluate(feature, 1.0f));
+        }
+        evaluated += features.size() * 3;
+    }
+    state.SetItemsProcessed(evaluated);
+}
+
+// Composite functions evaluated for every feature, both fully at a zoom level (as for layout
+// properties) and over a pair of zoom levels (as CompositeFunctionPaintPropertyBinder does).
+static void Function_EvaluateComposite(benchmark::State& state) {
+    const auto features = streetsFeatures();
+
+    std::map<float, std::map<CategoricalValue, float>> classStops;
+    std::map<float, std::map<float, float>> rankStops;
+    for (float zoom : { 5.0f, 10.0f, 15.0f, 20.0f }) {
+        for (const auto& stop : classColors()) {
+            classStops[zoom].emplace(stop.first, zoom);
+        }
+        rankStops[zoom] = {{ 0, zoom }, { 2, zoom * 2 }, { 4, zoom * 4 }, { 6, zoom * 8 }};
+    }
+    CompositeFunction<float> size("class", CompositeCategoricalStops<float>(classStops), 1.0f);
+    CompositeFunction<float> width("scalerank", CompositeExponentialStops<float>(rankStops, 1.2f), 1.0f);
+
+    const auto sizeRanges = size.rangeOfCoveringRanges({ 12.0f, 13.0f });
+    const auto widthRanges = width.rangeOfCoveringRanges({ 12.0f, 13.0f });
+
+    std::size_t evaluated = 0;
+    while (state.KeepRunning()) {
+        for (const auto& feature : features) {
+            benchmark::DoNotOptimize(size.evaluate(13.0f, feature, 1.0f));
+            benchmark::DoNotOptimize(width.evaluate(13.0f, feature, 1.0f));
+            benchmark::DoNotOptimize(size.evaluate(sizeRanges, feature, 1.0f));
+            benchmark::DoNotOptimize(width.evaluate(widthRanges, feature, 1.0f));
+        }
+        evaluated += features.size() * 4;
+    }
+    state.SetItemsProcessed(evaluated);
+}
+
+BENCHMARK(Function_EvaluateCamera)->Arg(2)->Arg(8)->Arg(32);
+BENCHMARK(Function_EvaluateSource);
+BENCHMARK(Function_EvaluateComposite);
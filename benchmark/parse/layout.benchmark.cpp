@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/buckets/fill_bucket.hpp>
+#include <mbgl/renderer/buckets/line_bucket.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/arena.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// Counts heap allocations, so that the benchmarks can report how many allocations the code
+// under test makes per iteration. This replaces the global allocation functions for the whole
+// benchmark binary, which only adds an atomic increment to each allocation.
+static std::atomic<std::size_t> heapAllocations { 0 };
+
+void* operator new(std::size_t size) {
+    heapAllocations++;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+using namespace mbgl;
+
+namespace {
+
+// The features of a source layer, with their geometries decoded up front so that the
+// benchmarks measure layout alone.
+class SourceLayer {
+public:
+    std::unique_ptr<GeometryTileLayer> layer;
+    std::vector<std::unique_ptr<GeometryTileFeature>> features;
+    std::vector<GeometryCollection> geometries;
+};
+
+class StreetsTile {
+public:
+    OverscaledTileID id;
+    std::vector<SourceLayer> layers;
+};
+
+std::vector<StreetsTile> streetsTiles() {
+    std::vector<StreetsTile> tiles;
+    for (const auto& id : { OverscaledTileID(0, 0, 0), OverscaledTileID(10, 163, 395) }) {
+        const auto& canonical = id.canonical;
+        const VectorTileData data(std::make_shared<std::string>(util::read_file(
+            "test/fixtures/api/assets/streets/" + util::toString(canonical.z) + "-" +
+            util::toString(canonical.x) + "-" + util::toString(canonical.y) + ".vector.pbf")));
+
+        StreetsTile tile { id, {} };
+        for (const auto& name : data.layerNames()) {
+            SourceLayer layer { data.getLayer(name), {}, {} };
+            for (std::size_t i = 0; i < layer.layer->featureCount(); i++) {
+                layer.features.push_back(layer.layer->getFeature(i));
+                layer.geometries.push_back(layer.features.back()->getGeometries());
+            }
+            tile.layers.push_back(std::move(layer));
+        }
+        tiles.push_back(std::move(tile));
+    }
+    return tiles;
+}
+
+// Reports the average number of heap and arena allocations per iteration.
+void setAllocationLabel(benchmark::State& state, std::size_t iterations, std::size_t heap, std::size_t arena) {
+    if (iterations) {
+        state.SetLabel("heap allocations: " + util::toString(heap / iterations) +
+                       ", arena allocations: " + util::toString(arena / iterations));
+    }
+}
+
+} // namespace
+
+// Lays out every feature of the streets fixture tiles into fill and line buckets, the way
+// GeometryTileWorker does, resetting the arena after each source layer.
+static void Layout_StreetsBuckets(benchmark::State& state) {
+    const auto tiles = streetsTiles();
+    const style::LineLayoutProperties::Unevaluated lineLayout;
+    Arena arena;
+
+    std::size_t iterations = 0;
+    std::size_t heap = 0;
+    std::size_t arenaAllocations = 0;
+    while (state.KeepRunning()) {
+        const std::size_t heapBefore = heapAllocations;
+        for (const auto& tile : tiles) {
+            const BucketParameters parameters { tile.id, MapMode::Continuous, 1.0f };
+            for (const auto& layer : tile.layers) {
+                FillBucket fill(parameters, {});
+                LineBucket line(parameters, {}, lineLayout);
+                for (std::size_t i = 0; i < layer.features.size(); i++) {
+                    const GeometryTileFeature& feature = *layer.features[i];
+                    if (feature.getType() == FeatureType::Polygon) {
+                        fill.addFeature(feature, layer.geometries[i], arena);
+                    }
+                    if (feature.getType() != FeatureType::Point) {
+                        line.addFeature(feature, layer.geometries[i], arena);
+                    }
+                }
+                benchmark::DoNotOptimize(fill.hasData() || line.hasData());
+                arenaAllocations += arena.allocationCount();
+                arena.reset();
+            }
+        }
+        heap += heapAllocations - heapBefore;
+        iterations++;
+    }
+    setAllocationLabel(state, iterations, heap, arenaAllocations);
+}
+
+// Classifies the rings of every polygon of the streets fixture tiles, with the polygons
+// allocated on the heap (Arg 0) or from an arena (Arg 1).
+static void Layout_ClassifyRings(benchmark::State& state) {
+    const auto tiles = streetsTiles();
+    const bool useArena = state.range_x();
+    Arena arena;
+
+    std::size_t iterations = 0;
+    std::size_t heap = 0;
+    std::size_t arenaAllocations = 0;
+    while (state.KeepRunning()) {
+        const std::size_t heapBefore = heapAllocations;
+        for (const auto& tile : tiles) {
+            for (const auto& layer : tile.layers) {
+                for (std::size_t i = 0; i < layer.features.size(); i++) {
+                    if (layer.features[i]->getType() != FeatureType::Polygon) {
+                        continue;
+                    }
+                    if (useArena) {
+                        benchmark::DoNotOptimize(classifyRings(layer.geometries[i], arena).size());
+                    } else {
+                        benchmark::DoNotOptimize(classifyRings(layer.geometries[i]).size());
+                    }
+                }
+                arenaAllocations += arena.allocationCount();
+                arena.reset();
+            }
+        }
+        heap += heapAllocations - heapBefore;
+        iterations++;
+    }
+    setAllocationLabel(state, iterations, heap, arenaAllocations);
+}
+
+BENCHMARK(Layout_StreetsBuckets);
+BENCHMARK(Layout_ClassifyRings)->Arg(0)->Arg(1);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/renderer/style_diff.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+
+#include <string>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+std::vector<std::unique_ptr<Layer>> makeLayers(std::size_t count) {
+    std::vector<std::unique_ptr<Layer>> layers;
+    for (std::size_t i = 0; i < count; ++i) {
+        layers.push_back(std::make_unique<FillLayer>("layer-" + std::to_string(i), "source"));
+    }
+    return layers;
+}
+
+Immutable<std::vector<ImmutableLayer>> toImpls(const std::vector<std::unique_ptr<Layer>>& layers) {
+    auto result = makeMutable<std::vector<ImmutableLayer>>();
+    for (auto& layer : layers) {
+        result->push_back(layer->baseImpl);
+    }
+    return std::move(result);
+}
+
+} // namespace
+
+// A single setPaintProperty call in the middle of the style.
+static void StyleDiff_ChangeLayer(benchmark::State& state) {
+    auto layers = makeLayers(state.range_x());
+    auto before = toImpls(layers);
+    layers[layers.size() / 2]->as<FillLayer>()->setFillOpacity(0.5f);
+    auto after = toImpls(layers);
+
+    while (state.KeepRunning()) {
+        auto result = diffLayers(before, after);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// A single addLayer call in the middle of the style.
+static void StyleDiff_AddLayer(benchmark::State& state) {
+    auto layers = makeLayers(state.range_x());
+    auto before = toImpls(layers);
+    layers.insert(layers.begin() + layers.size() / 2, std::make_unique<FillLayer>("added", "source"));
+    auto after = toImpls(layers);
+
+    while (state.KeepRunning()) {
+        auto result = diffLayers(before, after);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+// A full style reload, where every layer is replaced.
+static void StyleDiff_ReplaceAll(benchmark::State& state) {
+    auto before = toImpls(makeLayers(state.range_x()));
+    auto after = toImpls(makeLayers(state.range_x()));
+
+    while (state.KeepRunning()) {
+        auto result = diffLayers(before, after);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK(StyleDiff_ChangeLayer)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(StyleDiff_AddLayer)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(StyleDiff_ReplaceAll)->Arg(10)->Arg(100)->Arg(1000);
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+std::vector<std::string> streetsTiles() {
+    std::vector<std::string> tiles;
+    for (const auto& name : { "0-0-0", "10-163-395" }) {
+        tiles.push_back(util::read_file(std::string("test/fixtures/api/assets/streets/") + name + ".vector.pbf"));
+    }
+    return tiles;
+}
+
+} // namespace
+
+// Compresses the streets fixture tiles, as the offline database does on every insert.
+static void Util_Compress(benchmark::State& state) {
+    const auto tiles = streetsTiles();
+    const util::Codec& codec = util::zlib();
+
+    std::size_t bytes = 0;
+    while (state.KeepRunning()) {
+        for (const auto& tile : tiles) {
+            benchmark::DoNotOptimize(codec.compress(tile));
+            bytes += tile.size();
+        }
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+// Decompresses the streets fixture tiles, as the tile workers do for every compressed
+// response. Bytes processed are those of the inflated tiles.
+static void Util_Decompress(benchmark::State& state) {
+    const auto tiles = streetsTiles();
+    const util::Codec& codec = util::zlib();
+
+    std::vector<std::string> compressed;
+    for (const auto& tile : tiles) {
+        compressed.push_back(codec.compress(tile));
+    }
+
+    std::size_t bytes = 0;
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < compressed.size(); i++) {
+            benchmark::DoNotOptimize(codec.decompress(compressed[i]));
+            bytes += tiles[i].size();
+        }
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+BENCHMARK(Util_Compress);
+BENCHMARK(Util_Decompress);
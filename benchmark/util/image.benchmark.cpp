@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <string>
+
+using namespace mbgl;
+
+// Decodes a 256x256 raster tile fixture, as the raster tile workers do for every response.
+// Bytes processed are those of the decoded pixels.
+static void decodeTile(benchmark::State& state, const std::string& path) {
+    const std::string data = util::read_file(path);
+
+    std::size_t bytes = 0;
+    while (state.KeepRunning()) {
+        PremultipliedImage image = decodeImage(data);
+        bytes += image.bytes();
+        benchmark::DoNotOptimize(image.data.get());
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void Util_DecodePNG(benchmark::State& state) {
+    decodeTile(state, "test/fixtures/image/tile.png");
+}
+
+static void Util_DecodeJPEG(benchmark::State& state) {
+    decodeTile(state, "test/fixtures/image/tile.jpeg");
+}
+
+#if !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+static void Util_DecodeWebP(benchmark::State& state) {
+    decodeTile(state, "test/fixtures/image/tile.webp");
+}
+#endif // !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+
+// Premultiplies a 512x512 image with varying alpha, excluding the copy of the source image.
+static void Util_Premultiply(benchmark::State& state) {
+    UnassociatedImage source({ 512, 512 });
+    for (std::size_t i = 0; i < source.bytes(); i++) {
+        source.data[i] = i * 7;
+    }
+
+    std::size_t bytes = 0;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        UnassociatedImage image = source.clone();
+        state.ResumeTiming();
+
+        PremultipliedImage result = util::premultiply(std::move(image));
+        bytes += result.bytes();
+        benchmark::DoNotOptimize(result.data.get());
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+BENCHMARK(Util_DecodePNG);
+BENCHMARK(Util_DecodeJPEG);
+#if !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+BENCHMARK(Util_DecodeWebP);
+#endif // !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+BENCHMARK(Util_Premultiply);
@@ -9,7 +9,11 @@ set(MBGL_BENCHMARK_FILES
     benchmark/include/mbgl/benchmark.hpp
 
     # parse
+    benchmark/parse/clip_ids.benchmark.cpp
     benchmark/parse/filter.benchmark.cpp
+    benchmark/parse/function.benchmark.cpp
+    benchmark/parse/layout.benchmark.cpp
+    benchmark/parse/style_diff.benchmark.cpp
     benchmark/parse/tile_mask.benchmark.cpp
     benchmark/parse/vector_tile.benchmark.cpp
 
@@ -20,5 +24,7 @@ set(MBGL_BENCHMARK_FILES
     benchmark/src/mbgl/benchmark/benchmark.cpp
 
     # util
+    benchmark/util/compression.benchmark.cpp
     benchmark/util/dtoa.benchmark.cpp
+    benchmark/util/image.benchmark.cpp
 )
@@ -41,8 +41,12 @@ set(MBGL_TEST_FILES
 
     # renderer
     test/renderer/backend_scope.test.cpp
+    test/renderer/frame_profile.test.cpp
     test/renderer/group_by_layout.test.cpp
     test/renderer/image_manager.test.cpp
+    test/renderer/memory_report.test.cpp
+    test/renderer/paint_property_binder.test.cpp
+    test/renderer/style_diff.test.cpp
 
     # sprite
     test/sprite/sprite_loader.test.cpp
@@ -72,6 +76,7 @@ set(MBGL_TEST_FILES
     test/storage/headers.test.cpp
     test/storage/http_file_source.test.cpp
     test/storage/local_file_source.test.cpp
+    test/storage/mbtiles_file_source.test.cpp
     test/storage/offline.test.cpp
     test/storage/offline_database.test.cpp
     test/storage/offline_download.test.cpp
@@ -79,6 +84,9 @@ set(MBGL_TEST_FILES
     test/storage/resource.test.cpp
     test/storage/sqlite.test.cpp
 
+    # style
+    test/style/compiled_filter.test.cpp
+
     # style/conversion
     test/style/conversion/function.test.cpp
     test/style/conversion/geojson_options.test.cpp
@@ -91,6 +99,7 @@ set(MBGL_TEST_FILES
 
     # style/function
     test/style/function/camera_function.test.cpp
+    test/style/function/categorical_stops.test.cpp
     test/style/function/composite_function.test.cpp
     test/style/function/exponential_stops.test.cpp
     test/style/function/interval_stops.test.cpp
@@ -116,10 +125,13 @@ set(MBGL_TEST_FILES
     test/tile/raster_tile.test.cpp
     test/tile/tile_coordinate.test.cpp
     test/tile/tile_id.test.cpp
+    test/tile/tile_trace.test.cpp
     test/tile/vector_tile.test.cpp
 
     # util
+    test/util/arena.test.cpp
     test/util/async_task.test.cpp
+    test/util/compression.test.cpp
     test/util/dtoa.test.cpp
     test/util/geo.test.cpp
     test/util/http_timeout.test.cpp
@@ -40,7 +40,9 @@ public:
     ~Map();
 
     // Register a callback that will get called (on the render thread) when all resources have
-    // been loaded and a complete render occurs.
+    // been loaded and a complete render occurs. Calls made while a render is already in progress
+    // are coalesced into that render if the camera, size, style and debug options are unchanged;
+    // otherwise they are queued and rendered in order once it completes.
     using StillImageCallback = std::function<void (std::exception_ptr)>;
     void renderStill(StillImageCallback callback);
 
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <mbgl/style/source.hpp>
+#include <mbgl/util/chrono.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <string>
@@ -39,6 +41,10 @@ public:
     virtual void onDidFinishRenderingMap(RenderMode) {}
     virtual void onDidFinishLoadingStyle() {}
     virtual void onSourceChanged(style::Source&) {}
+
+    // Called in still mode when a render completes or fails, with the number of renderStill()
+    // calls it satisfied and the time elapsed since the first of them.
+    virtual void onDidFinishRenderingStill(std::size_t /* coalescedRequests */, Duration /* latency */) {}
 };
 
 } // namespace mbgl
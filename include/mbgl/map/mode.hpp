@@ -50,6 +50,7 @@ enum class MapDebugOptions : EnumType {
     StencilClip = 1 << 6,
     DepthBuffer = 1 << 7,
 #endif // MBGL_USE_GLES2
+    TileTimings = 1 << 8,
 };
 
 MBGL_CONSTEXPR MapDebugOptions operator|(MapDebugOptions lhs, MapDebugOptions rhs) {
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class CanonicalTileID;
+class GeometryTileFeature;
+class GeometryTileLayer;
+
+/**
+ * A feature returned by a query, which refers to the tile data it was found in instead of
+ * holding a copy of it. Its id, properties and geometry are read from the tile data when
+ * they're asked for, so that callers only pay for what they use. Handles are cheap to copy,
+ * and keep the tile data they refer to alive.
+ */
+class FeatureHandle {
+public:
+    FeatureHandle(std::shared_ptr<const GeometryTileLayer>,
+                  std::unique_ptr<const GeometryTileFeature>,
+                  const CanonicalTileID&);
+
+    optional<FeatureIdentifier> getID() const;
+    optional<Value> getValue(const std::string& key) const;
+    PropertyMap getProperties() const;
+
+    /** The geometry in latitude/longitude coordinates */
+    Feature::geometry_type getGeometry() const;
+
+    /**
+     * Converts the handle to a feature. If `properties` is set, only those properties are
+     * copied. Without `includeGeometry`, the feature has an empty geometry collection.
+     */
+    Feature toFeature(const optional<std::vector<std::string>>& properties = {},
+                      bool includeGeometry = true) const;
+
+private:
+    class Impl;
+    std::shared_ptr<const Impl> impl;
+};
+
+} // namespace mbgl
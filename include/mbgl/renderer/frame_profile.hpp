@@ -0,0 +1,50 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// Timings of a rendered frame, recorded when frame profiling is enabled on the Renderer.
+class FrameProfile {
+public:
+    enum class Category : uint8_t {
+        Frame,
+        Pass,
+        Layer,
+        Source
+    };
+
+    class Span {
+    public:
+        Category category;
+        std::string name;
+
+        // CPU time, with `start` relative to the start of the frame.
+        Duration start;
+        Duration duration;
+
+        // GPU time, if the OpenGL implementation supports timer queries. Spans without
+        // a timer query of their own report the sum of their children's GPU time.
+        optional<Duration> gpuDuration;
+
+        // Draw calls issued while the span was open, including those of nested spans.
+        std::size_t drawCalls;
+    };
+
+    TimePoint start;
+
+    // The first span covers the whole frame. Spans are ordered by start time, and
+    // nested spans follow the span that contains them.
+    std::vector<Span> spans;
+};
+
+// Encodes profiles in the Chrome trace event format, which can be loaded into chrome://tracing.
+std::string encodeChromeTrace(const std::vector<FrameProfile>&);
+
+} // namespace mbgl
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+enum class MemoryCategory : uint8_t {
+    Geometry,        // Layout vertices and indices of buckets, kept on the CPU after upload.
+    PaintAttributes, // Run-length encoded data-driven paint attributes of buckets.
+    Images,          // Raster tile pixels and style images.
+    Glyphs,          // Glyph bitmaps loaded for all font stacks.
+    Atlases,         // Glyph, icon and pattern atlas images kept on the CPU.
+    FeatureIndex,    // Spatial indexes used by queryRenderedFeatures.
+    TileData,        // Tile data retained for feature queries.
+    CollisionTiles,  // Symbol collision indexes.
+    CachedTiles,     // Everything held by tiles in a source's tile cache.
+    GPUBuffers,      // Vertex and index buffer storage requested from OpenGL.
+    GPUTextures,     // Texture storage requested from OpenGL.
+};
+
+// A breakdown of the memory held by a Renderer, as returned by Renderer::getMemoryReport().
+// Sizes count the storage of the underlying containers and images, and are approximate.
+class MemoryReport {
+public:
+    class Entry {
+    public:
+        // Empty for memory that isn't specific to a source or a layer.
+        std::string source;
+        std::string layer;
+
+        MemoryCategory category;
+        std::size_t bytes;
+    };
+
+    void add(std::string source, std::string layer, MemoryCategory, std::size_t bytes);
+
+    std::size_t total() const;
+    std::size_t total(MemoryCategory) const;
+    std::size_t totalForSource(const std::string&) const;
+    std::size_t totalForLayer(const std::string&) const;
+
+    std::vector<Entry> entries;
+};
+
+} // namespace mbgl
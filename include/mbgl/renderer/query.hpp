@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/util/optional.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/style/filter.hpp>
 
 #include <string>
@@ -22,6 +23,16 @@ public:
     optional<std::vector<std::string>> layerIDs;
 
     optional<style::Filter> filter;
+
+    /**
+     * The properties to copy into the returned features. If set, other properties are left
+     * out; an empty list returns features without properties.
+     */
+    optional<std::vector<std::string>> properties;
+
+    /** Whether to convert the geometries of the returned features. Features returned without
+        their geometry have an empty geometry collection. */
+    bool includeGeometry = true;
 };
 
 /**
@@ -38,6 +49,28 @@ public:
     optional<std::vector<std::string>> sourceLayers;
 
     optional<style::Filter> filter;
+
+    /** Only return features whose geometry intersects these bounds */
+    optional<LatLngBounds> bounds;
+
+    /**
+     * Features that span several tiles are returned once for each tile. If set, only the
+     * first feature with a given id is returned. Features without an id are always returned.
+     */
+    bool deduplicate = false;
+
+    /** The maximum number of features to return */
+    optional<std::size_t> limit;
+
+    /**
+     * The properties to copy into the returned features. If set, other properties are left
+     * out; an empty list returns features without properties.
+     */
+    optional<std::vector<std::string>> properties;
+
+    /** Whether to convert the geometries of the returned features. Features returned without
+        their geometry have an empty geometry collection. */
+    bool includeGeometry = true;
 };
 
 } // namespace mbgl
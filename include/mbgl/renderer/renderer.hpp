@@ -1,7 +1,10 @@
 #pragma once
 
 #include <mbgl/map/mode.hpp>
+#include <mbgl/renderer/feature_handle.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/memory_report.hpp>
+#include <mbgl/renderer/tile_timings.hpp>
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/geo.hpp>
@@ -14,6 +17,7 @@
 namespace mbgl {
 
 class FileSource;
+class FrameProfile;
 class RendererBackend;
 class RendererObserver;
 class RenderedQueryOptions;
@@ -32,19 +36,55 @@ public:
 
     void render(const UpdateParameters&);
 
-    // Feature queries
+    // Feature queries. querySourceFeatures() scans the source's tiles on the scheduler's
+    // threads, and blocks the calling thread until they are done.
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options = {}) const;
+
+    // Asynchronous feature queries. They copy what they need from the current frame and query
+    // the tiles on worker threads, so that rendering isn't blocked. The callback receives the
+    // same features as the synchronous queries, on the calling thread, which must have a run
+    // loop. Queries that are still pending when the renderer is destroyed are dropped.
+    using QueryCallback = std::function<void (std::vector<Feature>)>;
+    void queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&, QueryCallback);
+    void queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions&, QueryCallback);
+    void queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions&, QueryCallback);
+
+    // Feature queries that return handles to the features in the tile data, instead of
+    // copies of their properties and geometries. They suit callers that only look at a few
+    // properties of each feature. Like querySourceFeatures(), they scan the tiles on the
+    // scheduler's threads and block the calling thread until they are done.
+    std::vector<FeatureHandle> queryRenderedFeatureHandles(const ScreenLineString&, const RenderedQueryOptions& options = {}) const;
+    std::vector<FeatureHandle> queryRenderedFeatureHandles(const ScreenCoordinate& point, const RenderedQueryOptions& options = {}) const;
+    std::vector<FeatureHandle> queryRenderedFeatureHandles(const ScreenBox& box, const RenderedQueryOptions& options = {}) const;
+    std::vector<FeatureHandle> querySourceFeatureHandles(const std::string& sourceID, const SourceQueryOptions& options = {}) const;
+
     AnnotationIDs queryPointAnnotations(const ScreenBox& box) const;
 
     // Debug
     void dumpDebugLogs();
 
+    // Reports per-pass, per-layer and per-source timings of each frame to the callback, on
+    // the render thread. Profiles may be reported a few frames late, once GPU timings are
+    // available. An empty callback disables profiling, which is the default.
+    using FrameProfileCallback = std::function<void (const FrameProfile&)>;
+    void setFrameProfiling(FrameProfileCallback);
+
+    // Collects latency histograms of the stages tiles go through before they are rendered,
+    // which getTileTimings() returns. Also enabled while MapDebugOptions::TileTimings is
+    // set. Disabled by default.
+    void setTileTracing(bool);
+    TileTimings getTileTimings() const;
+
     // Memory
     void onLowMemory();
 
+    // Returns the memory held by the renderer, broken down by source, layer and category.
+    // GPU storage is reported as of the most recently rendered frame.
+    MemoryReport getMemoryReport() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl;
@@ -4,9 +4,11 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/size.hpp>
 #include <mbgl/util/util.hpp>
+#include <mbgl/util/optional.hpp>
 
 #include <memory>
 #include <mutex>
+#include <string>
 
 namespace mbgl {
 
@@ -16,6 +18,8 @@ using ProcAddress = void (*)();
 using FramebufferID = uint32_t;
 } // namespace gl
 
+class RenderStaticData;
+
 // The RendererBackend is used by the Renderer to facilitate
 // the actual rendering.
 class RendererBackend {
@@ -35,6 +39,11 @@ public:
     // set to the current state.
     virtual void bind() = 0;
 
+    // Returns the programs and static buffers for this backend's context. Every Renderer that
+    // draws through the same backend with the same pixel ratio shares a single instance, which is
+    // released along with the last Renderer using it. Must be called within a BackendScope.
+    std::shared_ptr<RenderStaticData> getStaticData(float pixelRatio, const optional<std::string>& programCacheDir);
+
 protected:
     // Called with the name of an OpenGL extension that should be loaded. RendererBackend implementations
     // must call the API-specific version that obtains the function pointer for this function,
@@ -79,6 +88,7 @@ protected:
 
 private:
     std::once_flag initialized;
+    std::weak_ptr<RenderStaticData> staticData;
 
     friend class BackendScope;
 };
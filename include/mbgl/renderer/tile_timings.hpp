@@ -0,0 +1,54 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace mbgl {
+
+// The stages tiles go through before they are rendered.
+enum class TileStage : uint8_t {
+    Request,      // From issuing the file source request until its response arrives.
+    Queue,        // Waiting in the worker's mailbox for a data, layers or placement change.
+    Layout,       // Laying out the tile's buckets on the worker.
+    Dependencies, // Waiting for the glyphs and images requested by layout.
+    Placement,    // Placing symbols on the worker.
+    Apply,        // Applying layout and placement results on the render thread.
+};
+
+// Latency histograms of each TileStage, collected while tile tracing is enabled on the Renderer.
+class TileTimings {
+public:
+    static constexpr std::size_t stageCount = 6;
+
+    class Histogram {
+    public:
+        // Bucket i counts durations shorter than 2^i milliseconds that don't fall into
+        // a lower bucket. The last bucket counts all longer durations.
+        static constexpr std::size_t bucketCount = 16;
+
+        void add(Duration);
+
+        // Returns an upper bound of the given quantile, in [0, 1], i.e. the upper end
+        // of the bucket containing it, or the maximum if that is lower.
+        Duration quantile(double) const;
+
+        std::array<uint64_t, bucketCount> buckets {};
+        uint64_t count = 0;
+        Duration total = Duration::zero();
+        Duration max = Duration::zero();
+    };
+
+    Histogram& operator[](TileStage stage) {
+        return stages[static_cast<std::size_t>(stage)];
+    }
+
+    const Histogram& operator[](TileStage stage) const {
+        return stages[static_cast<std::size_t>(stage)];
+    }
+
+    std::array<Histogram, stageCount> stages;
+};
+
+} // namespace mbgl
@@ -65,10 +65,16 @@ public:
     // Includes auxiliary data if this is a tile request.
     optional<TileData> tileData;
 
+    // When set, file sources may hand out the data still compressed, as it was received from
+    // the server or stored in the cache, rather than inflating it themselves. The requestor
+    // then has to check `Response::compressed`.
+    bool acceptsCompressedData = false;
+
     optional<Timestamp> priorModified = {};
     optional<Timestamp> priorExpires = {};
     optional<std::string> priorEtag = {};
     std::shared_ptr<const std::string> priorData;
+    bool priorDataCompressed = false;
 };
 
 } // namespace mbgl
@@ -34,6 +34,10 @@ public:
     // The actual data of the response. Present only for non-error, non-notModified responses.
     std::shared_ptr<const std::string> data;
 
+    // This is set to true when `data` is still zlib- or gzip-compressed, which only happens
+    // for requests whose resource accepts compressed data. `util::decompress` inflates it.
+    bool compressed = false;
+
     optional<Timestamp> modified;
     optional<Timestamp> expires;
     optional<std::string> etag;
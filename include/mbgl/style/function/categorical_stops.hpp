@@ -4,8 +4,10 @@
 #include <mbgl/util/variant.hpp>
 
 #include <cassert>
+#include <functional>
 #include <utility>
 #include <map>
+#include <unordered_map>
 
 namespace mbgl {
 namespace style {
@@ -15,18 +17,42 @@ public:
     using variant<bool, int64_t, std::string>::variant;
 };
 
+class CategoricalValueHash {
+public:
+    std::size_t operator()(const CategoricalValue& value) const {
+        return value.match([] (const auto& v) {
+            return std::hash<std::decay_t<decltype(v)>>()(v);
+        });
+    }
+};
+
 template <class T>
 class CategoricalStops {
 public:
     using Stops = std::map<CategoricalValue, T>;
 
-    Stops stops;
-
     CategoricalStops() = default;
     CategoricalStops(Stops stops_)
         : stops(std::move(stops_)) {
         assert(stops.size() > 0);
+        for (const auto& stop : stops) {
+            hashedStops.emplace(stop.first, &stop.second);
+        }
+    }
+
+    const Stops& getStops() const {
+        return stops;
+    }
+
+    // Copies index their own stops. Moving a map keeps its nodes, so moves keep the index.
+    CategoricalStops(const CategoricalStops& other)
+        : CategoricalStops(other.stops) {
+    }
+    CategoricalStops(CategoricalStops&&) = default;
+    CategoricalStops& operator=(const CategoricalStops& other) {
+        return *this = CategoricalStops(other);
     }
+    CategoricalStops& operator=(CategoricalStops&&) = default;
 
     optional<T> evaluate(const Value&) const;
 
@@ -34,6 +60,14 @@ public:
                            const CategoricalStops& rhs) {
         return lhs.stops == rhs.stops;
     }
+
+private:
+    // Fixed at construction, since evaluation looks up the index below.
+    Stops stops;
+
+    // `stops` hashed by key, referring to the keys and values in the map.
+    std::unordered_map<std::reference_wrapper<const CategoricalValue>, const T*,
+                       CategoricalValueHash, std::equal_to<CategoricalValue>> hashedStops;
 };
 
 } // namespace style
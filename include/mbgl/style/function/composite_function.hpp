@@ -7,8 +7,10 @@
 #include <mbgl/util/range.hpp>
 #include <mbgl/util/variant.hpp>
 
+#include <algorithm>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace mbgl {
 
@@ -47,43 +49,45 @@ public:
         : property(std::move(property_)),
           stops(std::move(stops_)),
           defaultValue(std::move(defaultValue_)) {
+        stops.match([&] (const auto& s) {
+            zooms.reserve(s.stops.size());
+            innerStops.reserve(s.stops.size());
+            for (const auto& stop : s.stops) {
+                zooms.push_back(stop.first);
+                innerStops.push_back(s.innerStops(stop.second));
+            }
+        });
     }
 
     struct CoveringRanges {
         float zoom;
         Range<float> coveringZoomRange;
-        Range<InnerStops> coveringStopsRange;
+        Range<std::size_t> coveringStopsRange; // Indices of the inner stops for each end of the zoom range.
     };
 
     // Return the relevant stop zoom values and inner stops that bracket a given zoom level. This
     // is the first step toward evaluating the function, and is used for in the course of both partial
     // evaluation of data-driven paint properties, and full evaluation of data-driven layout properties.
     CoveringRanges coveringRanges(float zoom) const {
-        return stops.match(
-            [&] (const auto& s) {
-                assert(!s.stops.empty());
-                auto minIt = s.stops.lower_bound(zoom);
-                auto maxIt = s.stops.upper_bound(zoom);
-                
-                // lower_bound yields first element >= zoom, but we want the *last*
-                // element <= zoom, so if we found a stop > zoom, back up by one.
-                if (minIt != s.stops.begin() && minIt != s.stops.end() && minIt->first > zoom) {
-                    minIt--;
-                }
-                
-                return CoveringRanges {
-                    zoom,
-                    Range<float> {
-                        minIt == s.stops.end() ? s.stops.rbegin()->first : minIt->first,
-                        maxIt == s.stops.end() ? s.stops.rbegin()->first : maxIt->first
-                    },
-                    Range<InnerStops> {
-                        s.innerStops(minIt == s.stops.end() ? s.stops.rbegin()->second : minIt->second),
-                        s.innerStops(maxIt == s.stops.end() ? s.stops.rbegin()->second : maxIt->second)
-                    }
-                };
-            }
-        );
+        assert(!zooms.empty());
+        const std::size_t last = zooms.size() - 1;
+        std::size_t minIndex = std::lower_bound(zooms.begin(), zooms.end(), zoom) - zooms.begin();
+        std::size_t maxIndex = std::upper_bound(zooms.begin(), zooms.end(), zoom) - zooms.begin();
+
+        // lower_bound yields first element >= zoom, but we want the *last*
+        // element <= zoom, so if we found a stop > zoom, back up by one.
+        if (minIndex != 0 && minIndex <= last && zooms[minIndex] > zoom) {
+            minIndex--;
+        }
+
+        minIndex = std::min(minIndex, last);
+        maxIndex = std::min(maxIndex, last);
+
+        return CoveringRanges {
+            zoom,
+            Range<float> { zooms[minIndex], zooms[maxIndex] },
+            Range<std::size_t> { minIndex, maxIndex }
+        };
     }
 
     // Given a range of zoom values (typically two adjacent integer zoom levels, e.g. 5.0 and 6.0),
@@ -143,10 +147,15 @@ private:
             return s.evaluate(value).value_or(defaultValue.value_or(finalDefaultValue));
         };
         return util::interpolate(
-            ranges.coveringStopsRange.min.match(eval),
-            ranges.coveringStopsRange.max.match(eval),
+            innerStops[ranges.coveringStopsRange.min].match(eval),
+            innerStops[ranges.coveringStopsRange.max].match(eval),
             util::interpolationFactor(1.0f, ranges.coveringZoomRange, ranges.zoom));
     }
+
+    // `stops`, flattened into the zoom of each outer stop and its inner stops, so that finding
+    // the covering stops for a zoom level doesn't copy them.
+    std::vector<float> zooms;
+    std::vector<InnerStops> innerStops;
 };
 
 } // namespace style
@@ -3,7 +3,9 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/interpolate.hpp>
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 namespace mbgl {
 namespace style {
@@ -13,28 +15,43 @@ class ExponentialStops {
 public:
     using Stops = std::map<float, T>;
 
-    Stops stops;
     float base = 1.0f;
 
     ExponentialStops() = default;
     ExponentialStops(Stops stops_, float base_ = 1.0f)
-        : stops(std::move(stops_)),
-          base(base_) {
+        : base(base_),
+          stops(std::move(stops_)) {
+        index();
+    }
+
+    const Stops& getStops() const {
+        return stops;
+    }
+
+    // Copies index their own stops. Moving a map keeps its nodes, so moves keep the index.
+    ExponentialStops(const ExponentialStops& other)
+        : ExponentialStops(other.stops, other.base) {
+    }
+    ExponentialStops(ExponentialStops&&) = default;
+    ExponentialStops& operator=(const ExponentialStops& other) {
+        return *this = ExponentialStops(other);
     }
+    ExponentialStops& operator=(ExponentialStops&&) = default;
 
     optional<T> evaluate(float z) const {
-        if (stops.empty()) {
+        if (inputs.empty()) {
             return {};
         }
 
-        auto it = stops.upper_bound(z);
-        if (it == stops.end()) {
-            return stops.rbegin()->second;
-        } else if (it == stops.begin()) {
-            return stops.begin()->second;
+        auto it = std::upper_bound(inputs.begin(), inputs.end(), z);
+        if (it == inputs.end()) {
+            return *outputs.back();
+        } else if (it == inputs.begin()) {
+            return *outputs.front();
         } else {
-            return util::interpolate(std::prev(it)->second, it->second,
-                util::interpolationFactor(base, { std::prev(it)->first, it->first }, z));
+            const std::size_t i = it - inputs.begin();
+            return util::interpolate(*outputs[i - 1], *outputs[i],
+                util::interpolationFactor(base, { inputs[i - 1], inputs[i] }, z));
         }
     }
 
@@ -50,6 +67,24 @@ public:
                            const ExponentialStops& rhs) {
         return lhs.stops == rhs.stops && lhs.base == rhs.base;
     }
+
+private:
+    // Fixed at construction, since evaluation searches the index below.
+    Stops stops;
+
+    void index() {
+        inputs.reserve(stops.size());
+        outputs.reserve(stops.size());
+        for (const auto& stop : stops) {
+            inputs.push_back(stop.first);
+            outputs.push_back(&stop.second);
+        }
+    }
+
+    // The keys of `stops` as a contiguous sorted array, which is cheaper to search than the
+    // map, and the value of each.
+    std::vector<float> inputs;
+    std::vector<const T*> outputs;
 };
 
 } // namespace style
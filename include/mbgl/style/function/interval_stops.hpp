@@ -2,7 +2,9 @@
 
 #include <mbgl/util/feature.hpp>
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 namespace mbgl {
 namespace style {
@@ -11,25 +13,39 @@ template <class T>
 class IntervalStops {
 public:
     using Stops = std::map<float, T>;
-    Stops stops;
 
     IntervalStops() = default;
     IntervalStops(Stops stops_)
         : stops(std::move(stops_)) {
+        index();
+    }
+
+    const Stops& getStops() const {
+        return stops;
+    }
+
+    // Copies index their own stops. Moving a map keeps its nodes, so moves keep the index.
+    IntervalStops(const IntervalStops& other)
+        : IntervalStops(other.stops) {
+    }
+    IntervalStops(IntervalStops&&) = default;
+    IntervalStops& operator=(const IntervalStops& other) {
+        return *this = IntervalStops(other);
     }
+    IntervalStops& operator=(IntervalStops&&) = default;
 
     optional<T> evaluate(float z) const {
-        if (stops.empty()) {
+        if (inputs.empty()) {
             return {};
         }
 
-        auto it = stops.upper_bound(z);
-        if (it == stops.end()) {
-            return stops.rbegin()->second;
-        } else if (it == stops.begin()) {
-            return stops.begin()->second;
+        auto it = std::upper_bound(inputs.begin(), inputs.end(), z);
+        if (it == inputs.end()) {
+            return *outputs.back();
+        } else if (it == inputs.begin()) {
+            return *outputs.front();
         } else {
-            return std::prev(it)->second;
+            return *outputs[it - inputs.begin() - 1];
         }
     }
 
@@ -45,6 +61,24 @@ public:
                            const IntervalStops& rhs) {
         return lhs.stops == rhs.stops;
     }
+
+private:
+    // Fixed at construction, since evaluation searches the index below.
+    Stops stops;
+
+    void index() {
+        inputs.reserve(stops.size());
+        outputs.reserve(stops.size());
+        for (const auto& stop : stops) {
+            inputs.push_back(stop.first);
+            outputs.push_back(&stop.second);
+        }
+    }
+
+    // The keys of `stops` as a contiguous sorted array, which is cheaper to search than the
+    // map, and the value of each.
+    std::vector<float> inputs;
+    std::vector<const T*> outputs;
 };
 
 } // namespace style
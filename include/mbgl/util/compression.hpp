@@ -5,8 +5,25 @@
 namespace mbgl {
 namespace util {
 
+// A compression format. Implementations are safe to use from multiple threads at once.
+class Codec {
+public:
+    virtual ~Codec() = default;
+
+    virtual std::string compress(const std::string& raw) const = 0;
+    virtual std::string decompress(const std::string& raw) const = 0;
+};
+
+// zlib, as stored by the offline database. Decompression accepts gzip data as well.
+const Codec& zlib();
+
 std::string compress(const std::string& raw);
+
+// Inflates both zlib and gzip data.
 std::string decompress(const std::string& raw);
 
+// Inflates deflate data without a zlib or gzip header.
+std::string decompressRaw(const std::string& raw);
+
 } // namespace util
 } // namespace mbgl
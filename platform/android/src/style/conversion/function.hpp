@@ -131,7 +131,7 @@ public:
     StopsEvaluator(jni::JNIEnv& _env) : env(_env) {}
 
     jni::jobject* operator()(const mbgl::style::CategoricalStops<T> &value) const {
-        return CategoricalStops::New(env, toFunctionStopJavaArray(env, value.stops)).Get();
+        return CategoricalStops::New(env, toFunctionStopJavaArray(env, value.getStops())).Get();
     }
 
     jni::jobject* operator()(const mbgl::style::CompositeCategoricalStops<T> &value) const {
@@ -139,7 +139,7 @@ public:
     }
 
     jni::jobject* operator()(const mbgl::style::ExponentialStops<T> &value) const {
-        return ExponentialStops::New(env, jni::Object<java::lang::Float>(*convert<jni::jobject*>(env, value.base)), toFunctionStopJavaArray(env, value.stops)).Get();
+        return ExponentialStops::New(env, jni::Object<java::lang::Float>(*convert<jni::jobject*>(env, value.base)), toFunctionStopJavaArray(env, value.getStops())).Get();
     }
 
     jni::jobject* operator()(const mbgl::style::CompositeExponentialStops<T> &value) const {
@@ -151,7 +151,7 @@ public:
     }
 
     jni::jobject* operator()(const mbgl::style::IntervalStops<T> &value) const {
-        return IntervalStops::New(env, toFunctionStopJavaArray(env, value.stops)).Get();
+        return IntervalStops::New(env, toFunctionStopJavaArray(env, value.getStops())).Get();
     }
 
     jni::jobject* operator()(const mbgl::style::CompositeIntervalStops<T> &value) const {
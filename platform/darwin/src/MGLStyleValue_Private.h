@@ -547,13 +547,13 @@ private: // Private utilities for converting from mbgl to mgl values
     public:
         id operator()(const mbgl::style::ExponentialStops<MBGLType> &mbglStops) {
             return [MGLCameraStyleFunction functionWithInterpolationMode:MGLInterpolationModeExponential
-                                                          stops:toConvertedStops(mbglStops.stops)
+                                                          stops:toConvertedStops(mbglStops.getStops())
                                                         options:@{MGLStyleFunctionOptionInterpolationBase: @(mbglStops.base)}];
         }
 
         id operator()(const mbgl::style::IntervalStops<MBGLType> &mbglStops) {
             return [MGLCameraStyleFunction functionWithInterpolationMode:MGLInterpolationModeInterval
-                                                          stops:toConvertedStops(mbglStops.stops)
+                                                          stops:toConvertedStops(mbglStops.getStops())
                                                         options:nil];
         }
     };
@@ -563,7 +563,7 @@ private: // Private utilities for converting from mbgl to mgl values
     public:
         id operator()(const mbgl::style::ExponentialStops<MBGLType> &mbglStops) {
             MGLSourceStyleFunction *sourceFunction = [MGLSourceStyleFunction functionWithInterpolationMode:MGLInterpolationModeExponential
-                                                                                            stops:toConvertedStops(mbglStops.stops)
+                                                                                            stops:toConvertedStops(mbglStops.getStops())
                                                                                     attributeName:@(mbglFunction.property.c_str())
                                                                                           options:@{MGLStyleFunctionOptionInterpolationBase: @(mbglStops.base)}];
             if (mbglFunction.defaultValue) {
@@ -574,7 +574,7 @@ private: // Private utilities for converting from mbgl to mgl values
 
         id operator()(const mbgl::style::IntervalStops<MBGLType> &mbglStops) {
             MGLSourceStyleFunction *sourceFunction = [MGLSourceStyleFunction functionWithInterpolationMode:MGLInterpolationModeInterval
-                                                                                            stops:toConvertedStops(mbglStops.stops)
+                                                                                            stops:toConvertedStops(mbglStops.getStops())
                                                                                     attributeName:@(mbglFunction.property.c_str())
                                                                                           options:nil];
             if (mbglFunction.defaultValue) {
@@ -584,8 +584,8 @@ private: // Private utilities for converting from mbgl to mgl values
         }
 
         id operator()(const mbgl::style::CategoricalStops<MBGLType> &mbglStops) {
-            NSMutableDictionary *stops = [NSMutableDictionary dictionaryWithCapacity:mbglStops.stops.size()];
-            for (const auto &mbglStop : mbglStops.stops) {
+            NSMutableDictionary *stops = [NSMutableDictionary dictionaryWithCapacity:mbglStops.getStops().size()];
+            for (const auto &mbglStop : mbglStops.getStops()) {
                 auto categoricalValue = mbglStop.first;
                 auto rawValue = toMGLRawStyleValue(mbglStop.second);
                 CategoricalValueVisitor categoricalValueVisitor;
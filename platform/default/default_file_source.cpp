@@ -2,6 +2,7 @@
 #include <mbgl/storage/asset_file_source.hpp>
 #include <mbgl/storage/file_source_request.hpp>
 #include <mbgl/storage/local_file_source.hpp>
+#include <mbgl/storage/mbtiles_file_source.hpp>
 #include <mbgl/storage/online_file_source.hpp>
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
@@ -119,6 +120,12 @@ public:
         } else if (LocalFileSource::acceptsURL(resource.url)) {
             //Local file request
             tasks[req] = localFileSource->request(resource, callback);
+        } else if (MBTilesFileSource::acceptsURL(resource.url)) {
+            // MBTiles archive request. Its reader threads are only started when needed.
+            if (!mbtilesFileSource) {
+                mbtilesFileSource = std::make_unique<MBTilesFileSource>();
+            }
+            tasks[req] = mbtilesFileSource->request(resource, callback);
         } else {
             // Try the offline database
             Resource revalidation = resource;
@@ -150,6 +157,7 @@ public:
                         // Since we can't return the data immediately, we'll have to hold on so that
                         // we can return it later in case we get a 304 Not Modified response.
                         revalidation.priorData = offlineResponse->data;
+                        revalidation.priorDataCompressed = offlineResponse->compressed;
                     }
                 }
             }
@@ -189,6 +197,7 @@ private:
     // shared so that destruction is done on the creating thread
     const std::shared_ptr<FileSource> assetFileSource;
     const std::unique_ptr<FileSource> localFileSource;
+    std::unique_ptr<FileSource> mbtilesFileSource;
     OfflineDatabase offlineDatabase;
     OnlineFileSource onlineFileSource;
     std::unordered_map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
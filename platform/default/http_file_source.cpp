@@ -9,6 +9,7 @@
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/timer.hpp>
 #include <mbgl/util/chrono.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/http_header.hpp>
 
 #include <curl/curl.h>
@@ -16,9 +17,21 @@
 #include <queue>
 #include <map>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <cstdio>
 
+// Checks for the two byte header of zlib data: deflate compression with a window of at most
+// 32K, and a check value that makes the header a multiple of 31.
+static bool hasZlibHeader(const std::string& data) {
+    if (data.size() < 2) {
+        return false;
+    }
+    const auto cmf = static_cast<uint8_t>(data[0]);
+    const auto flg = static_cast<uint8_t>(data[1]);
+    return (cmf & 0x0f) == 8 && (cmf >> 4) <= 7 && ((cmf << 8) | flg) % 31 == 0;
+}
+
 static void handleError(CURLMcode code) {
     if (code != CURLM_OK) {
         throw std::runtime_error(std::string("CURL multi error: ") + curl_multi_strerror(code));
@@ -84,6 +97,11 @@ private:
     optional<std::string> retryAfter;
     optional<std::string> xRateLimitReset;
 
+    // Set when the body is kept compressed as it came over the wire, with gzip or deflate
+    // content encoding respectively.
+    bool gzipped = false;
+    bool deflated = false;
+
     CURL *handle = nullptr;
     curl_slist *headers = nullptr;
 
@@ -258,6 +276,11 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl* context_, Resource resource_, Fil
 #else
     handleError(curl_easy_setopt(handle, CURLOPT_ENCODING, "gzip, deflate"));
 #endif
+    if (resource.acceptsCompressedData) {
+        // Keep the body as it came over the wire, so that it can be stored as-is and inflated
+        // by whoever parses it with `util::decompress`.
+        handleError(curl_easy_setopt(handle, CURLOPT_HTTP_CONTENT_DECODING, 0L));
+    }
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapboxGL/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
 
@@ -335,6 +358,16 @@ size_t HTTPRequest::headerCallback(char *const buffer, const size_t size, const
         baton->retryAfter = std::string(buffer + begin, length - begin - 2); // remove \r\n
     } else if ((begin = headerMatches("x-rate-limit-reset: ", buffer, length)) != std::string::npos) {
         baton->xRateLimitReset = std::string(buffer + begin, length - begin - 2); // remove \r\n
+    } else if ((begin = headerMatches("content-encoding: ", buffer, length)) != std::string::npos) {
+        const std::string value { buffer + begin, length - begin - 2 }; // remove \r\n
+        baton->gzipped = baton->resource.acceptsCompressedData &&
+            headerMatches("gzip", value.c_str(), value.size()) != std::string::npos;
+        baton->deflated = baton->resource.acceptsCompressedData &&
+            headerMatches("deflate", value.c_str(), value.size()) != std::string::npos;
+    } else if (headerMatches("http/", buffer, length) != std::string::npos) {
+        // The status line of another response, e.g. after a redirect.
+        baton->gzipped = false;
+        baton->deflated = false;
     }
 
     return length;
@@ -370,8 +403,17 @@ void HTTPRequest::handleResult(CURLcode code) {
         curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &responseCode);
 
         if (responseCode == 200) {
-            if (data) {
+            if (data && deflated && !hasZlibHeader(*data)) {
+                // `deflate` means zlib data, but some servers send raw deflate data instead,
+                // which `util::decompress` can't inflate. Inflate it here, as curl would have.
+                try {
+                    response->data = std::make_shared<std::string>(util::decompressRaw(*data));
+                } catch (const std::exception& ex) {
+                    response->error = std::make_unique<Error>(Error::Reason::Other, ex.what());
+                }
+            } else if (data) {
                 response->data = std::move(data);
+                response->compressed = gzipped || deflated;
             } else {
                 response->data = std::make_shared<std::string>();
             }
@@ -1,9 +1,8 @@
 #include <mbgl/util/image.hpp>
-#include <mbgl/util/char_array_buffer.hpp>
 
-#include <istream>
-#include <sstream>
-#include <array>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
 
 extern "C"
 {
@@ -12,62 +11,43 @@ extern "C"
 
 namespace mbgl {
 
-const static unsigned BUF_SIZE = 4096;
-
-struct jpeg_stream_wrapper {
-    jpeg_source_mgr manager;
-    std::istream* stream;
-    std::array<JOCTET, BUF_SIZE> buffer;
-};
-
-static void init_source(j_decompress_ptr cinfo) {
-    auto* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-    wrap->stream->seekg(0, std::ios_base::beg);
-}
+// A source manager that hands libjpeg the whole encoded image at once, instead of copying it
+// through a buffer.
+static void init_source(j_decompress_ptr) {}
 
 static boolean fill_input_buffer(j_decompress_ptr cinfo) {
-    auto* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-    wrap->stream->read(reinterpret_cast<char*>(&wrap->buffer[0]), BUF_SIZE);
-    std::streamsize size = wrap->stream->gcount();
-    wrap->manager.next_input_byte = wrap->buffer.data();
-    wrap->manager.bytes_in_buffer = BUF_SIZE;
-    return (size > 0) ? TRUE : FALSE;
+    // The data ran out before the image did. Insert a fake end of image marker, so that libjpeg
+    // finishes with a warning rather than reading past the data.
+    static const JOCTET eoi[] = { 0xFF, JPEG_EOI };
+    cinfo->src->next_input_byte = eoi;
+    cinfo->src->bytes_in_buffer = sizeof(eoi);
+    return TRUE;
 }
 
 static void skip(j_decompress_ptr cinfo, long count) {
     if (count <= 0) return; // A zero or negative skip count should be treated as a no-op.
-    auto* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-
-    if (wrap->manager.bytes_in_buffer > 0 && count < static_cast<long>(wrap->manager.bytes_in_buffer))
-    {
-        wrap->manager.bytes_in_buffer -= count;
-        wrap->manager.next_input_byte = &wrap->buffer[BUF_SIZE - wrap->manager.bytes_in_buffer];
-    }
-    else
-    {
-        wrap->stream->seekg(count - wrap->manager.bytes_in_buffer, std::ios_base::cur);
-        // trigger buffer fill
-        wrap->manager.next_input_byte = nullptr;
-        wrap->manager.bytes_in_buffer = 0; // bytes_in_buffer may be zero on return.
+    if (static_cast<size_t>(count) > cinfo->src->bytes_in_buffer) {
+        fill_input_buffer(cinfo);
+        return;
     }
+    cinfo->src->next_input_byte += count;
+    cinfo->src->bytes_in_buffer -= count;
 }
 
 static void term(j_decompress_ptr) {}
 
-static void attach_stream(j_decompress_ptr cinfo, std::istream* in) {
+static void attach_memory(j_decompress_ptr cinfo, const uint8_t* data, size_t size) {
     if (cinfo->src == nullptr) {
         cinfo->src = (struct jpeg_source_mgr *)
-            (*cinfo->mem->alloc_small) ((j_common_ptr) cinfo, JPOOL_PERMANENT, sizeof(jpeg_stream_wrapper));
+            (*cinfo->mem->alloc_small) ((j_common_ptr) cinfo, JPOOL_PERMANENT, sizeof(jpeg_source_mgr));
     }
-    auto * src = reinterpret_cast<jpeg_stream_wrapper*> (cinfo->src);
-    src->manager.init_source = init_source;
-    src->manager.fill_input_buffer = fill_input_buffer;
-    src->manager.skip_input_data = skip;
-    src->manager.resync_to_restart = jpeg_resync_to_restart;
-    src->manager.term_source = term;
-    src->manager.bytes_in_buffer = 0;
-    src->manager.next_input_byte = nullptr;
-    src->stream = in;
+    cinfo->src->init_source = init_source;
+    cinfo->src->fill_input_buffer = fill_input_buffer;
+    cinfo->src->skip_input_data = skip;
+    cinfo->src->resync_to_restart = jpeg_resync_to_restart;
+    cinfo->src->term_source = term;
+    cinfo->src->bytes_in_buffer = size;
+    cinfo->src->next_input_byte = data;
 }
 
 static void on_error(j_common_ptr) {}
@@ -90,9 +70,6 @@ struct jpeg_info_guard {
 };
 
 PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
-    util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
-    std::istream stream(&dataBuffer);
-
     jpeg_decompress_struct cinfo;
     jpeg_info_guard iguard(&cinfo);
     jpeg_error_mgr jerr;
@@ -100,12 +77,24 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     jerr.error_exit = on_error;
     jerr.output_message = on_error_message;
     jpeg_create_decompress(&cinfo);
-    attach_stream(&cinfo, &stream);
+    attach_memory(&cinfo, data, size);
 
     int ret = jpeg_read_header(&cinfo, TRUE);
     if (ret != JPEG_HEADER_OK)
         throw std::runtime_error("JPEG Reader: failed to read header");
 
+#ifdef JCS_ALPHA_EXTENSIONS
+    // libjpeg-turbo can write RGBA scanlines, which lets us decode straight into the image.
+    const bool directRGBA = cinfo.jpeg_color_space == JCS_YCbCr ||
+                            cinfo.jpeg_color_space == JCS_RGB ||
+                            cinfo.jpeg_color_space == JCS_GRAYSCALE;
+    if (directRGBA) {
+        cinfo.out_color_space = JCS_EXT_RGBA;
+    }
+#else
+    const bool directRGBA = false;
+#endif
+
     jpeg_start_decompress(&cinfo);
 
     if (cinfo.out_color_space == JCS_UNKNOWN)
@@ -122,6 +111,22 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     PremultipliedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
     uint8_t* dst = image.data.get();
 
+    if (directRGBA) {
+        // Read as many scanlines per call as the decoder produces at once.
+        std::unique_ptr<JSAMPROW[]> rows(new JSAMPROW[cinfo.rec_outbuf_height]);
+        while (cinfo.output_scanline < cinfo.output_height) {
+            const size_t remaining = cinfo.output_height - cinfo.output_scanline;
+            const size_t count = std::min<size_t>(cinfo.rec_outbuf_height, remaining);
+            for (size_t i = 0; i < count; ++i) {
+                rows[i] = dst + (cinfo.output_scanline + i) * width * 4;
+            }
+            jpeg_read_scanlines(&cinfo, rows.get(), static_cast<JDIMENSION>(count));
+        }
+
+        jpeg_finish_decompress(&cinfo);
+        return image;
+    }
+
     JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr) &cinfo, JPOOL_IMAGE, rowStride, 1);
 
     while (cinfo.output_scanline < cinfo.output_height) {
@@ -5,17 +5,41 @@
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/util.hpp>
-#include <mbgl/util/io.hpp>
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <unistd.h>
 
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
 namespace {
 
 const char* protocol = "file://";
 const std::size_t protocolLength = 7;
 
+// Reads a file straight into a string of its size, rather than through a stream buffer.
+std::shared_ptr<std::string> readFile(int fd, std::size_t size) {
+    auto data = std::make_shared<std::string>(size, '\0');
+    std::size_t offset = 0;
+    while (offset < size) {
+        const ssize_t count = ::read(fd, &(*data)[offset], size - offset);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count < 0) {
+            throw std::runtime_error(std::string("Cannot read file: ") + strerror(errno));
+        } else if (count == 0) {
+            // The file was truncated while we were reading it.
+            data->resize(offset);
+            break;
+        }
+        offset += count;
+    }
+    return data;
+}
+
 } // namespace
 
 namespace mbgl {
@@ -30,16 +54,22 @@ public:
 
         Response response;
 
+        const int fd = ::open(path.c_str(), O_RDONLY);
         struct stat buf;
-        int result = stat(path.c_str(), &buf);
 
-        if (result == 0 && S_ISDIR(buf.st_mode)) {
+        if (fd == -1 && errno == ENOENT) {
             response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
-        } else if (result == -1 && errno == ENOENT) {
+        } else if (fd == -1) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other, std::string("Cannot open file: ") + strerror(errno));
+        } else if (fstat(fd, &buf) == -1) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other, std::string("Cannot stat file: ") + strerror(errno));
+        } else if (S_ISDIR(buf.st_mode)) {
             response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
         } else {
             try {
-                response.data = std::make_shared<std::string>(util::read_file(path));
+                response.data = readFile(fd, buf.st_size);
             } catch (...) {
                 response.error = std::make_unique<Response::Error>(
                     Response::Error::Reason::Other,
@@ -47,13 +77,17 @@ public:
             }
         }
 
+        if (fd != -1) {
+            ::close(fd);
+        }
+
         req.invoke(&FileSourceRequest::setResponse, response);
     }
 
 };
 
-LocalFileSource::LocalFileSource()
-    : impl(std::make_unique<util::Thread<Impl>>("LocalFileSource")) {
+LocalFileSource::LocalFileSource(std::size_t readerCount_)
+    : readerCount(readerCount_) {
 }
 
 LocalFileSource::~LocalFileSource() = default;
@@ -61,7 +95,13 @@ LocalFileSource::~LocalFileSource() = default;
 std::unique_ptr<AsyncRequest> LocalFileSource::request(const Resource& resource, Callback callback) {
     auto req = std::make_unique<FileSourceRequest>(std::move(callback));
 
-    impl->actor().invoke(&Impl::request, resource.url, req->actor());
+    // Readers are started as requests come in, up to the maximum, and then take turns so that
+    // files are read in parallel.
+    if (readers.size() < readerCount) {
+        readers.push_back(std::make_unique<util::Thread<Impl>>("LocalFileSource"));
+    }
+    auto& reader = readers[nextReader++ % readers.size()];
+    reader->actor().invoke(&Impl::request, resource.url, req->actor());
 
     return std::move(req);
 }
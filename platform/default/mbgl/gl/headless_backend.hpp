@@ -17,6 +17,7 @@ public:
     void bind() override;
     void updateAssumedState() override;
 
+    Size getSize() const { return size; }
     void setSize(Size);
     PremultipliedImage readStillImage();
 
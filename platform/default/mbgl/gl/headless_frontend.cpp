@@ -1,26 +1,43 @@
 #include <mbgl/gl/headless_frontend.hpp>
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/map/map.hpp>
+#include <mbgl/actor/actor.hpp>
 #include <mbgl/util/run_loop.hpp>
 
 namespace mbgl {
 
+class HeadlessFrontend::Encoder {
+public:
+    std::string encode(PremultipliedImage image) {
+        return encodePNG(image);
+    }
+};
+
 HeadlessFrontend::HeadlessFrontend(float pixelRatio_, FileSource& fileSource, Scheduler& scheduler)
     : HeadlessFrontend({ 256, 256 }, pixelRatio_, fileSource, scheduler) {
 }
 
 HeadlessFrontend::HeadlessFrontend(Size size_, float pixelRatio_, FileSource& fileSource, Scheduler& scheduler)
+    : HeadlessFrontend(size_, pixelRatio_, fileSource, scheduler,
+                       std::make_shared<HeadlessBackend>(Size { static_cast<uint32_t>(size_.width * pixelRatio_),
+                                                                static_cast<uint32_t>(size_.height * pixelRatio_) })) {
+}
+
+HeadlessFrontend::HeadlessFrontend(Size size_, float pixelRatio_, FileSource& fileSource, Scheduler& scheduler,
+                                   std::shared_ptr<HeadlessBackend> backend_)
     : size(size_),
     pixelRatio(pixelRatio_),
-    backend({ static_cast<uint32_t>(size.width * pixelRatio),
-              static_cast<uint32_t>(size.height * pixelRatio) }),
+    backend(std::move(backend_)),
     asyncInvalidate([this] {
         if (renderer && updateParameters) {
-            mbgl::BackendScope guard { backend };
+            bindSize();
+            mbgl::BackendScope guard { *backend };
             renderer->render(*updateParameters);
         }
     }),
-    renderer(std::make_unique<Renderer>(backend, pixelRatio, fileSource, scheduler)) {
+    renderer(std::make_unique<Renderer>(*backend, pixelRatio, fileSource, scheduler)),
+    encoders({{ std::make_unique<Actor<Encoder>>(scheduler),
+                std::make_unique<Actor<Encoder>>(scheduler) }}) {
 }
 
 HeadlessFrontend::~HeadlessFrontend() = default;
@@ -50,19 +67,30 @@ Renderer* HeadlessFrontend::getRenderer() {
 }
 
 RendererBackend* HeadlessFrontend::getBackend() {
-    return &backend;
+    return backend.get();
 }
 
 void HeadlessFrontend::setSize(Size size_) {
     if (size != size_) {
         size = size_;
-        backend.setSize({ static_cast<uint32_t>(size_.width * pixelRatio),
-                          static_cast<uint32_t>(size_.height * pixelRatio) });
+        bindSize();
+    }
+}
+
+Size HeadlessFrontend::pixelSize() const {
+    return { static_cast<uint32_t>(size.width * pixelRatio),
+             static_cast<uint32_t>(size.height * pixelRatio) };
+}
+
+void HeadlessFrontend::bindSize() {
+    // A shared backend may have been resized by another frontend since we last rendered.
+    if (backend->getSize() != pixelSize()) {
+        backend->setSize(pixelSize());
     }
 }
 
 PremultipliedImage HeadlessFrontend::readStillImage() {
-    return backend.readStillImage();
+    return backend->readStillImage();
 }
 
 PremultipliedImage HeadlessFrontend::render(Map& map) {
@@ -72,7 +100,7 @@ PremultipliedImage HeadlessFrontend::render(Map& map) {
         if (error) {
             std::rethrow_exception(error);
         } else {
-            result = backend.readStillImage();
+            result = backend->readStillImage();
         }
     });
 
@@ -83,4 +111,10 @@ PremultipliedImage HeadlessFrontend::render(Map& map) {
     return result;
 }
 
+std::future<std::string> HeadlessFrontend::renderPNG(Map& map) {
+    auto& encoder = *encoders[nextEncoder];
+    nextEncoder = (nextEncoder + 1) % encoders.size();
+    return encoder.ask(&Encoder::encode, render(map));
+}
+
 } // namespace mbgl
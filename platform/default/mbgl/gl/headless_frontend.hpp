@@ -4,10 +4,15 @@
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/util/async_task.hpp>
 
+#include <array>
+#include <future>
 #include <memory>
+#include <string>
 
 namespace mbgl {
 
+template <class> class Actor;
+
 class FileSource;
 class Scheduler;
 class Renderer;
@@ -18,6 +23,12 @@ class HeadlessFrontend : public RendererFrontend {
 public:
     HeadlessFrontend(float pixelRatio_, FileSource&, Scheduler&);
     HeadlessFrontend(Size, float pixelRatio_, FileSource&, Scheduler&);
+
+    // Renders through a backend that may be shared with other frontends, so that all of them use
+    // a single GL context and a single set of compiled programs. Frontends sharing a backend must
+    // live on the same thread and take turns: a render() must complete before another frontend
+    // on the same backend starts rendering, since they draw into the same framebuffer.
+    HeadlessFrontend(Size, float pixelRatio_, FileSource&, Scheduler&, std::shared_ptr<HeadlessBackend>);
     ~HeadlessFrontend() override;
 
     void reset() override;
@@ -33,15 +44,28 @@ public:
     PremultipliedImage readStillImage();
     PremultipliedImage render(Map&);
 
+    // Renders a still image and reads it back synchronously, but hands the PNG encoding off to
+    // the worker scheduler so that the next render can start while this one is compressed.
+    // Encoding alternates between two workers. If the frontend is destroyed before encoding
+    // finishes, get() on the returned future throws std::future_error with broken_promise.
+    std::future<std::string> renderPNG(Map&);
+
 private:
+    Size pixelSize() const;
+    void bindSize();
+
     Size size;
     float pixelRatio;
 
-    HeadlessBackend backend;
+    std::shared_ptr<HeadlessBackend> backend;
     util::AsyncTask asyncInvalidate;
 
     std::unique_ptr<Renderer> renderer;
     std::shared_ptr<UpdateParameters> updateParameters;
+
+    class Encoder;
+    std::array<std::unique_ptr<Actor<Encoder>>, 2> encoders;
+    std::size_t nextEncoder = 0;
 };
 
 } // namespace mbgl
@@ -8,6 +8,8 @@
 
 #include "sqlite3.hpp"
 
+#include <zlib.h>
+
 namespace mbgl {
 
 OfflineDatabase::Statement::~Statement() {
@@ -50,7 +52,8 @@ void OfflineDatabase::ensureSchema() {
             case 3: // no-op and fall through
             case 4: migrateToVersion5(); // fall through
             case 5: migrateToVersion6(); // fall through
-            case 6: return;
+            case 6: migrateToVersion7(); // fall through
+            case 7: return;
             default: throw std::runtime_error("unknown schema version");
             }
 
@@ -84,7 +87,7 @@ void OfflineDatabase::ensureSchema() {
         db->exec("PRAGMA journal_mode = DELETE");
         db->exec("PRAGMA synchronous = FULL");
         db->exec(schema);
-        db->exec("PRAGMA user_version = 6");
+        db->exec("PRAGMA user_version = 7");
     } catch (...) {
         Log::Error(Event::Database, "Unexpected error creating database schema: %s", util::toString(std::current_exception()).c_str());
         throw;
@@ -135,6 +138,104 @@ void OfflineDatabase::migrateToVersion6() {
     transaction.commit();
 }
 
+// Moves tile payloads into the content-addressed tile_data table, so that tiles with identical
+// content share a single payload, and interns tile URL templates.
+void OfflineDatabase::migrateToVersion7() {
+    // Dropping the old tiles table would violate the foreign key constraint of region_tiles.
+    // The setting can't be changed within a transaction.
+    db->exec("PRAGMA foreign_keys = OFF");
+
+    try {
+        mapbox::sqlite::Transaction transaction(*db);
+
+        // clang-format off
+        db->exec(
+            "CREATE TABLE url_templates ( "
+            "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT, "
+            "  url_template TEXT NOT NULL, "
+            "  UNIQUE (url_template) "
+            "); "
+            "CREATE TABLE tile_data ( "
+            "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT, "
+            "  hash INTEGER NOT NULL, "
+            "  data BLOB NOT NULL, "
+            "  compressed INTEGER NOT NULL DEFAULT 0, "
+            "  refcount INTEGER NOT NULL DEFAULT 0 "
+            "); "
+            "CREATE TABLE tiles_v7 ( "
+            "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT, "
+            "  url_template_id INTEGER NOT NULL REFERENCES url_templates(id), "
+            "  pixel_ratio INTEGER NOT NULL, "
+            "  z INTEGER NOT NULL, "
+            "  x INTEGER NOT NULL, "
+            "  y INTEGER NOT NULL, "
+            "  expires INTEGER, "
+            "  modified INTEGER, "
+            "  etag TEXT, "
+            "  data_id INTEGER REFERENCES tile_data(id), "
+            "  accessed INTEGER NOT NULL, "
+            "  must_revalidate INTEGER NOT NULL DEFAULT 0, "
+            "  UNIQUE (url_template_id, pixel_ratio, z, x, y) "
+            "); "
+            "CREATE INDEX tile_data_hash ON tile_data (hash); "
+            "INSERT INTO url_templates (url_template) "
+            "SELECT DISTINCT url_template FROM tiles; "
+            "INSERT INTO tiles_v7 (id, url_template_id, pixel_ratio, z, x, y, expires, modified, etag, accessed, must_revalidate) "
+            "SELECT tiles.id, url_templates.id, pixel_ratio, z, x, y, expires, modified, etag, accessed, must_revalidate "
+            "FROM tiles, url_templates "
+            "WHERE url_templates.url_template = tiles.url_template ");
+        // clang-format on
+
+        // Tile IDs are preserved, so region_tiles stays valid.
+        mapbox::sqlite::Statement select = db->prepare(
+            "SELECT id, data, compressed FROM tiles WHERE data IS NOT NULL");
+        mapbox::sqlite::Statement update = db->prepare(
+            "UPDATE tiles_v7 SET data_id = ?1 WHERE id = ?2");
+        while (select.run()) {
+            update.bind(1, putTileData(select.get<std::string>(1), select.get<bool>(2)));
+            update.bind(2, select.get<int64_t>(0));
+            update.run();
+            update.reset();
+        }
+
+        // clang-format off
+        db->exec(
+            "DROP TABLE tiles; "
+            "ALTER TABLE tiles_v7 RENAME TO tiles; "
+            "CREATE INDEX tiles_accessed ON tiles (accessed); "
+            "UPDATE tile_data SET refcount = (SELECT COUNT(*) FROM tiles WHERE data_id = tile_data.id); "
+            "CREATE TRIGGER tiles_insert_data AFTER INSERT ON tiles "
+            "WHEN new.data_id IS NOT NULL "
+            "BEGIN "
+            "  UPDATE tile_data SET refcount = refcount + 1 WHERE id = new.data_id; "
+            "END; "
+            "CREATE TRIGGER tiles_update_data AFTER UPDATE OF data_id ON tiles "
+            "WHEN new.data_id IS NOT old.data_id "
+            "BEGIN "
+            "  UPDATE tile_data SET refcount = refcount + 1 WHERE id = new.data_id; "
+            "  UPDATE tile_data SET refcount = refcount - 1 WHERE id = old.data_id; "
+            "  DELETE FROM tile_data WHERE id = old.data_id AND refcount = 0; "
+            "END; "
+            "CREATE TRIGGER tiles_delete_data AFTER DELETE ON tiles "
+            "WHEN old.data_id IS NOT NULL "
+            "BEGIN "
+            "  UPDATE tile_data SET refcount = refcount - 1 WHERE id = old.data_id; "
+            "  DELETE FROM tile_data WHERE id = old.data_id AND refcount = 0; "
+            "END; "
+            "PRAGMA user_version = 7 ");
+        // clang-format on
+
+        transaction.commit();
+    } catch (...) {
+        // The transaction has been rolled back, but the setting is not part of it.
+        db->exec("PRAGMA foreign_keys = ON");
+        throw;
+    }
+
+    db->exec("PRAGMA foreign_keys = ON");
+    db->exec("PRAGMA incremental_vacuum");
+}
+
 OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
     auto it = statements.find(sql);
 
@@ -153,7 +254,7 @@ optional<Response> OfflineDatabase::get(const Resource& resource) {
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getInternal(const Resource& resource) {
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        return getTile(*resource.tileData);
+        return getTile(*resource.tileData, resource.acceptsCompressedData);
     } else {
         return getResource(resource);
     }
@@ -181,7 +282,12 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     bool compressed = false;
     uint64_t size = 0;
 
-    if (response.data) {
+    if (response.data && response.compressed) {
+        // Already compressed by the server; store it as-is.
+        compressedData = *response.data;
+        compressed = true;
+        size = compressedData.size();
+    } else if (response.data) {
         compressedData = util::compress(*response.data);
         compressed = compressedData.size() < response.data->size();
         size = compressed ? compressedData.size() : response.data->size();
@@ -243,10 +349,11 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     optional<std::string> data = stmt->get<optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (stmt->get<bool>(5)) {
+    } else if (stmt->get<bool>(5) && !resource.acceptsCompressedData) {
         response.data = std::make_shared<std::string>(util::decompress(*data));
         size = data->length();
     } else {
+        response.compressed = stmt->get<bool>(5);
         response.data = std::make_shared<std::string>(*data);
         size = data->length();
     }
@@ -359,16 +466,16 @@ bool OfflineDatabase::putResource(const Resource& resource,
     return true;
 }
 
-optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile) {
+optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile, bool acceptsCompressedData) {
     // clang-format off
     Statement accessedStmt = getStatement(
         "UPDATE tiles "
-        "SET accessed       = ?1 "
-        "WHERE url_template = ?2 "
-        "  AND pixel_ratio  = ?3 "
-        "  AND x            = ?4 "
-        "  AND y            = ?5 "
-        "  AND z            = ?6 ");
+        "SET accessed          = ?1 "
+        "WHERE url_template_id = (SELECT id FROM url_templates WHERE url_template = ?2) "
+        "  AND pixel_ratio     = ?3 "
+        "  AND x               = ?4 "
+        "  AND y               = ?5 "
+        "  AND z               = ?6 ");
     // clang-format on
 
     accessedStmt->bind(1, util::now());
@@ -381,14 +488,15 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
 
     // clang-format off
     Statement stmt = getStatement(
-        //        0      1           2,            3,      4,      5
-        "SELECT etag, expires, must_revalidate, modified, data, compressed "
+        //        0      1           2,            3,           4,               5
+        "SELECT etag, expires, must_revalidate, modified, tile_data.data, tile_data.compressed "
         "FROM tiles "
-        "WHERE url_template = ?1 "
-        "  AND pixel_ratio  = ?2 "
-        "  AND x            = ?3 "
-        "  AND y            = ?4 "
-        "  AND z            = ?5 ");
+        "LEFT JOIN tile_data ON tile_data.id = tiles.data_id "
+        "WHERE url_template_id = (SELECT id FROM url_templates WHERE url_template = ?1) "
+        "  AND pixel_ratio     = ?2 "
+        "  AND x               = ?3 "
+        "  AND y               = ?4 "
+        "  AND z               = ?5 ");
     // clang-format on
 
     stmt->bind(1, tile.urlTemplate);
@@ -412,10 +520,12 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     optional<std::string> data = stmt->get<optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (stmt->get<bool>(5)) {
+    } else if (stmt->get<bool>(5) && !acceptsCompressedData) {
         response.data = std::make_shared<std::string>(util::decompress(*data));
         size = data->length();
     } else {
+        // Leave inflating the data to the thread that parses the tile.
+        response.compressed = stmt->get<bool>(5);
         response.data = std::make_shared<std::string>(*data);
         size = data->length();
     }
@@ -426,13 +536,14 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
 optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
     // clang-format off
     Statement stmt = getStatement(
-        "SELECT length(data) "
+        "SELECT length(tile_data.data) "
         "FROM tiles "
-        "WHERE url_template = ?1 "
-        "  AND pixel_ratio  = ?2 "
-        "  AND x            = ?3 "
-        "  AND y            = ?4 "
-        "  AND z            = ?5 ");
+        "LEFT JOIN tile_data ON tile_data.id = tiles.data_id "
+        "WHERE url_template_id = (SELECT id FROM url_templates WHERE url_template = ?1) "
+        "  AND pixel_ratio     = ?2 "
+        "  AND x               = ?3 "
+        "  AND y               = ?4 "
+        "  AND z               = ?5 ");
     // clang-format on
 
     stmt->bind(1, tile.urlTemplate);
@@ -456,14 +567,14 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         // clang-format off
         Statement update = getStatement(
             "UPDATE tiles "
-            "SET accessed        = ?1, "
-            "    expires         = ?2, "
-            "    must_revalidate = ?3 "
-            "WHERE url_template  = ?4 "
-            "  AND pixel_ratio   = ?5 "
-            "  AND x             = ?6 "
-            "  AND y             = ?7 "
-            "  AND z             = ?8 ");
+            "SET accessed          = ?1, "
+            "    expires           = ?2, "
+            "    must_revalidate   = ?3 "
+            "WHERE url_template_id = (SELECT id FROM url_templates WHERE url_template = ?4) "
+            "  AND pixel_ratio     = ?5 "
+            "  AND x               = ?6 "
+            "  AND y               = ?7 "
+            "  AND z               = ?8 ");
         // clang-format on
 
         update->bind(1, util::now());
@@ -484,21 +595,28 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     // to INSERT a resource at the same moment.
     mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
 
+    optional<int64_t> dataID;
+    if (!response.noContent) {
+        dataID = putTileData(data, compressed);
+    }
+
+    // Replacing a tile's data_id releases its previous payload through the tiles_update_data
+    // trigger.
+
     // clang-format off
     Statement update = getStatement(
         "UPDATE tiles "
-        "SET modified        = ?1, "
-        "    etag            = ?2, "
-        "    expires         = ?3, "
-        "    must_revalidate = ?4, "
-        "    accessed        = ?5, "
-        "    data            = ?6, "
-        "    compressed      = ?7 "
-        "WHERE url_template  = ?8 "
-        "  AND pixel_ratio   = ?9 "
-        "  AND x             = ?10 "
-        "  AND y             = ?11 "
-        "  AND z             = ?12 ");
+        "SET modified          = ?1, "
+        "    etag              = ?2, "
+        "    expires           = ?3, "
+        "    must_revalidate   = ?4, "
+        "    accessed          = ?5, "
+        "    data_id           = ?6 "
+        "WHERE url_template_id = (SELECT id FROM url_templates WHERE url_template = ?7) "
+        "  AND pixel_ratio     = ?8 "
+        "  AND x               = ?9 "
+        "  AND y               = ?10 "
+        "  AND z               = ?11 ");
     // clang-format on
 
     update->bind(1, response.modified);
@@ -506,30 +624,37 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     update->bind(3, response.expires);
     update->bind(4, response.mustRevalidate);
     update->bind(5, util::now());
-    update->bind(8, tile.urlTemplate);
-    update->bind(9, tile.pixelRatio);
-    update->bind(10, tile.x);
-    update->bind(11, tile.y);
-    update->bind(12, tile.z);
 
-    if (response.noContent) {
-        update->bind(6, nullptr);
-        update->bind(7, false);
+    if (dataID) {
+        update->bind(6, *dataID);
     } else {
-        update->bindBlob(6, data.data(), data.size(), false);
-        update->bind(7, compressed);
+        update->bind(6, nullptr);
     }
 
+    update->bind(7, tile.urlTemplate);
+    update->bind(8, tile.pixelRatio);
+    update->bind(9, tile.x);
+    update->bind(10, tile.y);
+    update->bind(11, tile.z);
     update->run();
     if (update->changes() != 0) {
         transaction.commit();
         return false;
     }
 
+    // clang-format off
+    Statement insertTemplate = getStatement(
+        "INSERT OR IGNORE INTO url_templates (url_template) "
+        "VALUES                              (?1)");
+    // clang-format on
+
+    insertTemplate->bind(1, tile.urlTemplate);
+    insertTemplate->run();
+
     // clang-format off
     Statement insert = getStatement(
-        "INSERT INTO tiles (url_template, pixel_ratio, x,  y,  z,  modified, must_revalidate, etag, expires, accessed,  data, compressed) "
-        "VALUES            (?1,           ?2,          ?3, ?4, ?5, ?6,       ?7,              ?8,   ?9,      ?10,       ?11,  ?12)");
+        "INSERT INTO tiles (url_template_id,                                        pixel_ratio, x,  y,  z,  modified, must_revalidate, etag, expires, accessed,  data_id) "
+        "VALUES            ((SELECT id FROM url_templates WHERE url_template = ?1), ?2,          ?3, ?4, ?5, ?6,       ?7,              ?8,   ?9,      ?10,       ?11)");
     // clang-format on
 
     insert->bind(1, tile.urlTemplate);
@@ -543,12 +668,10 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     insert->bind(9, response.expires);
     insert->bind(10, util::now());
 
-    if (response.noContent) {
-        insert->bind(11, nullptr);
-        insert->bind(12, false);
+    if (dataID) {
+        insert->bind(11, *dataID);
     } else {
-        insert->bindBlob(11, data.data(), data.size(), false);
-        insert->bind(12, compressed);
+        insert->bind(11, nullptr);
     }
 
     insert->run();
@@ -557,6 +680,48 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     return true;
 }
 
+// Tile payloads are looked up by their length and CRC-32, and then compared byte by byte, so
+// that a hash collision only costs a comparison.
+static int64_t tileDataHash(const std::string& data) {
+    const uLong crc = crc32(0, reinterpret_cast<const Bytef*>(data.data()), uInt(data.size()));
+    return (int64_t(data.size()) << 32) | int64_t(crc);
+}
+
+int64_t OfflineDatabase::putTileData(const std::string& data, bool compressed) {
+    const int64_t hash = tileDataHash(data);
+
+    // clang-format off
+    Statement select = getStatement(
+        "SELECT id, data "
+        "FROM tile_data "
+        "WHERE hash       = ?1 "
+        "  AND compressed = ?2 ");
+    // clang-format on
+
+    select->bind(1, hash);
+    select->bind(2, compressed);
+    while (select->run()) {
+        if (select->get<std::string>(1) == data) {
+            return select->get<int64_t>(0);
+        }
+    }
+
+    // The row starts out unreferenced; the tiles triggers count the tile that refers to it.
+
+    // clang-format off
+    Statement insert = getStatement(
+        "INSERT INTO tile_data (hash, data, compressed) "
+        "VALUES                (?1,   ?2,   ?3)");
+    // clang-format on
+
+    insert->bind(1, hash);
+    insert->bindBlob(2, data.data(), data.size(), false);
+    insert->bind(3, compressed);
+    insert->run();
+
+    return insert->lastInsertRowId();
+}
+
 std::vector<OfflineRegion> OfflineDatabase::listRegions() {
     // clang-format off
     Statement stmt = getStatement(
@@ -660,11 +825,11 @@ bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
             "INSERT OR IGNORE INTO region_tiles (region_id, tile_id) "
             "SELECT                              ?1,        tiles.id "
             "FROM tiles "
-            "WHERE url_template = ?2 "
-            "  AND pixel_ratio  = ?3 "
-            "  AND x            = ?4 "
-            "  AND y            = ?5 "
-            "  AND z            = ?6 ");
+            "WHERE url_template_id = (SELECT id FROM url_templates WHERE url_template = ?2) "
+            "  AND pixel_ratio     = ?3 "
+            "  AND x               = ?4 "
+            "  AND y               = ?5 "
+            "  AND z               = ?6 ");
         // clang-format on
 
         const Resource::TileData& tile = *resource.tileData;
@@ -685,11 +850,11 @@ bool OfflineDatabase::markUsed(int64_t regionID, const Resource& resource) {
             "SELECT region_id "
             "FROM region_tiles, tiles "
             "WHERE region_id   != ?1 "
-            "  AND url_template = ?2 "
-            "  AND pixel_ratio  = ?3 "
-            "  AND x            = ?4 "
-            "  AND y            = ?5 "
-            "  AND z            = ?6 "
+            "  AND url_template_id = (SELECT id FROM url_templates WHERE url_template = ?2) "
+            "  AND pixel_ratio     = ?3 "
+            "  AND x               = ?4 "
+            "  AND y               = ?5 "
+            "  AND z               = ?6 "
             "LIMIT 1 ");
         // clang-format on
 
@@ -774,8 +939,9 @@ std::pair<int64_t, int64_t> OfflineDatabase::getCompletedResourceCountAndSize(in
 std::pair<int64_t, int64_t> OfflineDatabase::getCompletedTileCountAndSize(int64_t regionID) {
     // clang-format off
     Statement stmt = getStatement(
-        "SELECT COUNT(*), SUM(LENGTH(data)) "
+        "SELECT COUNT(*), SUM(LENGTH(tile_data.data)) "
         "FROM region_tiles, tiles "
+        "LEFT JOIN tile_data ON tile_data.id = tiles.data_id "
         "WHERE region_id = ?1 "
         "AND tile_id = tiles.id ");
     // clang-format on
@@ -867,6 +1033,19 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize) {
         stmt2->run();
         uint64_t changes2 = stmt2->changes();
 
+        if (changes2 != 0) {
+            // Remove the URL templates that were only used by the evicted tiles.
+            // clang-format off
+            Statement stmt3 = getStatement(
+                "DELETE FROM url_templates "
+                "WHERE NOT EXISTS ( "
+                "  SELECT 1 FROM tiles "
+                "  WHERE url_template_id = url_templates.id "
+                ") ");
+            // clang-format on
+            stmt3->run();
+        }
+
         // The cached value of offlineTileCount does not need to be updated
         // here because only non-offline tiles can be removed by eviction.
 
@@ -902,9 +1081,10 @@ uint64_t OfflineDatabase::getOfflineMapboxTileCount() {
 
     // clang-format off
     Statement stmt = getStatement(
-        "SELECT COUNT(DISTINCT id) "
-        "FROM region_tiles, tiles "
+        "SELECT COUNT(DISTINCT tiles.id) "
+        "FROM region_tiles, tiles, url_templates "
         "WHERE tile_id = tiles.id "
+        "AND url_template_id = url_templates.id "
         "AND url_template LIKE 'mapbox://%' ");
     // clang-format on
 
@@ -65,6 +65,7 @@ private:
     void migrateToVersion3();
     void migrateToVersion5();
     void migrateToVersion6();
+    void migrateToVersion7();
 
     class Statement {
     public:
@@ -81,11 +82,15 @@ private:
 
     Statement getStatement(const char *);
 
-    optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
+    optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&, bool acceptsCompressedData);
     optional<int64_t> hasTile(const Resource::TileData&);
     bool putTile(const Resource::TileData&, const Response&,
                  const std::string&, bool compressed);
 
+    // Returns the ID of the tile_data row holding `data`, inserting one if no other tile has
+    // the same content.
+    int64_t putTileData(const std::string& data, bool compressed);
+
     optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     optional<int64_t> hasResource(const Resource&);
     bool putResource(const Resource&, const Response&,
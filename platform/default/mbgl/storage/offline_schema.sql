@@ -12,9 +12,23 @@ CREATE TABLE resources (                   -- Generic table for style, source, s
   UNIQUE (url)
 );
 
-CREATE TABLE tiles (
+CREATE TABLE url_templates (               -- URL templates of tile sources, shared by all of their tiles.
   id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,
   url_template TEXT NOT NULL,
+  UNIQUE (url_template)
+);
+
+CREATE TABLE tile_data (                   -- Tile payloads, stored once for all tiles with identical content.
+  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,
+  hash INTEGER NOT NULL,                   -- Length of data in the high and its CRC-32 in the low 32 bits.
+  data BLOB NOT NULL,
+  compressed INTEGER NOT NULL DEFAULT 0,
+  refcount INTEGER NOT NULL DEFAULT 0      -- Number of tiles referring to this payload; maintained by triggers.
+);
+
+CREATE TABLE tiles (
+  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,
+  url_template_id INTEGER NOT NULL REFERENCES url_templates(id),
   pixel_ratio INTEGER NOT NULL,
   z INTEGER NOT NULL,
   x INTEGER NOT NULL,
@@ -22,11 +36,10 @@ CREATE TABLE tiles (
   expires INTEGER,
   modified INTEGER,
   etag TEXT,
-  data BLOB,
-  compressed INTEGER NOT NULL DEFAULT 0,
+  data_id INTEGER REFERENCES tile_data(id), -- NULL for tiles without content.
   accessed INTEGER NOT NULL,
   must_revalidate INTEGER NOT NULL DEFAULT 0,
-  UNIQUE (url_template, pixel_ratio, z, x, y)
+  UNIQUE (url_template_id, pixel_ratio, z, x, y)
 );
 
 CREATE TABLE regions (
@@ -62,3 +75,30 @@ ON region_resources (resource_id);
 
 CREATE INDEX region_tiles_tile_id
 ON region_tiles (tile_id);
+
+CREATE INDEX tile_data_hash
+ON tile_data (hash);
+
+-- Triggers that keep tile_data reference counts up to date, and delete payloads that are no
+-- longer referred to by any tile.
+
+CREATE TRIGGER tiles_insert_data AFTER INSERT ON tiles
+WHEN new.data_id IS NOT NULL
+BEGIN
+  UPDATE tile_data SET refcount = refcount + 1 WHERE id = new.data_id;
+END;
+
+CREATE TRIGGER tiles_update_data AFTER UPDATE OF data_id ON tiles
+WHEN new.data_id IS NOT old.data_id
+BEGIN
+  UPDATE tile_data SET refcount = refcount + 1 WHERE id = new.data_id;
+  UPDATE tile_data SET refcount = refcount - 1 WHERE id = old.data_id;
+  DELETE FROM tile_data WHERE id = old.data_id AND refcount = 0;
+END;
+
+CREATE TRIGGER tiles_delete_data AFTER DELETE ON tiles
+WHEN old.data_id IS NOT NULL
+BEGIN
+  UPDATE tile_data SET refcount = refcount - 1 WHERE id = old.data_id;
+  DELETE FROM tile_data WHERE id = old.data_id AND refcount = 0;
+END;
@@ -54,4 +54,8 @@ void ThreadPool::schedule(std::weak_ptr<Mailbox> mailbox) {
     cv.notify_one();
 }
 
+std::size_t ThreadPool::concurrency() const {
+    return threads.size();
+}
+
 } // namespace mbgl
@@ -0,0 +1,235 @@
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/storage/file_source_request.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/thread.hpp>
+#include <mbgl/util/url.hpp>
+
+#include "sqlite3.hpp"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <cassert>
+#include <cstdlib>
+#include <map>
+#include <unordered_map>
+
+namespace {
+
+const char* protocol = "mbtiles://";
+const std::size_t protocolLength = 10;
+
+// Tile URLs add a query to the URL of the archive.
+std::string archivePath(const std::string& url) {
+    const std::size_t query = url.find('?', protocolLength);
+    return mbgl::util::percentDecode(url.substr(protocolLength,
+        query == std::string::npos ? std::string::npos : query - protocolLength));
+}
+
+// Vector tiles in MBTiles archives are usually gzip-compressed, and sometimes zlib-compressed.
+bool isCompressed(const std::string& data) {
+    if (data.size() < 2) {
+        return false;
+    }
+    const auto first = uint8_t(data[0]);
+    const auto second = uint8_t(data[1]);
+    return (first == 0x1f && second == 0x8b) || (first == 0x78 && (first << 8 | second) % 31 == 0);
+}
+
+// Parses a comma-separated list of numbers, such as the bounds and center of a tileset.
+std::vector<double> parseNumbers(const std::string& value) {
+    std::vector<double> result;
+    const char* begin = value.c_str();
+    while (*begin) {
+        char* end = nullptr;
+        const double number = std::strtod(begin, &end);
+        if (end == begin) {
+            return {};
+        }
+        result.push_back(number);
+        begin = *end == ',' ? end + 1 : end;
+    }
+    return result;
+}
+
+} // namespace
+
+namespace mbgl {
+
+class MBTilesFileSource::Impl {
+public:
+    Impl(ActorRef<Impl>) {}
+
+    void request(const Resource& resource, ActorRef<FileSourceRequest> req) {
+        Response response;
+
+        try {
+            Archive& archive = getArchive(archivePath(resource.url));
+            if (resource.kind == Resource::Kind::Tile) {
+                getTile(archive, resource, response);
+            } else {
+                getTileJSON(archive, resource.url, response);
+            }
+        } catch (const mapbox::sqlite::Exception& ex) {
+            response.error = std::make_unique<Response::Error>(
+                ex.code == mapbox::sqlite::Exception::Code::CANTOPEN ? Response::Error::Reason::NotFound
+                                                                     : Response::Error::Reason::Other,
+                ex.what());
+        } catch (...) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                util::toString(std::current_exception()));
+        }
+
+        req.invoke(&FileSourceRequest::setResponse, response);
+    }
+
+private:
+    struct Archive {
+        Archive(const std::string& path)
+            : db(path, mapbox::sqlite::ReadOnly),
+              tileStatement(db.prepare(
+                  "SELECT tile_data FROM tiles "
+                  "WHERE zoom_level = ?1 AND tile_column = ?2 AND tile_row = ?3")) {
+        }
+
+        mapbox::sqlite::Database db;
+        mapbox::sqlite::Statement tileStatement;
+    };
+
+    Archive& getArchive(const std::string& path) {
+        auto it = archives.find(path);
+        if (it == archives.end()) {
+            it = archives.emplace(path, std::make_unique<Archive>(path)).first;
+        }
+        return *it->second;
+    }
+
+    void getTile(Archive& archive, const Resource& resource, Response& response) {
+        assert(resource.tileData);
+        if (!resource.tileData) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other, "Tile request without tile coordinates");
+            return;
+        }
+
+        // The TileJSON declares the TMS scheme, which is what the tile_row column uses.
+        mapbox::sqlite::Statement& stmt = archive.tileStatement;
+        stmt.reset();
+        stmt.bind(1, resource.tileData->z);
+        stmt.bind(2, resource.tileData->x);
+        stmt.bind(3, resource.tileData->y);
+
+        if (!stmt.run()) {
+            response.noContent = true;
+            return;
+        }
+
+        auto data = std::make_shared<std::string>(stmt.get<std::string>(0));
+        if (isCompressed(*data)) {
+            if (resource.acceptsCompressedData) {
+                response.compressed = true;
+            } else {
+                *data = util::decompress(*data);
+            }
+        }
+        response.data = std::move(data);
+    }
+
+    void getTileJSON(Archive& archive, const std::string& url, Response& response) {
+        std::map<std::string, std::string> metadata;
+        mapbox::sqlite::Statement stmt = archive.db.prepare("SELECT name, value FROM metadata");
+        while (stmt.run()) {
+            metadata.emplace(stmt.get<std::string>(0), stmt.get<std::string>(1));
+        }
+
+        JSDocument doc;
+        doc.SetObject();
+        auto& allocator = doc.GetAllocator();
+
+        doc.AddMember("tilejson", "2.2.0", allocator);
+        for (const auto& key : { "name", "description", "attribution", "version" }) {
+            auto it = metadata.find(key);
+            if (it != metadata.end()) {
+                doc.AddMember(rapidjson::StringRef(key), JSValue(it->second.c_str(), allocator), allocator);
+            }
+        }
+
+        doc.AddMember("scheme", "tms", allocator);
+
+        JSValue tiles(rapidjson::kArrayType);
+        tiles.PushBack(JSValue((url + "?z={z}&x={x}&y={y}").c_str(), allocator), allocator);
+        doc.AddMember("tiles", tiles, allocator);
+
+        for (const auto& key : { "minzoom", "maxzoom" }) {
+            auto it = metadata.find(key);
+            if (it != metadata.end()) {
+                const std::vector<double> zoom = parseNumbers(it->second);
+                if (zoom.size() == 1) {
+                    doc.AddMember(rapidjson::StringRef(key), zoom[0], allocator);
+                }
+            }
+        }
+
+        for (const auto& field : { std::make_pair("bounds", 4u), std::make_pair("center", 3u) }) {
+            auto it = metadata.find(field.first);
+            if (it != metadata.end()) {
+                const std::vector<double> numbers = parseNumbers(it->second);
+                if (numbers.size() == field.second) {
+                    JSValue array(rapidjson::kArrayType);
+                    for (double number : numbers) {
+                        array.PushBack(number, allocator);
+                    }
+                    doc.AddMember(rapidjson::StringRef(field.first), array, allocator);
+                }
+            }
+        }
+
+        // Vector tilesets describe their layers in a JSON document of their own.
+        auto json = metadata.find("json");
+        if (json != metadata.end()) {
+            JSDocument layers;
+            layers.Parse<0>(json->second.c_str());
+            if (!layers.HasParseError() && layers.IsObject() && layers.HasMember("vector_layers")) {
+                doc.AddMember("vector_layers", JSValue(layers["vector_layers"], allocator), allocator);
+            }
+        }
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        doc.Accept(writer);
+
+        response.data = std::make_shared<std::string>(buffer.GetString(), buffer.GetSize());
+    }
+
+    std::unordered_map<std::string, std::unique_ptr<Archive>> archives;
+};
+
+MBTilesFileSource::MBTilesFileSource(std::size_t readerCount) {
+    assert(readerCount > 0);
+    for (std::size_t i = 0; i < readerCount; i++) {
+        readers.push_back(std::make_unique<util::Thread<Impl>>("MBTilesFileSource"));
+    }
+}
+
+MBTilesFileSource::~MBTilesFileSource() = default;
+
+std::unique_ptr<AsyncRequest> MBTilesFileSource::request(const Resource& resource, Callback callback) {
+    auto req = std::make_unique<FileSourceRequest>(std::move(callback));
+
+    // Readers take turns, so that a slow request doesn't hold up the others.
+    auto& reader = readers[nextReader++ % readers.size()];
+    reader->actor().invoke(&Impl::request, resource, req->actor());
+
+    return std::move(req);
+}
+
+bool MBTilesFileSource::acceptsURL(const std::string& url) {
+    return url.compare(0, protocolLength, protocol) == 0;
+}
+
+} // namespace mbgl
@@ -325,6 +325,7 @@ void OnlineFileRequest::completed(Response response) {
         // that the requestor hasn't gotten data yet. If we get a 304 response, this means that we
         // have send the cached data to give the requestor a chance to actually obtain the data.
         response.data = std::move(resource.priorData);
+        response.compressed = resource.priorDataCompressed;
         response.notModified = false;
     }
 
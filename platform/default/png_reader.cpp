@@ -1,10 +1,8 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/premultiply.hpp>
-#include <mbgl/util/char_array_buffer.hpp>
 #include <mbgl/util/logging.hpp>
 
-#include <istream>
-#include <sstream>
+#include <cstring>
 
 extern "C"
 {
@@ -39,14 +37,20 @@ static void user_warning_fn(png_structp, png_const_charp warning_msg) {
     Log::Warning(Event::Image, "ImageReader (PNG): %s", warning_msg);
 }
 
+// The encoded image, read by libpng straight from memory.
+struct png_memory_source {
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+};
+
 static void png_read_data(png_structp png_ptr, png_bytep data, png_size_t length) {
-    auto* fin = reinterpret_cast<std::istream*>(png_get_io_ptr(png_ptr));
-    fin->read(reinterpret_cast<char*>(data), length);
-    std::streamsize read_count = fin->gcount();
-    if (read_count < 0 || static_cast<png_size_t>(read_count) != length)
-    {
+    auto* source = reinterpret_cast<png_memory_source*>(png_get_io_ptr(png_ptr));
+    if (length > source->size - source->offset) {
         png_error(png_ptr, "Read Error");
     }
+    std::memcpy(data, source->data + source->offset, length);
+    source->offset += length;
 }
 
 struct png_struct_guard {
@@ -63,15 +67,10 @@ struct png_struct_guard {
 };
 
 PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
-    util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
-    std::istream stream(&dataBuffer);
-
-    png_byte header[8] = { 0 };
-    stream.read(reinterpret_cast<char*>(header), 8);
-    if (stream.gcount() != 8)
+    if (size < 8)
         throw std::runtime_error("PNG reader: Could not read image");
 
-    int is_png = !png_sig_cmp(header, 0, 8);
+    int is_png = !png_sig_cmp(data, 0, 8);
     if (!is_png)
         throw std::runtime_error("File or stream is not a png");
 
@@ -88,7 +87,8 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
     if (!info_ptr)
         throw std::runtime_error("failed to create info_ptr");
 
-    png_set_read_fn(png_ptr, &stream, png_read_data);
+    png_memory_source source { data, size, 8 };
+    png_set_read_fn(png_ptr, &source, png_read_data);
     png_set_sig_bytes(png_ptr, 8);
     png_read_info(png_ptr, info_ptr);
 
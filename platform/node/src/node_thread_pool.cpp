@@ -3,6 +3,8 @@
 
 #include <mbgl/actor/mailbox.hpp>
 
+#include <cstdlib>
+
 namespace node_mbgl {
 
 NodeThreadPool::NodeThreadPool()
@@ -22,6 +24,13 @@ void NodeThreadPool::schedule(std::weak_ptr<mbgl::Mailbox> mailbox) {
     queue->send(std::move(mailbox));
 }
 
+std::size_t NodeThreadPool::concurrency() const {
+    // Workers run on libuv's thread pool, which has four threads unless configured otherwise.
+    const char* size = std::getenv("UV_THREADPOOL_SIZE");
+    const long count = size ? std::strtol(size, nullptr, 10) : 0;
+    return count > 0 ? std::size_t(count) : 4;
+}
+
 NodeThreadPool::Worker::Worker(std::weak_ptr<mbgl::Mailbox> mailbox_)
     : AsyncWorker(nullptr),
     mailbox(std::move(mailbox_)) {};
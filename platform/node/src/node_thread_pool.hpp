@@ -18,6 +18,7 @@ public:
     ~NodeThreadPool();
 
     void schedule(std::weak_ptr<mbgl::Mailbox>) override;
+    std::size_t concurrency() const override;
 
 private:
     util::AsyncQueue<std::weak_ptr<mbgl::Mailbox>>* queue;
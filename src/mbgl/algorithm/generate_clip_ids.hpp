@@ -3,6 +3,7 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/clip_id.hpp>
 
+#include <functional>
 #include <set>
 #include <vector>
 #include <map>
@@ -31,5 +32,42 @@ public:
     std::map<UnwrappedTileID, ClipID> getClipIDs() const;
 };
 
+// Returns the renderables that overlap or touch a renderable of another zoom level. Renderables
+// of the same zoom level overlap only in their buffers, where they hold the same geometry.
+template <typename Renderable>
+std::vector<std::reference_wrapper<Renderable>>
+overlappingOtherZoomLevels(const std::vector<std::reference_wrapper<Renderable>>&);
+
+// Remembers the clip IDs generated for a frame, so that subsequent frames clipping the exact same
+// groups of renderables can reuse them instead of running the ClipIDGenerator again.
+class ClipIDCache {
+public:
+    template <typename Renderable>
+    using Groups = std::vector<std::vector<std::reference_wrapper<Renderable>>>;
+
+    // Assigns the cached clip IDs and returns true if the renderables match the stored ones.
+    template <typename Renderable>
+    bool restore(const Groups<Renderable>&);
+
+    template <typename Renderable>
+    void store(const Groups<Renderable>&, std::map<UnwrappedTileID, ClipID>);
+
+    const std::map<UnwrappedTileID, ClipID>& getClipIDs() const {
+        return clipIDs;
+    }
+
+private:
+    struct Entry {
+        UnwrappedTileID id;
+        bool used;
+        ClipID clip;
+    };
+
+    bool valid = false;
+    std::vector<std::size_t> groupSizes;
+    std::vector<Entry> entries;
+    std::map<UnwrappedTileID, ClipID> clipIDs;
+};
+
 } // namespace algorithm
 } // namespace mbgl
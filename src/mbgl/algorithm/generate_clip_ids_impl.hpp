@@ -4,6 +4,10 @@
 #include <mbgl/math/log2.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
 namespace mbgl {
 namespace algorithm {
 
@@ -88,5 +92,83 @@ void ClipIDGenerator::update(std::vector<std::reference_wrapper<Renderable>> ren
     }
 }
 
+// Whether the tiles overlap or share an edge or a corner.
+inline bool touches(const UnwrappedTileID& a, const UnwrappedTileID& b) {
+    const uint8_t z = std::max(a.canonical.z, b.canonical.z);
+    auto range = [&] (const UnwrappedTileID& id, uint32_t coordinate, int64_t wrap) {
+        const int64_t scale = int64_t(1) << (z - id.canonical.z);
+        const int64_t min = (wrap * (int64_t(1) << id.canonical.z) + coordinate) * scale;
+        return std::make_pair(min, min + scale);
+    };
+    const auto ax = range(a, a.canonical.x, a.wrap);
+    const auto bx = range(b, b.canonical.x, b.wrap);
+    const auto ay = range(a, a.canonical.y, 0);
+    const auto by = range(b, b.canonical.y, 0);
+    return ax.first <= bx.second && bx.first <= ax.second &&
+           ay.first <= by.second && by.first <= ay.second;
+}
+
+template <typename Renderable>
+std::vector<std::reference_wrapper<Renderable>>
+overlappingOtherZoomLevels(const std::vector<std::reference_wrapper<Renderable>>& renderables) {
+    std::vector<std::reference_wrapper<Renderable>> result;
+    for (const auto& a : renderables) {
+        if (!a.get().used) {
+            continue;
+        }
+        for (const auto& b : renderables) {
+            if (b.get().used && b.get().id.canonical.z != a.get().id.canonical.z &&
+                touches(a.get().id, b.get().id)) {
+                result.push_back(a);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+template <typename Renderable>
+bool ClipIDCache::restore(const Groups<Renderable>& groups) {
+    if (!valid || groups.size() != groupSizes.size()) {
+        return false;
+    }
+
+    auto entry = entries.begin();
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        if (groups[i].size() != groupSizes[i]) {
+            return false;
+        }
+        for (const auto& renderable : groups[i]) {
+            if (renderable.get().id != entry->id || renderable.get().used != entry->used) {
+                return false;
+            }
+            ++entry;
+        }
+    }
+
+    entry = entries.begin();
+    for (const auto& group : groups) {
+        for (const auto& renderable : group) {
+            renderable.get().clip = (entry++)->clip;
+        }
+    }
+
+    return true;
+}
+
+template <typename Renderable>
+void ClipIDCache::store(const Groups<Renderable>& groups, std::map<UnwrappedTileID, ClipID> clipIDs_) {
+    groupSizes.clear();
+    entries.clear();
+    for (const auto& group : groups) {
+        groupSizes.push_back(group.size());
+        for (const auto& renderable : group) {
+            entries.push_back({ renderable.get().id, renderable.get().used, renderable.get().clip });
+        }
+    }
+    clipIDs = std::move(clipIDs_);
+    valid = true;
+}
+
 } // namespace algorithm
 } // namespace mbgl
@@ -3,9 +3,6 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 
-#include <mbgl/algorithm/generate_clip_ids.hpp>
-#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
-
 namespace mbgl {
 
 using namespace style;
@@ -27,6 +24,7 @@ void RenderAnnotationSource::update(Immutable<style::Source::Impl> baseImpl_,
                                     const std::vector<Immutable<Layer::Impl>>& layers,
                                     const bool needsRendering,
                                     const bool needsRelayout,
+                                    const ImageDependencies& changedImages,
                                     const TileParameters& parameters) {
     std::swap(baseImpl, baseImpl_);
 
@@ -35,6 +33,7 @@ void RenderAnnotationSource::update(Immutable<style::Source::Impl> baseImpl_,
     tilePyramid.update(layers,
                        needsRendering,
                        needsRelayout,
+                       changedImages,
                        parameters,
                        SourceType::Annotations,
                        util::tileSize,
@@ -45,7 +44,6 @@ void RenderAnnotationSource::update(Immutable<style::Source::Impl> baseImpl_,
 }
 
 void RenderAnnotationSource::startRender(PaintParameters& parameters) {
-    parameters.clipIDGenerator.update(tilePyramid.getRenderTiles());
     tilePyramid.startRender(parameters);
 }
 
@@ -65,8 +63,14 @@ RenderAnnotationSource::queryRenderedFeatures(const ScreenLineString& geometry,
     return tilePyramid.queryRenderedFeatures(geometry, transformState, style, options);
 }
 
-std::vector<Feature> RenderAnnotationSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderAnnotationSource::snapshotRenderedFeatures(RenderedFeatureQuery& query,
+                                                      const ScreenLineString& geometry,
+                                                      const TransformState& transformState,
+                                                      const RenderStyle& style) const {
+    tilePyramid.snapshotRenderedFeatures(query, geometry, transformState, style);
+}
+
+void RenderAnnotationSource::snapshotSourceFeatures(SourceFeatureQuery&) const {
 }
 
 void RenderAnnotationSource::onLowMemory() {
@@ -77,4 +81,8 @@ void RenderAnnotationSource::dumpDebugLogs() const {
     tilePyramid.dumpDebugLogs();
 }
 
+void RenderAnnotationSource::reportMemory(MemoryReport& report) const {
+    tilePyramid.reportMemory(report, baseImpl->id);
+}
+
 } // namespace mbgl
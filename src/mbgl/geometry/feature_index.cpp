@@ -53,10 +53,10 @@ static bool topDownSymbols(const IndexedSubfeature& a, const IndexedSubfeature&
     return a.sortIndex < b.sortIndex;
 }
 
-static int16_t getAdditionalQueryRadius(const RenderedQueryOptions& queryOptions,
-                                        const RenderStyle& style,
-                                        const GeometryTile& tile,
-                                        const float pixelsToTileUnits) {
+int16_t FeatureIndex::getAdditionalQueryRadius(const RenderedQueryOptions& queryOptions,
+                                               const RenderStyle& style,
+                                               const GeometryTile& tile,
+                                               const float pixelsToTileUnits) {
 
     // Determine the additional radius needed factoring in property functions
     float additionalRadius = 0;
@@ -96,15 +96,50 @@ void FeatureIndex::query(
         const CollisionTile* collisionTile,
         const GeometryTile& tile) const {
 
-    // Determine query radius
     const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
-    const int16_t additionalRadius = getAdditionalQueryRadius(queryOptions, style, tile, pixelsToTileUnits);
+    std::unordered_map<std::string, std::vector<FeatureHandle>> handles;
+    query(handles,
+          queryGeometry,
+          bearing,
+          tileSize,
+          scale,
+          queryOptions,
+          geometryTileData,
+          tileID,
+          [&] (const std::string& layerID) { return style.getRenderLayer(layerID); },
+          collisionTile,
+          getAdditionalQueryRadius(queryOptions, style, tile, pixelsToTileUnits));
+
+    for (const auto& layer : handles) {
+        auto& features = result[layer.first];
+        for (const auto& handle : layer.second) {
+            features.push_back(handle.toFeature(queryOptions.properties, queryOptions.includeGeometry));
+        }
+    }
+}
+
+void FeatureIndex::query(
+        std::unordered_map<std::string, std::vector<FeatureHandle>>& result,
+        const GeometryCoordinates& queryGeometry,
+        const float bearing,
+        const double tileSize,
+        const double scale,
+        const RenderedQueryOptions& queryOptions,
+        const GeometryTileData& geometryTileData,
+        const CanonicalTileID& tileID,
+        const RenderLayerLookup& getRenderLayer,
+        const CollisionTile* collisionTile,
+        const int16_t additionalRadius) const {
+
+    const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
 
     // Query the grid index
     mapbox::geometry::box<int16_t> box = mapbox::geometry::envelope(queryGeometry);
     std::vector<IndexedSubfeature> features = grid.query({ box.min - additionalRadius, box.max + additionalRadius });
 
 
+    SourceLayers sourceLayers;
+
     std::sort(features.begin(), features.end(), topDown);
     size_t previousSortIndex = std::numeric_limits<size_t>::max();
     for (const auto& indexedFeature : features) {
@@ -113,7 +148,7 @@ void FeatureIndex::query(
         if (indexedFeature.sortIndex == previousSortIndex) continue;
         previousSortIndex = indexedFeature.sortIndex;
 
-        addFeature(result, indexedFeature, queryGeometry, queryOptions, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, sourceLayers, indexedFeature, queryGeometry, queryOptions, geometryTileData, tileID, getRenderLayer, bearing, pixelsToTileUnits);
     }
 
     // Query symbol features, if they've been placed.
@@ -124,18 +159,19 @@ void FeatureIndex::query(
     std::vector<IndexedSubfeature> symbolFeatures = collisionTile->queryRenderedSymbols(queryGeometry, scale);
     std::sort(symbolFeatures.begin(), symbolFeatures.end(), topDownSymbols);
     for (const auto& symbolFeature : symbolFeatures) {
-        addFeature(result, symbolFeature, queryGeometry, queryOptions, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, sourceLayers, symbolFeature, queryGeometry, queryOptions, geometryTileData, tileID, getRenderLayer, bearing, pixelsToTileUnits);
     }
 }
 
 void FeatureIndex::addFeature(
-    std::unordered_map<std::string, std::vector<Feature>>& result,
+    std::unordered_map<std::string, std::vector<FeatureHandle>>& result,
+    SourceLayers& sourceLayers,
     const IndexedSubfeature& indexedFeature,
     const GeometryCoordinates& queryGeometry,
     const RenderedQueryOptions& options,
     const GeometryTileData& geometryTileData,
     const CanonicalTileID& tileID,
-    const RenderStyle& style,
+    const RenderLayerLookup& getRenderLayer,
     const float bearing,
     const float pixelsToTileUnits) const {
 
@@ -144,29 +180,40 @@ void FeatureIndex::addFeature(
         return;
     }
 
-    auto sourceLayer = geometryTileData.getLayer(indexedFeature.sourceLayerName);
+    // Parse each source layer once per query, rather than once per feature.
+    auto& sourceLayer = sourceLayers[indexedFeature.sourceLayerName];
+    if (!sourceLayer) {
+        sourceLayer = geometryTileData.getLayer(indexedFeature.sourceLayerName);
+    }
     assert(sourceLayer);
 
-    auto geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
+    std::unique_ptr<const GeometryTileFeature> geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
     assert(geometryTileFeature);
+    const GeometryTileFeature& feature = *geometryTileFeature;
+
+    // Layers matching the same feature share a handle, which takes over the decoded feature.
+    optional<FeatureHandle> handle;
 
     for (const auto& layerID : layerIDs) {
         if (options.layerIDs && !vectorContains(*options.layerIDs, layerID)) {
             continue;
         }
 
-        auto renderLayer = style.getRenderLayer(layerID);
+        auto renderLayer = getRenderLayer(layerID);
         if (!renderLayer ||
             (!renderLayer->is<RenderSymbolLayer>() &&
-             !renderLayer->queryIntersectsFeature(queryGeometry, *geometryTileFeature, tileID.z, bearing, pixelsToTileUnits))) {
+             !renderLayer->queryIntersectsFeature(queryGeometry, feature, tileID.z, bearing, pixelsToTileUnits))) {
             continue;
         }
 
-        if (options.filter && !(*options.filter)(*geometryTileFeature)) {
+        if (options.filter && !(*options.filter)(feature)) {
             continue;
         }
 
-        result[layerID].push_back(convertFeature(*geometryTileFeature, tileID));
+        if (!handle) {
+            handle.emplace(sourceLayer, std::move(geometryTileFeature), tileID);
+        }
+        result[layerID].push_back(*handle);
     }
 }
 
@@ -196,4 +243,12 @@ void FeatureIndex::setBucketLayerIDs(const std::string& bucketName, const std::v
     bucketLayerIDs[bucketName] = layerIDs;
 }
 
+std::size_t FeatureIndex::byteSize() const {
+    std::size_t result = grid.byteSize();
+    for (const auto& pair : bucketLayerIDs) {
+        result += pair.first.capacity() + pair.second.capacity() * sizeof(std::string);
+    }
+    return result;
+}
+
 } // namespace mbgl
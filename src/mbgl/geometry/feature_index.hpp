@@ -1,10 +1,12 @@
 #pragma once
 
+#include <mbgl/renderer/feature_handle.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/util/grid_index.hpp>
 #include <mbgl/util/feature.hpp>
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -13,6 +15,7 @@ namespace mbgl {
 
 class GeometryTile;
 class RenderedQueryOptions;
+class RenderLayer;
 class RenderStyle;
 
 class CollisionTile;
@@ -46,6 +49,33 @@ public:
             const CollisionTile*,
             const GeometryTile& tile) const;
 
+    // Returns the render layer features are tested against, or null if the layer isn't queried.
+    using RenderLayerLookup = std::function<const RenderLayer* (const std::string& layerID)>;
+
+    // Queries the index without touching the tile or the style, so that queries can run on
+    // any thread. `additionalRadius` is the result of getAdditionalQueryRadius(). The
+    // results refer to the tile data, and leave converting the features to the caller.
+    void query(
+            std::unordered_map<std::string, std::vector<FeatureHandle>>& result,
+            const GeometryCoordinates& queryGeometry,
+            const float bearing,
+            const double tileSize,
+            const double scale,
+            const RenderedQueryOptions& options,
+            const GeometryTileData&,
+            const CanonicalTileID&,
+            const RenderLayerLookup&,
+            const CollisionTile*,
+            const int16_t additionalRadius) const;
+
+    // The distance, in tile units, by which the queried layers' buckets extend features
+    // beyond their indexed geometry.
+    static int16_t getAdditionalQueryRadius(
+            const RenderedQueryOptions& options,
+            const RenderStyle&,
+            const GeometryTile&,
+            const float pixelsToTileUnits);
+
     static optional<GeometryCoordinates> translateQueryGeometry(
             const GeometryCoordinates& queryGeometry,
             const std::array<float, 2>& translate,
@@ -55,15 +85,22 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
 
+    // Approximate bytes held by the index.
+    std::size_t byteSize() const;
+
 private:
+    // The source layers of the tile data, shared by the handles of their features.
+    using SourceLayers = std::unordered_map<std::string, std::shared_ptr<const GeometryTileLayer>>;
+
     void addFeature(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            std::unordered_map<std::string, std::vector<FeatureHandle>>& result,
+            SourceLayers&,
             const IndexedSubfeature&,
             const GeometryCoordinates& queryGeometry,
             const RenderedQueryOptions& options,
             const GeometryTileData&,
             const CanonicalTileID&,
-            const RenderStyle&,
+            const RenderLayerLookup&,
             const float bearing,
             const float pixelsToTileUnits) const;
 
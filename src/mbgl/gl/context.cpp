@@ -3,6 +3,7 @@
 #include <mbgl/gl/debugging_extension.hpp>
 #include <mbgl/gl/vertex_array_extension.hpp>
 #include <mbgl/gl/program_binary_extension.hpp>
+#include <mbgl/gl/timer_query_extension.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
@@ -110,6 +111,7 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
         if (!disableVAOExtension) {
             vertexArray = std::make_unique<extension::VertexArray>(fn);
         }
+        timerQuery = std::make_unique<extension::TimerQuery>(fn);
 #if MBGL_HAS_BINARY_PROGRAMS
         programBinary = std::make_unique<extension::ProgramBinary>(fn);
 #endif
@@ -213,6 +215,8 @@ void Context::verifyProgramLinkage(ProgramID program_) {
 UniqueBuffer Context::createVertexBuffer(const void* data, std::size_t size, const BufferUsage usage) {
     BufferID id = 0;
     MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+    bufferSizes[id] = size;
+    bufferBytes += size;
     UniqueBuffer result { std::move(id), { this } };
     vertexBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, size, data, static_cast<GLenum>(usage)));
@@ -227,6 +231,8 @@ void Context::updateVertexBuffer(UniqueBuffer& buffer, const void* data, std::si
 UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size) {
     BufferID id = 0;
     MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+    bufferSizes[id] = size;
+    bufferBytes += size;
     UniqueBuffer result { std::move(id), { this } };
     bindVertexArray = 0;
     globalVertexArrayState.indexBuffer = result;
@@ -245,6 +251,10 @@ UniqueTexture Context::createTexture() {
     return UniqueTexture{ std::move(id), { this } };
 }
 
+extension::TimerQuery* Context::getTimerQueryExtension() const {
+    return timerQuery && timerQuery->isSupported() ? timerQuery.get() : nullptr;
+}
+
 bool Context::supportsVertexArrays() const {
     return vertexArray &&
            vertexArray->genVertexArrays &&
@@ -483,6 +493,12 @@ void Context::updateTexture(
     TextureID id, const Size size, const void* data, TextureFormat format, TextureUnit unit) {
     activeTexture = unit;
     texture[unit] = id;
+
+    std::size_t& bytes = textureSizes[id];
+    textureBytes -= bytes;
+    bytes = std::size_t(size.area()) * (format == TextureFormat::Alpha ? 1 : 4);
+    textureBytes += bytes;
+
     MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLenum>(format), size.width,
                                   size.height, 0, static_cast<GLenum>(format), GL_UNSIGNED_BYTE,
                                   data));
@@ -674,6 +690,7 @@ void Context::setColorMode(const ColorMode& color) {
 void Context::draw(PrimitiveType primitiveType,
                    std::size_t indexOffset,
                    std::size_t indexLength) {
+    drawCalls++;
     MBGL_CHECK_ERROR(glDrawElements(
         static_cast<GLenum>(primitiveType),
         static_cast<GLsizei>(indexLength),
@@ -702,6 +719,11 @@ void Context::performCleanup() {
             } else if (globalVertexArrayState.indexBuffer == id) {
                 globalVertexArrayState.indexBuffer.setDirty();
             }
+            auto it = bufferSizes.find(id);
+            if (it != bufferSizes.end()) {
+                bufferBytes -= it->second;
+                bufferSizes.erase(it);
+            }
         }
         MBGL_CHECK_ERROR(glDeleteBuffers(int(abandonedBuffers.size()), abandonedBuffers.data()));
         abandonedBuffers.clear();
@@ -712,6 +734,11 @@ void Context::performCleanup() {
             if (activeTexture == id) {
                 activeTexture.setDirty();
             }
+            auto it = textureSizes.find(id);
+            if (it != textureSizes.end()) {
+                textureBytes -= it->second;
+                textureSizes.erase(it);
+            }
         }
         MBGL_CHECK_ERROR(glDeleteTextures(int(abandonedTextures.size()), abandonedTextures.data()));
         abandonedTextures.clear();
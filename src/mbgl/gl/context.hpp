@@ -23,6 +23,7 @@
 #include <vector>
 #include <array>
 #include <string>
+#include <unordered_map>
 
 namespace mbgl {
 namespace gl {
@@ -34,6 +35,7 @@ namespace extension {
 class VertexArray;
 class Debugging;
 class ProgramBinary;
+class TimerQuery;
 } // namespace extension
 
 class Context : private util::noncopyable {
@@ -166,6 +168,14 @@ public:
     // Only call this while the OpenGL context is exclusive to this thread.
     void performCleanup();
 
+    // Bytes of buffer and texture storage currently allocated through this context, as
+    // requested from OpenGL. Pooled textures keep their storage until they are deleted.
+    std::size_t getBufferBytes() const { return bufferBytes; }
+    std::size_t getTextureBytes() const { return textureBytes; }
+
+    // Draw calls issued through this context since it was created.
+    const std::size_t& getDrawCalls() const { return drawCalls; }
+
     // Drain pools and remove abandoned objects, in preparation for destroying the store.
     // Only call this while the OpenGL context is exclusive to this thread.
     void reset();
@@ -190,9 +200,13 @@ public:
         return vertexArray.get();
     }
 
+    // Returns nothing if the implementation doesn't support timer queries.
+    extension::TimerQuery* getTimerQueryExtension() const;
+
 private:
     std::unique_ptr<extension::Debugging> debugging;
     std::unique_ptr<extension::VertexArray> vertexArray;
+    std::unique_ptr<extension::TimerQuery> timerQuery;
 #if MBGL_HAS_BINARY_PROGRAMS
     std::unique_ptr<extension::ProgramBinary> programBinary;
 #endif
@@ -274,6 +288,12 @@ private:
     std::vector<FramebufferID> abandonedFramebuffers;
     std::vector<RenderbufferID> abandonedRenderbuffers;
 
+    std::unordered_map<BufferID, std::size_t> bufferSizes;
+    std::unordered_map<TextureID, std::size_t> textureSizes;
+    std::size_t bufferBytes = 0;
+    std::size_t textureBytes = 0;
+    std::size_t drawCalls = 0;
+
 public:
     // For testing
     bool disableVAOExtension = false;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/gl.hpp>
+
+#include <cstdint>
+
+#define GL_QUERY_RESULT                   0x8866
+#define GL_QUERY_RESULT_AVAILABLE         0x8867
+#define GL_TIME_ELAPSED                   0x88BF
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+class TimerQuery {
+public:
+    template <typename Fn>
+    TimerQuery(const Fn& loadExtension)
+        : genQueries(
+              loadExtension({ { "GL_ARB_timer_query", "glGenQueries" },
+                              { "GL_EXT_timer_query", "glGenQueries" },
+                              { "GL_EXT_disjoint_timer_query", "glGenQueriesEXT" } })),
+          deleteQueries(
+              loadExtension({ { "GL_ARB_timer_query", "glDeleteQueries" },
+                              { "GL_EXT_timer_query", "glDeleteQueries" },
+                              { "GL_EXT_disjoint_timer_query", "glDeleteQueriesEXT" } })),
+          beginQuery(
+              loadExtension({ { "GL_ARB_timer_query", "glBeginQuery" },
+                              { "GL_EXT_timer_query", "glBeginQuery" },
+                              { "GL_EXT_disjoint_timer_query", "glBeginQueryEXT" } })),
+          endQuery(
+              loadExtension({ { "GL_ARB_timer_query", "glEndQuery" },
+                              { "GL_EXT_timer_query", "glEndQuery" },
+                              { "GL_EXT_disjoint_timer_query", "glEndQueryEXT" } })),
+          getQueryObjectuiv(
+              loadExtension({ { "GL_ARB_timer_query", "glGetQueryObjectuiv" },
+                              { "GL_EXT_timer_query", "glGetQueryObjectuiv" },
+                              { "GL_EXT_disjoint_timer_query", "glGetQueryObjectuivEXT" } })),
+          getQueryObjectui64v(
+              loadExtension({ { "GL_ARB_timer_query", "glGetQueryObjectui64v" },
+                              { "GL_EXT_timer_query", "glGetQueryObjectui64vEXT" },
+                              { "GL_EXT_disjoint_timer_query", "glGetQueryObjectui64vEXT" } })) {
+    }
+
+    bool isSupported() const {
+        return genQueries && deleteQueries && beginQuery && endQuery && getQueryObjectuiv && getQueryObjectui64v;
+    }
+
+    const ExtensionFunction<void(GLsizei n, GLuint* ids)> genQueries;
+
+    const ExtensionFunction<void(GLsizei n, const GLuint* ids)> deleteQueries;
+
+    const ExtensionFunction<void(GLenum target, GLuint id)> beginQuery;
+
+    const ExtensionFunction<void(GLenum target)> endQuery;
+
+    const ExtensionFunction<void(GLuint id, GLenum pname, GLuint* params)> getQueryObjectuiv;
+
+    // GLuint64 isn't declared by OpenGL ES 2 headers.
+    const ExtensionFunction<void(GLuint id, GLenum pname, uint64_t* params)> getQueryObjectui64v;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
@@ -19,18 +19,61 @@
 #include <mbgl/actor/scheduler.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/math/log2.hpp>
+#include <deque>
 #include <utility>
 
 namespace mbgl {
 
 using namespace style;
 
+// The map state a still image is rendered from. Style collections are immutable and replaced on
+// every change, so comparing them by identity is enough to tell whether the style changed.
+struct StillImageState {
+    CameraOptions camera;
+    Size size;
+    TransformState transformState;
+    MapDebugOptions debugOptions;
+    Immutable<Light::Impl> light;
+    Immutable<std::vector<Immutable<Image::Impl>>> images;
+    Immutable<std::vector<Immutable<Source::Impl>>> sources;
+    Immutable<std::vector<Immutable<Layer::Impl>>> layers;
+};
+
+bool operator==(const StillImageState& a, const StillImageState& b) {
+    return a.camera == b.camera
+        && a.size == b.size
+        && a.debugOptions == b.debugOptions
+        && a.light == b.light
+        && a.images == b.images
+        && a.sources == b.sources
+        && a.layers == b.layers;
+}
+
+// Collects every renderStill() call made with the same map state, so that they can all be
+// satisfied by one render of that state.
 struct StillImageRequest {
-    StillImageRequest(Map::StillImageCallback&& callback_)
-        : callback(std::move(callback_)) {
+    StillImageRequest(StillImageState state_, bool styleLoaded_, Map::StillImageCallback&& callback_)
+        : state(std::move(state_)),
+          styleLoaded(styleLoaded_),
+          requested(Clock::now()) {
+        callbacks.push_back(std::move(callback_));
     }
 
-    Map::StillImageCallback callback;
+    void finish(MapObserver& observer, std::exception_ptr error) {
+        observer.onDidFinishRenderingStill(callbacks.size(), Clock::now() - requested);
+        for (auto& callback : callbacks) {
+            callback(error);
+        }
+    }
+
+    StillImageState state;
+
+    // Whether the style had loaded when `state` was recorded. Until it has, the state is
+    // re-recorded on every update, so that the request renders the style once it has loaded.
+    bool styleLoaded;
+
+    const TimePoint requested;
+    std::vector<Map::StillImageCallback> callbacks;
 };
 
 class Map::Impl : public style::Observer,
@@ -86,6 +129,10 @@ public:
     bool loading = false;
     bool rendererFullyLoaded;
     std::unique_ptr<StillImageRequest> stillImageRequest;
+    std::deque<std::unique_ptr<StillImageRequest>> pendingStillImageRequests;
+
+    StillImageState getStillImageState() const;
+    void finishStillImageRequest(std::exception_ptr);
 };
 
 Map::Map(RendererFrontend& rendererFrontend,
@@ -154,17 +201,30 @@ void Map::renderStill(StillImageCallback callback) {
         return;
     }
 
-    if (impl->stillImageRequest) {
-        callback(std::make_exception_ptr(util::MisuseException("Map is currently rendering an image")));
+    if (impl->style->impl->getLastError()) {
+        callback(impl->style->impl->getLastError());
         return;
     }
 
-    if (impl->style->impl->getLastError()) {
-        callback(impl->style->impl->getLastError());
+    StillImageState state = impl->getStillImageState();
+
+    if (impl->stillImageRequest) {
+        // Join the last request if it is for the same state, otherwise render once the requests
+        // ahead of this one are done.
+        auto& last = impl->pendingStillImageRequests.empty()
+            ? impl->stillImageRequest
+            : impl->pendingStillImageRequests.back();
+        if (last->state == state) {
+            last->callbacks.push_back(std::move(callback));
+        } else {
+            impl->pendingStillImageRequests.push_back(std::make_unique<StillImageRequest>(
+                std::move(state), impl->style->impl->isLoaded(), std::move(callback)));
+        }
         return;
     }
 
-    impl->stillImageRequest = std::make_unique<StillImageRequest>(std::move(callback));
+    impl->stillImageRequest = std::make_unique<StillImageRequest>(
+        std::move(state), impl->style->impl->isLoaded(), std::move(callback));
 
     impl->onUpdate(Update::Repaint);
 }
@@ -207,11 +267,36 @@ void Map::Impl::onDidFinishRenderingMap() {
             observer.onDidFinishLoadingMap();
         }
     } else if (stillImageRequest) {
-        auto request = std::move(stillImageRequest);
-        request->callback(nullptr);
+        finishStillImageRequest(nullptr);
     }
 };
 
+StillImageState Map::Impl::getStillImageState() const {
+    return {
+        transform.getCameraOptions({}),
+        transform.getState().getSize(),
+        transform.getState(),
+        debugOptions,
+        style->impl->getLight()->impl,
+        style->impl->getImageImpls(),
+        style->impl->getSourceImpls(),
+        style->impl->getLayerImpls()
+    };
+}
+
+void Map::Impl::finishStillImageRequest(std::exception_ptr error) {
+    auto request = std::move(stillImageRequest);
+
+    if (!pendingStillImageRequests.empty()) {
+        stillImageRequest = std::move(pendingStillImageRequests.front());
+        pendingStillImageRequests.pop_front();
+        onUpdate(Update::Repaint);
+    }
+
+    // Finish last: callbacks may request more images.
+    request->finish(observer, error);
+}
+
 #pragma mark - Style
 
 style::Style& Map::getStyle() {
@@ -650,8 +735,10 @@ void Map::cycleDebugOptions() {
 #endif // MBGL_USE_GLES2
     else if (impl->debugOptions & MapDebugOptions::Collision)
         impl->debugOptions = MapDebugOptions::Overdraw;
-    else if (impl->debugOptions & MapDebugOptions::Timestamps)
+    else if (impl->debugOptions & MapDebugOptions::TileTimings)
         impl->debugOptions = impl->debugOptions | MapDebugOptions::Collision;
+    else if (impl->debugOptions & MapDebugOptions::Timestamps)
+        impl->debugOptions = impl->debugOptions | MapDebugOptions::TileTimings;
     else if (impl->debugOptions & MapDebugOptions::ParseStatus)
         impl->debugOptions = impl->debugOptions | MapDebugOptions::Timestamps;
     else if (impl->debugOptions & MapDebugOptions::TileBorders)
@@ -695,20 +782,29 @@ void Map::Impl::onUpdate(Update flags) {
         annotationManager.updateData();
     }
 
+    // A still image request renders the map state it was made with, even if the map has changed
+    // since: later changes belong to the requests queued behind it. Requests made before the
+    // style loaded follow the map until it has.
+    if (stillImageRequest && !stillImageRequest->styleLoaded) {
+        stillImageRequest->state = getStillImageState();
+        stillImageRequest->styleLoaded = style->impl->isLoaded();
+    }
+    const StillImageState* still = stillImageRequest ? &stillImageRequest->state : nullptr;
+
     UpdateParameters params = {
         style->impl->isLoaded(),
         mode,
         pixelRatio,
-        debugOptions,
+        still ? still->debugOptions : debugOptions,
         timePoint,
-        transform.getState(),
+        still ? still->transformState : transform.getState(),
         style->impl->getGlyphURL(),
         style->impl->spriteLoaded,
         style->impl->getTransitionOptions(),
-        style->impl->getLight()->impl,
-        style->impl->getImageImpls(),
-        style->impl->getSourceImpls(),
-        style->impl->getLayerImpls(),
+        still ? still->light : style->impl->getLight()->impl,
+        still ? still->images : style->impl->getImageImpls(),
+        still ? still->sources : style->impl->getSourceImpls(),
+        still ? still->layers : style->impl->getLayerImpls(),
         scheduler,
         fileSource,
         annotationManager,
@@ -740,8 +836,7 @@ void Map::Impl::onStyleError(std::exception_ptr error) {
 
 void Map::Impl::onResourceError(std::exception_ptr error) {
     if (mode == MapMode::Still && stillImageRequest) {
-        auto request = std::move(stillImageRequest);
-        request->callback(error);
+        finishStillImageRequest(error);
     }
 }
 
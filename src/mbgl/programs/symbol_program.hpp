@@ -130,19 +130,19 @@ public:
 
 // Return the smallest range of stops that covers the interval [lowerZoom, upperZoom]
 template <class Stops>
-Range<float> getCoveringStops(Stops s, float lowerZoom, float upperZoom) {
-    assert(!s.stops.empty());
-    auto minIt = s.stops.lower_bound(lowerZoom);
-    auto maxIt = s.stops.lower_bound(upperZoom);
+Range<float> getCoveringStops(const Stops& stops, float lowerZoom, float upperZoom) {
+    assert(!stops.empty());
+    auto minIt = stops.lower_bound(lowerZoom);
+    auto maxIt = stops.lower_bound(upperZoom);
     
     // lower_bound yields first element >= lowerZoom, but we want the *last*
     // element <= lowerZoom, so if we found a stop > lowerZoom, back up by one.
-    if (minIt != s.stops.begin() && minIt != s.stops.end() && minIt->first > lowerZoom) {
+    if (minIt != stops.begin() && minIt != stops.end() && minIt->first > lowerZoom) {
         minIt--;
     }
     return Range<float> {
-        minIt == s.stops.end() ? s.stops.rbegin()->first : minIt->first,
-        maxIt == s.stops.end() ? s.stops.rbegin()->first : maxIt->first
+        minIt == stops.end() ? stops.rbegin()->first : minIt->first,
+        maxIt == stops.end() ? stops.rbegin()->first : maxIt->first
     };
 }
 
@@ -158,7 +158,7 @@ public:
       : layoutSize(function_.evaluate(tileZoom + 1)) {
         function_.stops.match(
             [&] (const style::ExponentialStops<float>& stops) {
-                const auto& zoomLevels = getCoveringStops(stops, tileZoom, tileZoom + 1);
+                const auto& zoomLevels = getCoveringStops(stops.getStops(), tileZoom, tileZoom + 1);
                 coveringRanges = std::make_tuple(
                     zoomLevels,
                     Range<float> { function_.evaluate(zoomLevels.min), function_.evaluate(zoomLevels.max) }
@@ -239,7 +239,7 @@ public:
           layoutZoom(tileZoom + 1),
           coveringZoomStops(function.stops.match(
             [&] (const auto& stops) {
-            return getCoveringStops(stops, tileZoom, tileZoom + 1); }))
+            return getCoveringStops(stops.stops, tileZoom, tileZoom + 1); }))
     {}
 
     Range<float> getVertexSizeData(const GeometryTileFeature& feature) override {
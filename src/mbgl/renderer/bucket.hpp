@@ -4,6 +4,8 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 
 #include <atomic>
+#include <cstddef>
+#include <string>
 
 namespace mbgl {
 
@@ -12,6 +14,22 @@ class Context;
 } // namespace gl
 
 class RenderLayer;
+class MemoryReport;
+
+// Bytes of geometry data held by a bucket. Layout vertices and indices stay on the CPU after
+// they are copied to the GPU; data-driven paint attributes are held run-length encoded on the
+// CPU and expanded to one value per vertex on the GPU.
+class BucketMemoryUsage {
+public:
+    std::size_t vertexBytes = 0;
+    std::size_t indexBytes = 0;
+    std::size_t paintAttributeBytes = 0;
+    std::size_t paintAttributeRunBytes = 0;
+    std::size_t imageBytes = 0;
+
+    // Adds the memory held on the CPU to the report. GPU storage is reported by the context.
+    void addTo(MemoryReport&, const std::string& source, const std::string& layer) const;
+};
 
 class Bucket : private util::noncopyable {
 public:
@@ -20,9 +38,11 @@ public:
 
     // Feature geometries are also used to populate the feature index.
     // Obtaining these is a costly operation, so we do it only once, and
-    // pass-by-const-ref the geometries as a second parameter.
+    // pass-by-const-ref the geometries as a second parameter. Temporaries
+    // allocated from `arena` remain valid until the end of the layer's layout.
     virtual void addFeature(const GeometryTileFeature&,
-                            const GeometryCollection&) {};
+                            const GeometryCollection&,
+                            Arena&) {};
 
     // As long as this bucket has a Prepare render pass, this function is getting called. Typically,
     // this only happens once when the bucket is being rendered for the first time.
@@ -34,6 +54,10 @@ public:
         return 0;
     };
 
+    virtual BucketMemoryUsage getMemoryUsage() const {
+        return {};
+    }
+
     bool needsUpload() const {
         return hasData() && !uploaded;
     }
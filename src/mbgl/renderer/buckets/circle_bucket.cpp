@@ -38,7 +38,8 @@ bool CircleBucket::hasData() const {
 }
 
 void CircleBucket::addFeature(const GeometryTileFeature& feature,
-                              const GeometryCollection& geometry) {
+                              const GeometryCollection& geometry,
+                              Arena&) {
     constexpr const uint16_t vertexLength = 4;
 
     for (auto& circle : geometry) {
@@ -112,4 +113,15 @@ float CircleBucket::getQueryRadius(const RenderLayer& layer) const {
     return radius + util::length(translate[0], translate[1]);
 }
 
+BucketMemoryUsage CircleBucket::getMemoryUsage() const {
+    BucketMemoryUsage usage;
+    usage.vertexBytes = vertices.byteSize();
+    usage.indexBytes = triangles.byteSize();
+    for (const auto& pair : paintPropertyBinders) {
+        usage.paintAttributeBytes += pair.second.attributeByteSize();
+        usage.paintAttributeRunBytes += pair.second.runByteSize();
+    }
+    return usage;
+}
+
 } // namespace mbgl
@@ -15,12 +15,14 @@ DebugBucket::DebugBucket(const OverscaledTileID& id,
                          const bool complete_,
                          optional<Timestamp> modified_,
                          optional<Timestamp> expires_,
+                         std::vector<std::string> timings_,
                          MapDebugOptions debugMode_,
                          gl::Context& context)
     : renderable(renderable_),
       complete(complete_),
       modified(std::move(modified_)),
       expires(std::move(expires_)),
+      timings(std::move(timings_)),
       debugMode(debugMode_) {
 
     gl::VertexVector<FillLayoutVertex> vertices;
@@ -72,6 +74,14 @@ DebugBucket::DebugBucket(const OverscaledTileID& id,
 
         const std::string expiresText = "expires: " + util::iso8601(*expires);
         addText(expiresText, 50, baseline + 200, 5);
+        baseline += 400;
+    }
+
+    if (debugMode & MapDebugOptions::TileTimings) {
+        for (const auto& line : timings) {
+            addText(line, 50, baseline, 5);
+            baseline += 200;
+        }
     }
 
     segments.emplace_back(0, 0, vertices.vertexSize(), indices.indexSize());
@@ -9,6 +9,9 @@
 #include <mbgl/gl/index_buffer.hpp>
 #include <mbgl/programs/debug_program.hpp>
 
+#include <string>
+#include <vector>
+
 namespace mbgl {
 
 class OverscaledTileID;
@@ -24,6 +27,7 @@ public:
                 bool complete,
                 optional<Timestamp> modified,
                 optional<Timestamp> expires,
+                std::vector<std::string> timings,
                 MapDebugOptions,
                 gl::Context&);
 
@@ -31,6 +35,7 @@ public:
     const bool complete;
     const optional<Timestamp> modified;
     const optional<Timestamp> expires;
+    const std::vector<std::string> timings;
     const MapDebugOptions debugMode;
 
     SegmentVector<DebugAttributes> segments;
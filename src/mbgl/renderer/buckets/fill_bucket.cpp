@@ -4,9 +4,11 @@
 #include <mbgl/style/layers/fill_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/constants.hpp>
 
 #include <mapbox/earcut.hpp>
 
+#include <algorithm>
 #include <cassert>
 
 namespace mapbox {
@@ -27,6 +29,44 @@ using namespace style;
 
 struct GeometryTooLongException : std::exception {};
 
+// Checks whether the polygon is an axis-aligned rectangle without holes that extends to or beyond
+// all four tile edges. Tiles over water or large landcover areas often consist of such a polygon.
+template <class Polygon>
+static bool isTileCoveringRectangle(const Polygon& polygon) {
+    if (polygon.size() != 1) {
+        return false;
+    }
+
+    const auto& ring = polygon.front();
+    if (ring.size() < 4 || ring.size() > 5 || (ring.size() == 5 && ring.front() != ring.back())) {
+        return false;
+    }
+
+    int16_t minX = ring[0].x, maxX = ring[0].x, minY = ring[0].y, maxY = ring[0].y;
+    for (const auto& point : ring) {
+        minX = std::min(minX, point.x);
+        maxX = std::max(maxX, point.x);
+        minY = std::min(minY, point.y);
+        maxY = std::max(maxY, point.y);
+    }
+
+    if (minX > 0 || minY > 0 || maxX < util::EXTENT || maxY < util::EXTENT) {
+        return false;
+    }
+
+    // Every vertex must be a distinct corner of the bounding box, and consecutive vertices must
+    // share an edge, or the ring isn't the rectangle itself.
+    for (std::size_t i = 0; i < 4; ++i) {
+        const auto& a = ring[i];
+        const auto& b = ring[(i + 1) % 4];
+        if ((a.x != minX && a.x != maxX) || (a.y != minY && a.y != maxY) || a == b || (a.x != b.x && a.y != b.y)) {
+            return false;
+        }
+    }
+
+    return ring[0] != ring[2] && ring[1] != ring[3];
+}
+
 FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<const RenderLayer*>& layers) {
     for (const auto& layer : layers) {
         paintPropertyBinders.emplace(
@@ -39,11 +79,16 @@ FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<con
 }
 
 void FillBucket::addFeature(const GeometryTileFeature& feature,
-                            const GeometryCollection& geometry) {
-    for (auto& polygon : classifyRings(geometry)) {
+                            const GeometryCollection& geometry,
+                            Arena& arena) {
+    for (auto& polygon : classifyRings(geometry, arena)) {
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
+        if (!coversTile) {
+            coversTile = isTileCoveringRectangle(polygon);
+        }
+
         std::size_t totalVertices = 0;
 
         for (const auto& ring : polygon) {
@@ -134,4 +179,15 @@ float FillBucket::getQueryRadius(const RenderLayer& layer) const {
 
 }
 
+BucketMemoryUsage FillBucket::getMemoryUsage() const {
+    BucketMemoryUsage usage;
+    usage.vertexBytes = vertices.byteSize();
+    usage.indexBytes = lines.byteSize() + triangles.byteSize();
+    for (const auto& pair : paintPropertyBinders) {
+        usage.paintAttributeBytes += pair.second.attributeByteSize();
+        usage.paintAttributeRunBytes += pair.second.runByteSize();
+    }
+    return usage;
+}
+
 } // namespace mbgl
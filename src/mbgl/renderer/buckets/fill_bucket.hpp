@@ -19,13 +19,16 @@ public:
     FillBucket(const BucketParameters&, const std::vector<const RenderLayer*>&);
 
     void addFeature(const GeometryTileFeature&,
-                    const GeometryCollection&) override;
+                    const GeometryCollection&,
+                    Arena&) override;
     bool hasData() const override;
 
     void upload(gl::Context&) override;
 
     float getQueryRadius(const RenderLayer&) const override;
 
+    BucketMemoryUsage getMemoryUsage() const override;
+
     gl::VertexVector<FillLayoutVertex> vertices;
     gl::IndexVector<gl::Lines> lines;
     gl::IndexVector<gl::Triangles> triangles;
@@ -37,6 +40,9 @@ public:
     optional<gl::IndexBuffer<gl::Triangles>> triangleIndexBuffer;
 
     std::map<std::string, FillProgram::PaintPropertyBinders> paintPropertyBinders;
+
+    // Whether one of the polygons is a rectangle that covers the entire tile.
+    bool coversTile = false;
 };
 
 } // namespace mbgl
@@ -45,8 +45,9 @@ FillExtrusionBucket::FillExtrusionBucket(const BucketParameters& parameters, con
 }
 
 void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
-                                     const GeometryCollection& geometry) {
-    for (auto& polygon : classifyRings(geometry)) {
+                                     const GeometryCollection& geometry,
+                                     Arena& arena) {
+    for (auto& polygon : classifyRings(geometry, arena)) {
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
@@ -60,7 +61,7 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
 
         if (totalVertices == 0) continue;
 
-        std::vector<uint32_t> flatIndices;
+        ArenaVector<uint32_t> flatIndices(arena);
         flatIndices.reserve(totalVertices);
 
         std::size_t startVertices = vertices.vertexSize();
@@ -166,4 +167,15 @@ float FillExtrusionBucket::getQueryRadius(const RenderLayer& layer) const {
     return util::length(translate[0], translate[1]);
 }
 
+BucketMemoryUsage FillExtrusionBucket::getMemoryUsage() const {
+    BucketMemoryUsage usage;
+    usage.vertexBytes = vertices.byteSize();
+    usage.indexBytes = triangles.byteSize();
+    for (const auto& pair : paintPropertyBinders) {
+        usage.paintAttributeBytes += pair.second.attributeByteSize();
+        usage.paintAttributeRunBytes += pair.second.runByteSize();
+    }
+    return usage;
+}
+
 } // namespace mbgl
@@ -17,13 +17,16 @@ public:
     FillExtrusionBucket(const BucketParameters&, const std::vector<const RenderLayer*>&);
 
     void addFeature(const GeometryTileFeature&,
-                    const GeometryCollection&) override;
+                    const GeometryCollection&,
+                    Arena&) override;
     bool hasData() const override;
 
     void upload(gl::Context&) override;
 
     float getQueryRadius(const RenderLayer&) const override;
 
+    BucketMemoryUsage getMemoryUsage() const override;
+
     gl::VertexVector<FillExtrusionLayoutVertex> vertices;
     gl::IndexVector<gl::Triangles> triangles;
     SegmentVector<FillExtrusionAttributes> triangleSegments;
@@ -28,9 +28,10 @@ LineBucket::LineBucket(const BucketParameters& parameters,
 }
 
 void LineBucket::addFeature(const GeometryTileFeature& feature,
-                            const GeometryCollection& geometryCollection) {
+                            const GeometryCollection& geometryCollection,
+                            Arena& arena) {
     for (auto& line : geometryCollection) {
-        addGeometry(line, feature);
+        addGeometry(line, feature, arena);
     }
 
     for (auto& pair : paintPropertyBinders) {
@@ -63,7 +64,7 @@ const float LINE_DISTANCE_SCALE = 1.0 / 2.0;
 // The maximum line distance, in tile units, that fits in the buffer.
 const float MAX_LINE_DISTANCE = std::pow(2, LINE_DISTANCE_BUFFER_BITS) / LINE_DISTANCE_SCALE;
 
-void LineBucket::addGeometry(const GeometryCoordinates& coordinates, const GeometryTileFeature& feature) {
+void LineBucket::addGeometry(const GeometryCoordinates& coordinates, const GeometryTileFeature& feature, Arena& arena) {
     const FeatureType type = feature.getType();
     const std::size_t len = [&coordinates] {
         std::size_t l = coordinates.size();
@@ -115,7 +116,9 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates, const Geome
     }
 
     const std::size_t startVertex = vertices.vertexSize();
-    std::vector<TriangleElement> triangleStore;
+    ArenaVector<TriangleElement> triangleStore(arena);
+    // Most vertices add two triangles; joins and caps add a few more.
+    triangleStore.reserve((len - first) * 3);
 
     for (std::size_t i = first; i < len; ++i) {
         if (type == FeatureType::Polygon && i == len - 1) {
@@ -397,7 +400,7 @@ void LineBucket::addCurrentVertex(const GeometryCoordinate& currentCoordinate,
                                   double endRight,
                                   bool round,
                                   std::size_t startVertex,
-                                  std::vector<TriangleElement>& triangleStore) {
+                                  ArenaVector<TriangleElement>& triangleStore) {
     Point<double> extrude = normal;
     if (endLeft)
         extrude = extrude - (util::perp(normal) * endLeft);
@@ -435,7 +438,7 @@ void LineBucket::addPieSliceVertex(const GeometryCoordinate& currentVertex,
                                    const Point<double>& extrude,
                                    bool lineTurnsLeft,
                                    std::size_t startVertex,
-                                   std::vector<TriangleElement>& triangleStore) {
+                                   ArenaVector<TriangleElement>& triangleStore) {
     Point<double> flippedExtrude = extrude * (lineTurnsLeft ? -1.0 : 1.0);
     vertices.emplace_back(LineProgram::layoutVertex(currentVertex, flippedExtrude, false, lineTurnsLeft, 0, distance * LINE_DISTANCE_SCALE));
     e3 = vertices.vertexSize() - 1 - startVertex;
@@ -499,4 +502,15 @@ float LineBucket::getQueryRadius(const RenderLayer& layer) const {
 }
 
 
+BucketMemoryUsage LineBucket::getMemoryUsage() const {
+    BucketMemoryUsage usage;
+    usage.vertexBytes = vertices.byteSize();
+    usage.indexBytes = triangles.byteSize();
+    for (const auto& pair : paintPropertyBinders) {
+        usage.paintAttributeBytes += pair.second.attributeByteSize();
+        usage.paintAttributeRunBytes += pair.second.runByteSize();
+    }
+    return usage;
+}
+
 } // namespace mbgl
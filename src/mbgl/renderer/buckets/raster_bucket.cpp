@@ -20,6 +20,7 @@ void RasterBucket::upload(gl::Context& context) {
         return;
     }
     if (!texture) {
+        assert(image);
         texture = context.createTexture(*image);
     }
     if (!segments.empty()) {
@@ -29,6 +30,14 @@ void RasterBucket::upload(gl::Context& context) {
     uploaded = true;
 }
 
+BucketMemoryUsage RasterBucket::getMemoryUsage() const {
+    BucketMemoryUsage usage;
+    usage.vertexBytes = vertices.byteSize();
+    usage.indexBytes = indices.byteSize();
+    usage.imageBytes = image ? image->bytes() : 0;
+    return usage;
+}
+
 void RasterBucket::clear() {
     vertexBuffer = {};
     indexBuffer = {};
@@ -45,6 +54,13 @@ void RasterBucket::setImage(std::shared_ptr<PremultipliedImage> image_) {
     uploaded = false;
 }
 
+void RasterBucket::releaseImage() {
+    // Without a texture, e.g. for a bucket without an image, there's nothing to draw from.
+    if (texture) {
+        image.reset();
+    }
+}
+
 void RasterBucket::setMask(TileMask&& mask_) {
     if (mask == mask_) {
         return;
@@ -104,7 +120,7 @@ void RasterBucket::setMask(TileMask&& mask_) {
 }
 
 bool RasterBucket::hasData() const {
-    return !!image;
+    return image || texture;
 }
 
 } // namespace mbgl
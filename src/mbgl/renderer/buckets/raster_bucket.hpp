@@ -19,11 +19,17 @@ public:
 
     void upload(gl::Context&) override;
     bool hasData() const override;
+    BucketMemoryUsage getMemoryUsage() const override;
 
     void clear();
     void setImage(std::shared_ptr<PremultipliedImage>);
     void setMask(TileMask&&);
 
+    // Drops the decoded image once it has been uploaded; the bucket keeps drawing from the
+    // texture. Does nothing before the upload. Buckets that share their image with an image
+    // source keep it instead.
+    void releaseImage();
+
     std::shared_ptr<PremultipliedImage> image;
     optional<gl::Texture> texture;
     TileMask mask{ { 0, 0, 0 } };
@@ -76,4 +76,17 @@ bool SymbolBucket::hasCollisionBoxData() const {
     return !collisionBox.segments.empty();
 }
 
+BucketMemoryUsage SymbolBucket::getMemoryUsage() const {
+    BucketMemoryUsage usage;
+    usage.vertexBytes = text.vertices.byteSize() + text.dynamicVertices.byteSize() +
+                        icon.vertices.byteSize() + icon.dynamicVertices.byteSize() +
+                        collisionBox.vertices.byteSize();
+    usage.indexBytes = text.triangles.byteSize() + icon.triangles.byteSize() + collisionBox.lines.byteSize();
+    for (const auto& pair : paintPropertyBinders) {
+        usage.paintAttributeBytes += pair.second.first.attributeByteSize() + pair.second.second.attributeByteSize();
+        usage.paintAttributeRunBytes += pair.second.first.runByteSize() + pair.second.second.runByteSize();
+    }
+    return usage;
+}
+
 } // namespace mbgl
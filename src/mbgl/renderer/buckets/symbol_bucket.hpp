@@ -48,6 +48,8 @@ public:
     bool hasIconData() const;
     bool hasCollisionBoxData() const;
 
+    BucketMemoryUsage getMemoryUsage() const override;
+
     const style::SymbolLayoutProperties::PossiblyEvaluated layout;
     const bool sdfIcons;
     const bool iconsNeedLinear;
@@ -0,0 +1,69 @@
+#include <mbgl/renderer/feature_handle.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+
+class FeatureHandle::Impl {
+public:
+    Impl(std::shared_ptr<const GeometryTileLayer> layer_,
+         std::unique_ptr<const GeometryTileFeature> feature_,
+         const CanonicalTileID& tileID_)
+        : layer(std::move(layer_)),
+          feature(std::move(feature_)),
+          tileID(tileID_) {
+    }
+
+    // The feature may not outlive its layer, so the layer is declared first, and destroyed last.
+    const std::shared_ptr<const GeometryTileLayer> layer;
+    const std::unique_ptr<const GeometryTileFeature> feature;
+    const CanonicalTileID tileID;
+};
+
+FeatureHandle::FeatureHandle(std::shared_ptr<const GeometryTileLayer> layer,
+                             std::unique_ptr<const GeometryTileFeature> feature,
+                             const CanonicalTileID& tileID)
+    : impl(std::make_shared<Impl>(std::move(layer), std::move(feature), tileID)) {
+    assert(impl->layer);
+    assert(impl->feature);
+}
+
+optional<FeatureIdentifier> FeatureHandle::getID() const {
+    return impl->feature->getID();
+}
+
+optional<Value> FeatureHandle::getValue(const std::string& key) const {
+    return impl->feature->getValue(key);
+}
+
+PropertyMap FeatureHandle::getProperties() const {
+    return impl->feature->getProperties();
+}
+
+Feature::geometry_type FeatureHandle::getGeometry() const {
+    return convertGeometry(*impl->feature, impl->tileID);
+}
+
+Feature FeatureHandle::toFeature(const optional<std::vector<std::string>>& properties,
+                                 bool includeGeometry) const {
+    if (!properties && includeGeometry) {
+        return convertFeature(*impl->feature, impl->tileID);
+    }
+
+    Feature feature { includeGeometry ? getGeometry() : Feature::geometry_type(mapbox::geometry::geometry_collection<double>()) };
+    if (properties) {
+        for (const auto& key : *properties) {
+            if (auto value = getValue(key)) {
+                feature.properties.emplace(key, std::move(*value));
+            }
+        }
+    } else {
+        feature.properties = getProperties();
+    }
+    feature.id = getID();
+    return feature;
+}
+
+} // namespace mbgl
@@ -0,0 +1,77 @@
+#include <mbgl/renderer/frame_profile.hpp>
+#include <mbgl/util/rapidjson.hpp>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+namespace mbgl {
+
+static const char* categoryName(FrameProfile::Category category) {
+    switch (category) {
+    case FrameProfile::Category::Frame: return "frame";
+    case FrameProfile::Category::Pass: return "pass";
+    case FrameProfile::Category::Layer: return "layer";
+    case FrameProfile::Category::Source: return "source";
+    }
+    return "";
+}
+
+static double microseconds(Duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+std::string encodeChromeTrace(const std::vector<FrameProfile>& profiles) {
+    rapidjson::StringBuffer s;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+
+    // Timestamps are relative to the start of the first frame.
+    const TimePoint origin = profiles.empty() ? TimePoint() : profiles.front().start;
+
+    for (const auto& profile : profiles) {
+        for (const auto& span : profile.spans) {
+            // A complete event, with its duration given as "dur".
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(span.name);
+            writer.Key("cat");
+            writer.String(categoryName(span.category));
+            writer.Key("ph");
+            writer.String("X");
+            writer.Key("pid");
+            writer.Uint(1);
+            writer.Key("tid");
+            writer.Uint(1);
+            writer.Key("ts");
+            writer.Double(microseconds(profile.start - origin + span.start));
+            writer.Key("dur");
+            writer.Double(microseconds(span.duration));
+            if (span.gpuDuration || span.drawCalls) {
+                writer.Key("args");
+                writer.StartObject();
+                if (span.gpuDuration) {
+                    writer.Key("gpu");
+                    writer.Double(microseconds(*span.gpuDuration));
+                }
+                if (span.drawCalls) {
+                    writer.Key("drawCalls");
+                    writer.Uint64(span.drawCalls);
+                }
+                writer.EndObject();
+            }
+            writer.EndObject();
+        }
+    }
+
+    writer.EndArray();
+    writer.Key("displayTimeUnit");
+    writer.String("ms");
+    writer.EndObject();
+
+    return s.GetString();
+}
+
+} // namespace mbgl
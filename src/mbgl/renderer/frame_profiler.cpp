@@ -0,0 +1,161 @@
+#include <mbgl/renderer/frame_profiler.hpp>
+#include <mbgl/gl/timer_query_extension.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+
+constexpr std::size_t FrameProfiler::none;
+constexpr std::size_t FrameProfiler::maxPendingFrames;
+
+FrameProfiler::FrameProfiler(gl::extension::TimerQuery* timerQuery_, Callback callback_, const std::size_t* drawCalls_)
+    : timerQuery(timerQuery_),
+      callback(std::move(callback_)),
+      drawCalls(drawCalls_) {
+}
+
+FrameProfiler::~FrameProfiler() {
+    if (!timerQuery) {
+        return;
+    }
+    for (const auto& frame : pending) {
+        for (const auto& query : frame.queries) {
+            freeQueries.push_back(query.id);
+        }
+    }
+    if (!freeQueries.empty()) {
+        MBGL_CHECK_ERROR(timerQuery->deleteQueries(static_cast<GLsizei>(freeQueries.size()), freeQueries.data()));
+    }
+}
+
+void FrameProfiler::beginFrame() {
+    assert(!recording);
+    recording = true;
+    current = {};
+    current.profile.start = Clock::now();
+    begin(FrameProfile::Category::Frame, "frame", false);
+}
+
+void FrameProfiler::endFrame() {
+    assert(recording);
+    while (!openSpans.empty()) {
+        end();
+    }
+    recording = false;
+    pending.push_back(std::move(current));
+    collect();
+}
+
+void FrameProfiler::begin(FrameProfile::Category category, const std::string& name, bool gpu) {
+    if (!recording) {
+        return;
+    }
+
+    const std::size_t index = current.profile.spans.size();
+    current.profile.spans.push_back({ category, name, Clock::now() - current.profile.start, Duration::zero(), {}, 0 });
+    current.parents.push_back(openSpans.empty() ? none : openSpans.back());
+    current.startDrawCalls.push_back(drawCalls ? *drawCalls : 0);
+    openSpans.push_back(index);
+
+    if (gpu && timerQuery && queriedSpan == none) {
+        const uint32_t id = acquireQuery();
+        MBGL_CHECK_ERROR(timerQuery->beginQuery(GL_TIME_ELAPSED, id));
+        current.queries.push_back({ index, id });
+        queriedSpan = index;
+    }
+}
+
+void FrameProfiler::end() {
+    if (!recording || openSpans.empty()) {
+        return;
+    }
+
+    const std::size_t index = openSpans.back();
+    openSpans.pop_back();
+
+    auto& span = current.profile.spans[index];
+    span.duration = Clock::now() - current.profile.start - span.start;
+    span.drawCalls = drawCalls ? *drawCalls - current.startDrawCalls[index] : 0;
+
+    if (queriedSpan == index) {
+        MBGL_CHECK_ERROR(timerQuery->endQuery(GL_TIME_ELAPSED));
+        queriedSpan = none;
+    }
+}
+
+void FrameProfiler::collect() {
+    while (!pending.empty() && resolve(pending.front(), pending.size() > maxPendingFrames)) {
+        for (const auto& query : pending.front().queries) {
+            freeQueries.push_back(query.id);
+        }
+        FrameProfile profile = std::move(pending.front().profile);
+        pending.pop_front();
+        callback(std::move(profile));
+    }
+}
+
+// Reads the results of the frame's timer queries into its spans. Returns false if they aren't
+// available yet, unless `force` is set, in which case the frame is resolved without GPU times.
+bool FrameProfiler::resolve(Frame& frame, bool force) {
+    if (force) {
+        return true;
+    }
+
+    for (const auto& query : frame.queries) {
+        GLuint available = 0;
+        MBGL_CHECK_ERROR(timerQuery->getQueryObjectuiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available) {
+            return false;
+        }
+    }
+
+    auto& spans = frame.profile.spans;
+    for (const auto& query : frame.queries) {
+        uint64_t nanoseconds = 0;
+        MBGL_CHECK_ERROR(timerQuery->getQueryObjectui64v(query.id, GL_QUERY_RESULT, &nanoseconds));
+        spans[query.span].gpuDuration = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(nanoseconds));
+    }
+
+    // Children follow their parents, so visiting spans in reverse adds up the GPU time of
+    // every child before its parent is visited.
+    if (!frame.queries.empty()) {
+        std::vector<optional<Duration>> childTotals(spans.size());
+        for (std::size_t i = spans.size(); i-- > 0;) {
+            if (!spans[i].gpuDuration) {
+                spans[i].gpuDuration = childTotals[i];
+            }
+            const std::size_t parent = frame.parents[i];
+            if (spans[i].gpuDuration && parent != none) {
+                childTotals[parent] = childTotals[parent].value_or(Duration::zero()) + *spans[i].gpuDuration;
+            }
+        }
+    }
+
+    return true;
+}
+
+uint32_t FrameProfiler::acquireQuery() {
+    if (freeQueries.empty()) {
+        GLuint id = 0;
+        MBGL_CHECK_ERROR(timerQuery->genQueries(1, &id));
+        return id;
+    }
+    const uint32_t id = freeQueries.back();
+    freeQueries.pop_back();
+    return id;
+}
+
+FrameProfiler::Scope::Scope(FrameProfiler* profiler_, FrameProfile::Category category, const std::string& name, bool gpu)
+    : profiler(profiler_) {
+    if (profiler) {
+        profiler->begin(category, name, gpu);
+    }
+}
+
+FrameProfiler::Scope::~Scope() {
+    if (profiler) {
+        profiler->end();
+    }
+}
+
+} // namespace mbgl
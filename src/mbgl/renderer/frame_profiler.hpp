@@ -0,0 +1,93 @@
+#pragma once
+
+#include <mbgl/renderer/frame_profile.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <deque>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+namespace gl {
+namespace extension {
+class TimerQuery;
+} // namespace extension
+} // namespace gl
+
+/*
+   Records a FrameProfile for each rendered frame. Spans are opened and closed with
+   FrameProfiler::Scope, which does nothing when given a null profiler, so that the
+   render loop can be instrumented unconditionally.
+
+   Spans opened with GPU timing get an OpenGL timer query if the implementation supports
+   them and no other query is running, since time elapsed queries can't be nested. Query
+   results become available a few frames later, so profiles are reported in order once
+   all of their queries have completed.
+
+   Draw calls are counted by reading the given counter, which must outlive the profiler,
+   when spans open and close. Without a counter, spans report no draw calls.
+
+   Must only be used on the render thread, with the OpenGL context current.
+*/
+class FrameProfiler : private util::noncopyable {
+public:
+    using Callback = std::function<void (FrameProfile)>;
+
+    FrameProfiler(gl::extension::TimerQuery*, Callback, const std::size_t* drawCalls = nullptr);
+    ~FrameProfiler();
+
+    void beginFrame();
+    void endFrame();
+
+    class Scope : private util::noncopyable {
+    public:
+        Scope(FrameProfiler*, FrameProfile::Category, const std::string& name, bool gpu = false);
+        ~Scope();
+
+    private:
+        FrameProfiler* const profiler;
+    };
+
+private:
+    static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+    // Frames whose results aren't available after this many frames are reported without GPU times.
+    static constexpr std::size_t maxPendingFrames = 8;
+
+    struct Query {
+        std::size_t span;
+        uint32_t id;
+    };
+
+    struct Frame {
+        FrameProfile profile;
+        std::vector<std::size_t> parents;
+        std::vector<std::size_t> startDrawCalls;
+        std::vector<Query> queries;
+    };
+
+    void begin(FrameProfile::Category, const std::string& name, bool gpu);
+    void end();
+
+    void collect();
+    bool resolve(Frame&, bool force);
+
+    uint32_t acquireQuery();
+
+    gl::extension::TimerQuery* const timerQuery;
+    const Callback callback;
+    const std::size_t* const drawCalls;
+
+    bool recording = false;
+    Frame current;
+    std::vector<std::size_t> openSpans;
+    std::size_t queriedSpan = none;
+
+    std::deque<Frame> pending;
+    std::vector<uint32_t> freeQueries;
+};
+
+} // namespace mbgl
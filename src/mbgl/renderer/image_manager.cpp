@@ -1,4 +1,5 @@
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/memory_report.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/gl/context.hpp>
 
@@ -93,6 +94,15 @@ void ImageManager::dumpDebugLogs() const {
     Log::Info(Event::General, "ImageManager::loaded: %d", loaded);
 }
 
+void ImageManager::reportMemory(MemoryReport& report) const {
+    std::size_t imageBytes = 0;
+    for (const auto& entry : images) {
+        imageBytes += entry.second->image.bytes();
+    }
+    report.add("", "", MemoryCategory::Images, imageBytes);
+    report.add("", "", MemoryCategory::Atlases, atlasImage.bytes());
+}
+
 // When copied into the atlas texture, image data is padded by one pixel on each side. Icon
 // images are padded with fully transparent pixels, while pattern images are padded with a
 // copy of the image data wrapped from the opposite side. In both cases, this ensures the
@@ -18,6 +18,8 @@ namespace gl {
 class Context;
 } // namespace gl
 
+class MemoryReport;
+
 class ImageRequestor {
 public:
     virtual ~ImageRequestor() = default;
@@ -43,6 +45,7 @@ public:
     bool isLoaded() const;
 
     void dumpDebugLogs() const;
+    void reportMemory(MemoryReport&) const;
 
     const style::Image::Impl* getImage(const std::string&) const;
 
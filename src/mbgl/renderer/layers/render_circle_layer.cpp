@@ -47,6 +47,10 @@ bool RenderCircleLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
+bool RenderCircleLayer::needsClipping(const PaintParameters& parameters) const {
+    return parameters.mapMode == MapMode::Still;
+}
+
 void RenderCircleLayer::render(PaintParameters& parameters, RenderSource*) {
     if (parameters.pass == RenderPass::Opaque) {
         return;
@@ -93,6 +97,10 @@ void RenderCircleLayer::render(PaintParameters& parameters, RenderSource*) {
     }
 }
 
+std::unique_ptr<RenderLayer> RenderCircleLayer::cloneForQuery() const {
+    return std::make_unique<RenderCircleLayer>(*this);
+}
+
 bool RenderCircleLayer::queryIntersectsFeature(
         const GeometryCoordinates& queryGeometry,
         const GeometryTileFeature& feature,
@@ -159,6 +159,10 @@ void RenderFillExtrusionLayer::render(PaintParameters& parameters, RenderSource*
         getID());
 }
 
+std::unique_ptr<RenderLayer> RenderFillExtrusionLayer::cloneForQuery() const {
+    return std::make_unique<RenderFillExtrusionLayer>(*this);
+}
+
 bool RenderFillExtrusionLayer::queryIntersectsFeature(
         const GeometryCoordinates& queryGeometry,
         const GeometryTileFeature& feature,
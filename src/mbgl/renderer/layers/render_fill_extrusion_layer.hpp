@@ -23,6 +23,8 @@ public:
         const float,
         const float) const override;
 
+    std::unique_ptr<RenderLayer> cloneForQuery() const override;
+
     std::unique_ptr<Bucket> createBucket(const BucketParameters&, const std::vector<const RenderLayer*>&) const override;
 
     // Paint properties
@@ -58,6 +58,10 @@ bool RenderFillLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
+bool RenderFillLayer::needsClipping(const PaintParameters&) const {
+    return true;
+}
+
 void RenderFillLayer::render(PaintParameters& parameters, RenderSource*) {
     if (evaluated.get<FillPattern>().from.empty()) {
         for (const RenderTile& tile : renderTiles) {
@@ -97,11 +101,26 @@ void RenderFillLayer::render(PaintParameters& parameters, RenderSource*) {
             // or when it's translucent and we're drawing translucent fragments.
             if ((evaluated.get<FillColor>().constantOr(Color()).a >= 1.0f
               && evaluated.get<FillOpacity>().constantOr(0) >= 1.0f) == (parameters.pass == RenderPass::Opaque)) {
+                if (parameters.pass == RenderPass::Opaque) {
+                    // Opaque layers are drawn top-to-bottom: skip tiles that a higher layer
+                    // already covered entirely within the same clipping region.
+                    auto covered = parameters.opaqueCoveredTiles.find(tile.id);
+                    if (covered != parameters.opaqueCoveredTiles.end() && covered->second == tile.clip) {
+                        continue;
+                    }
+                }
+
                 draw(parameters.programs.fill,
                      gl::Triangles(),
                      parameters.depthModeForSublayer(1, gl::DepthMode::ReadWrite),
                      *bucket.triangleIndexBuffer,
                      bucket.triangleSegments);
+
+                const auto& translate = evaluated.get<FillTranslate>();
+                if (parameters.pass == RenderPass::Opaque && bucket.coversTile &&
+                    translate[0] == 0 && translate[1] == 0) {
+                    parameters.opaqueCoveredTiles.emplace(tile.id, tile.clip);
+                }
             }
 
             if (evaluated.get<FillAntialias>() && parameters.pass == RenderPass::Translucent) {
@@ -182,6 +201,10 @@ void RenderFillLayer::render(PaintParameters& parameters, RenderSource*) {
     }
 }
 
+std::unique_ptr<RenderLayer> RenderFillLayer::cloneForQuery() const {
+    return std::make_unique<RenderFillLayer>(*this);
+}
+
 bool RenderFillLayer::queryIntersectsFeature(
         const GeometryCoordinates& queryGeometry,
         const GeometryTileFeature& feature,
@@ -15,6 +15,7 @@ public:
     void evaluate(const PropertyEvaluationParameters&) override;
     bool hasTransition() const override;
     void render(PaintParameters&, RenderSource*) override;
+    bool needsClipping(const PaintParameters&) const override;
 
     bool queryIntersectsFeature(
             const GeometryCoordinates&,
@@ -23,6 +24,8 @@ public:
             const float,
             const float) const override;
 
+    std::unique_ptr<RenderLayer> cloneForQuery() const override;
+
     std::unique_ptr<Bucket> createBucket(const BucketParameters&, const std::vector<const RenderLayer*>&) const override;
 
     // Paint properties
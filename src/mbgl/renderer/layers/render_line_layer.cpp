@@ -52,6 +52,10 @@ bool RenderLineLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
+bool RenderLineLayer::needsClipping(const PaintParameters&) const {
+    return true;
+}
+
 void RenderLineLayer::render(PaintParameters& parameters, RenderSource*) {
     if (parameters.pass == RenderPass::Opaque) {
         return;
@@ -158,6 +162,10 @@ optional<GeometryCollection> offsetLine(const GeometryCollection& rings, const d
     return newRings;
 }
 
+std::unique_ptr<RenderLayer> RenderLineLayer::cloneForQuery() const {
+    return std::make_unique<RenderLineLayer>(*this);
+}
+
 bool RenderLineLayer::queryIntersectsFeature(
         const GeometryCoordinates& queryGeometry,
         const GeometryTileFeature& feature,
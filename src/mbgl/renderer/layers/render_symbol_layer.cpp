@@ -32,6 +32,10 @@ const style::SymbolLayer::Impl& RenderSymbolLayer::impl() const {
     return static_cast<const style::SymbolLayer::Impl&>(*baseImpl);
 }
 
+std::unique_ptr<RenderLayer> RenderSymbolLayer::cloneForQuery() const {
+    return std::make_unique<RenderSymbolLayer>(*this);
+}
+
 std::unique_ptr<Bucket> RenderSymbolLayer::createBucket(const BucketParameters&, const std::vector<const RenderLayer*>&) const {
     assert(false); // Should be calling createLayout() instead.
     return nullptr;
@@ -70,6 +74,10 @@ bool RenderSymbolLayer::hasTransition() const {
     return unevaluated.hasTransition();
 }
 
+bool RenderSymbolLayer::needsClipping(const PaintParameters& parameters) const {
+    return parameters.mapMode == MapMode::Still;
+}
+
 void RenderSymbolLayer::render(PaintParameters& parameters, RenderSource*) {
     if (parameters.pass == RenderPass::Opaque) {
         return;
@@ -0,0 +1,56 @@
+#include <mbgl/renderer/memory_report.hpp>
+#include <mbgl/renderer/bucket.hpp>
+
+namespace mbgl {
+
+void MemoryReport::add(std::string source, std::string layer, MemoryCategory category, std::size_t bytes) {
+    if (bytes > 0) {
+        entries.push_back({ std::move(source), std::move(layer), category, bytes });
+    }
+}
+
+std::size_t MemoryReport::total() const {
+    std::size_t result = 0;
+    for (const auto& entry : entries) {
+        result += entry.bytes;
+    }
+    return result;
+}
+
+std::size_t MemoryReport::total(MemoryCategory category) const {
+    std::size_t result = 0;
+    for (const auto& entry : entries) {
+        if (entry.category == category) {
+            result += entry.bytes;
+        }
+    }
+    return result;
+}
+
+std::size_t MemoryReport::totalForSource(const std::string& source) const {
+    std::size_t result = 0;
+    for (const auto& entry : entries) {
+        if (entry.source == source) {
+            result += entry.bytes;
+        }
+    }
+    return result;
+}
+
+std::size_t MemoryReport::totalForLayer(const std::string& layer) const {
+    std::size_t result = 0;
+    for (const auto& entry : entries) {
+        if (entry.layer == layer) {
+            result += entry.bytes;
+        }
+    }
+    return result;
+}
+
+void BucketMemoryUsage::addTo(MemoryReport& report, const std::string& source, const std::string& layer) const {
+    report.add(source, layer, MemoryCategory::Geometry, vertexBytes + indexBytes);
+    report.add(source, layer, MemoryCategory::PaintAttributes, paintAttributeRunBytes);
+    report.add(source, layer, MemoryCategory::Images, imageBytes);
+}
+
+} // namespace mbgl
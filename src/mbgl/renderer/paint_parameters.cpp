@@ -62,6 +62,11 @@ gl::DepthMode PaintParameters::depthModeForSublayer(uint8_t n, gl::DepthMode::Ma
 }
 
 gl::StencilMode PaintParameters::stencilModeForClipping(const ClipID& id) const {
+    // Tiles without a clip ID have no clipping mask.
+    if (id.reference.none()) {
+        return gl::StencilMode::disabled();
+    }
+
     return gl::StencilMode {
         gl::StencilMode::Equal { static_cast<uint32_t>(id.mask.to_ulong()) },
         static_cast<int32_t>(id.reference.to_ulong()),
@@ -74,7 +79,7 @@ gl::StencilMode PaintParameters::stencilModeForClipping(const ClipID& id) const
 
 gl::ColorMode PaintParameters::colorModeForRenderPass() const {
     if (debugOptions & MapDebugOptions::Overdraw) {
-        const float overdraw = 1.0f / 8.0f;
+        const float overdraw = overdrawIncrement;
         return gl::ColorMode {
             gl::ColorMode::Add {
                 gl::ColorMode::ConstantColor,
@@ -90,4 +95,21 @@ gl::ColorMode PaintParameters::colorModeForRenderPass() const {
     }
 }
 
+constexpr float PaintParameters::overdrawIncrement;
+
+double overdrawRatio(const PremultipliedImage& image) {
+    if (!image.valid()) {
+        return 0;
+    }
+
+    // All three color channels receive the same increment, so the red channel suffices.
+    uint64_t sum = 0;
+    for (std::size_t i = 0; i < image.bytes(); i += 4) {
+        sum += image.data[i];
+    }
+
+    const double pixels = image.size.width * image.size.height;
+    return sum / (pixels * 255.0 * PaintParameters::overdrawIncrement);
+}
+
 } // namespace mbgl
@@ -7,6 +7,7 @@
 #include <mbgl/gl/stencil_mode.hpp>
 #include <mbgl/gl/color_mode.hpp>
 #include <mbgl/util/mat4.hpp>
+#include <mbgl/util/image.hpp>
 #include <mbgl/algorithm/generate_clip_ids.hpp>
 
 #include <array>
@@ -56,6 +57,11 @@ public:
     std::array<float, 2> pixelsToGLUnits;
     algorithm::ClipIDGenerator clipIDGenerator;
 
+    // Tiles into which an opaque fill covering the entire tile was drawn during the opaque pass,
+    // along with the clip ID it was drawn with. Opaque fills of lower layers drawn into the same
+    // clipping region are hidden behind it and don't need to be drawn at all.
+    std::map<UnwrappedTileID, ClipID> opaqueCoveredTiles;
+
     Programs& programs;
 
     gl::DepthMode depthModeForSublayer(uint8_t n, gl::DepthMode::Mask) const;
@@ -71,6 +77,13 @@ public:
     uint32_t currentLayer;
     float depthRangeSize;
     const float depthEpsilon = 1.0f / (1 << 16);
+
+    // The amount every draw adds to each color channel with MapDebugOptions::Overdraw.
+    static constexpr float overdrawIncrement = 1.0f / 8.0f;
 };
 
+// Returns the average number of draws per pixel of an image rendered with MapDebugOptions::Overdraw.
+// Pixels that were drawn more than 8 times saturate and only count as 8 draws.
+double overdrawRatio(const PremultipliedImage&);
+
 } // namespace mbgl
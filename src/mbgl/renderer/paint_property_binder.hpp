@@ -8,7 +8,11 @@
 #include <mbgl/renderer/possibly_evaluated_property_value.hpp>
 #include <mbgl/renderer/paint_property_statistics.hpp>
 
+#include <algorithm>
 #include <bitset>
+#include <cassert>
+#include <limits>
+#include <vector>
 
 namespace mbgl {
 
@@ -26,22 +30,23 @@ inline std::array<float, 1> attributeValue(float v) {
 }
 
 /*
-    Encode a four-component color value into a pair of floats.  Since csscolorparser
-    uses 8-bit precision for each color component, for each float we use the upper 8
+    Encode a four-component color value into a pair of 16-bit integers.  Since csscolorparser
+    uses 8-bit precision for each color component, for each integer we use the upper 8
     bits for one component (e.g. (color.r * 255) * 256), and the lower 8 for another.
+    The attribute isn't normalized, so the shader receives the same values as floats.
     
     Also note that colors come in as floats 0..1, so we scale by 255.
 */
-inline std::array<float, 2> attributeValue(const Color& color) {
+inline std::array<uint16_t, 2> attributeValue(const Color& color) {
     return {{
-        static_cast<float>(mbgl::attributes::packUint8Pair(255 * color.r, 255 * color.g)),
-        static_cast<float>(mbgl::attributes::packUint8Pair(255 * color.b, 255 * color.a))
+        mbgl::attributes::packUint8Pair(255 * color.r, 255 * color.g),
+        mbgl::attributes::packUint8Pair(255 * color.b, 255 * color.a)
     }};
 }
 
-template <size_t N>
-std::array<float, N*2> zoomInterpolatedAttributeValue(const std::array<float, N>& min, const std::array<float, N>& max) {
-    std::array<float, N*2> result;
+template <class T, size_t N>
+std::array<T, N*2> zoomInterpolatedAttributeValue(const std::array<T, N>& min, const std::array<T, N>& max) {
+    std::array<T, N*2> result;
     for (size_t i = 0; i < N; i++) {
         result[i]   = min[i];
         result[i+N] = max[i];
@@ -49,6 +54,52 @@ std::array<float, N*2> zoomInterpolatedAttributeValue(const std::array<float, N>
     return result;
 }
 
+/*
+   Paint attribute values for the vertices of a bucket, stored as one run for each span of
+   consecutive vertices with the same value. A feature contributes many vertices with the
+   same value, and neighbouring features often share it, so this is much smaller than a
+   value per vertex. The runs are only expanded to a vertex vector for upload.
+*/
+template <class Value>
+class AttributeRuns {
+public:
+    // Assigns `value` to the vertices from the end of the last run up to `length`.
+    void add(const Value& value, std::size_t length) {
+        if (length <= vertexCount()) {
+            return;
+        }
+        assert(length <= std::numeric_limits<uint32_t>::max());
+        if (!runs.empty() && runs.back().value == value) {
+            runs.back().end = static_cast<uint32_t>(length);
+        } else {
+            runs.push_back({ value, static_cast<uint32_t>(length) });
+        }
+    }
+
+    template <class Vertex, class Fn>
+    gl::VertexVector<Vertex> expand(Fn&& toVertex) const {
+        gl::VertexVector<Vertex> result;
+        std::size_t i = 0;
+        for (const auto& run : runs) {
+            const Vertex vertex = toVertex(run.value);
+            for (; i < run.end; ++i) {
+                result.emplace_back(vertex);
+            }
+        }
+        return result;
+    }
+
+    std::size_t vertexCount() const { return runs.empty() ? 0 : runs.back().end; }
+    std::size_t byteSize() const { return runs.size() * sizeof(Run); }
+
+private:
+    struct Run {
+        Value value;
+        uint32_t end;
+    };
+    std::vector<Run> runs;
+};
+
 /*
    PaintPropertyBinder is an abstract class serving as the interface definition for
    the strategy used for constructing, uploading, and binding paint property data as
@@ -61,13 +112,15 @@ std::array<float, N*2> zoomInterpolatedAttributeValue(const std::array<float, N>
      don't need a vertex buffer, and instead use a uniform.
    * For source functions, we use a vertex buffer with a single attribute value,
      the evaluated result of the source function for the given feature.
+     Until uploaded, the values are kept run-length encoded in AttributeRuns.
    * For composite functions, we use a vertex buffer with two attributes: min and
      max values covering the range of zooms at which we expect the tile to be
      displayed. These values are calculated by evaluating the composite function for
      the given feature at strategically chosen zoom levels. In addition to this
      attribute data, we also use a uniform value which the shader uses to interpolate
      between the min and max value at the final displayed zoom level. The use of a
-     uniform allows us to cheaply update the value on every frame.
+     uniform allows us to cheaply update the value on every frame. If the min and max
+     values turn out to be the same for every feature, only the min values are uploaded.
 
    Note that the shader source varies depending on whether we're using a uniform or
    attribute. Like GL JS, we dynamically compile shaders at runtime to accomodate this.
@@ -86,6 +139,11 @@ public:
     virtual float interpolationFactor(float currentZoom) const = 0;
     virtual T uniformValue(const PossiblyEvaluatedPropertyValue<T>& currentValue) const = 0;
 
+    // Bytes of vertex attribute data uploaded, or to be uploaded, to the GPU.
+    virtual std::size_t attributeByteSize() const = 0;
+    // Bytes of run-length encoded attribute values held on the CPU.
+    virtual std::size_t runByteSize() const = 0;
+
     static std::unique_ptr<PaintPropertyBinder> create(const PossiblyEvaluatedPropertyValue<T>& value, float zoom, T defaultValue);
 
     PaintPropertyStatistics<T> statistics;
@@ -116,6 +174,14 @@ public:
         return currentValue.constantOr(constant);
     }
 
+    std::size_t attributeByteSize() const override {
+        return 0;
+    }
+
+    std::size_t runByteSize() const override {
+        return 0;
+    }
+
 private:
     T constant;
 };
@@ -138,14 +204,13 @@ public:
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) override {
         auto evaluated = function.evaluate(feature, defaultValue);
         this->statistics.add(evaluated);
-        auto value = attributeValue(evaluated);
-        for (std::size_t i = vertexVector.vertexSize(); i < length; ++i) {
-            vertexVector.emplace_back(BaseVertex { value });
-        }
+        runs.add(attributeValue(evaluated), length);
     }
 
     void upload(gl::Context& context) override {
-        vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+        vertexBuffer = context.createVertexBuffer(runs.template expand<BaseVertex>([] (const BaseAttributeValue& value) {
+            return BaseVertex { value };
+        }));
     }
 
     optional<AttributeBinding> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
@@ -169,10 +234,18 @@ public:
         }
     }
 
+    std::size_t attributeByteSize() const override {
+        return runs.vertexCount() * sizeof(BaseVertex);
+    }
+
+    std::size_t runByteSize() const override {
+        return runs.byteSize();
+    }
+
 private:
     style::SourceFunction<T> function;
     T defaultValue;
-    gl::VertexVector<BaseVertex> vertexVector;
+    AttributeRuns<BaseAttributeValue> runs;
     optional<gl::VertexBuffer<BaseVertex>> vertexBuffer;
 };
 
@@ -181,6 +254,7 @@ class CompositeFunctionPaintPropertyBinder : public PaintPropertyBinder<T, A> {
 public:
     using BaseAttribute = A;
     using BaseAttributeValue = typename BaseAttribute::Value;
+    using BaseVertex = gl::detail::Vertex<BaseAttribute>;
 
     using Attribute = ZoomInterpolatedAttributeType<A>;
     using AttributeValue = typename Attribute::Value;
@@ -197,28 +271,41 @@ public:
         Range<T> range = function.evaluate(rangeOfCoveringRanges, feature, defaultValue);
         this->statistics.add(range.min);
         this->statistics.add(range.max);
-        AttributeValue value = zoomInterpolatedAttributeValue(
-            attributeValue(range.min),
-            attributeValue(range.max));
-        for (std::size_t i = vertexVector.vertexSize(); i < length; ++i) {
-            vertexVector.emplace_back(Vertex { value });
-        }
+        const BaseAttributeValue min = attributeValue(range.min);
+        const BaseAttributeValue max = attributeValue(range.max);
+        zoomConstant = zoomConstant && min == max;
+        runs.add(zoomInterpolatedAttributeValue(min, max), length);
     }
 
     void upload(gl::Context& context) override {
-        vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+        if (zoomConstant) {
+            // Upload the min values only, and bind them the way source function values are bound.
+            baseVertexBuffer = context.createVertexBuffer(runs.template expand<BaseVertex>([] (const AttributeValue& value) {
+                BaseVertex vertex {};
+                std::copy_n(value.begin(), BaseAttribute::Dimensions, vertex.a1.begin());
+                return vertex;
+            }));
+        } else {
+            vertexBuffer = context.createVertexBuffer(runs.template expand<Vertex>([] (const AttributeValue& value) {
+                return Vertex { value };
+            }));
+        }
     }
 
     optional<AttributeBinding> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
         if (currentValue.isConstant()) {
             return {};
+        } else if (baseVertexBuffer) {
+            return Attribute::binding(*baseVertexBuffer, 0, BaseAttribute::Dimensions);
         } else {
             return Attribute::binding(*vertexBuffer, 0);
         }
     }
 
     float interpolationFactor(float currentZoom) const override {
-        if (function.useIntegerZoom) {
+        if (zoomConstant) {
+            return 0.0f;
+        } else if (function.useIntegerZoom) {
             return util::interpolationFactor(1.0f, { rangeOfCoveringRanges.min.zoom, rangeOfCoveringRanges.max.zoom }, std::floor(currentZoom));
         } else {
             return util::interpolationFactor(1.0f, { rangeOfCoveringRanges.min.zoom, rangeOfCoveringRanges.max.zoom }, currentZoom);
@@ -234,13 +321,24 @@ public:
         }
     }
 
+    std::size_t attributeByteSize() const override {
+        return runs.vertexCount() * (zoomConstant ? sizeof(BaseVertex) : sizeof(Vertex));
+    }
+
+    std::size_t runByteSize() const override {
+        return runs.byteSize();
+    }
+
 private:
     style::CompositeFunction<T> function;
     T defaultValue;
     using CoveringRanges = typename style::CompositeFunction<T>::CoveringRanges;
     Range<CoveringRanges> rangeOfCoveringRanges;
-    gl::VertexVector<Vertex> vertexVector;
+    AttributeRuns<AttributeValue> runs;
+    // Whether every feature has the same value at both ends of the zoom range.
+    bool zoomConstant = true;
     optional<gl::VertexBuffer<Vertex>> vertexBuffer;
+    optional<gl::VertexBuffer<BaseVertex>> baseVertexBuffer;
 };
 
 template <class T, class A>
@@ -336,6 +434,22 @@ public:
         };
     }
 
+    std::size_t attributeByteSize() const {
+        std::size_t result = 0;
+        util::ignore({
+            (result += binders.template get<Ps>()->attributeByteSize(), 0)...
+        });
+        return result;
+    }
+
+    std::size_t runByteSize() const {
+        std::size_t result = 0;
+        util::ignore({
+            (result += binders.template get<Ps>()->runByteSize(), 0)...
+        });
+        return result;
+    }
+
     template <class P>
     const auto& statistics() const {
         return binders.template get<P>()->statistics;
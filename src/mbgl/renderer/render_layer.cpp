@@ -44,6 +44,12 @@ RenderLayer::RenderLayer(style::LayerType type_, Immutable<style::Layer::Impl> b
           baseImpl(baseImpl_) {
 }
 
+RenderLayer::RenderLayer(const RenderLayer& other)
+        : type(other.type),
+          baseImpl(other.baseImpl),
+          passes(other.passes) {
+}
+
 void RenderLayer::setImpl(Immutable<style::Layer::Impl> impl) {
     baseImpl = impl;
 }
@@ -22,6 +22,9 @@ class RenderLayer {
 protected:
     RenderLayer(style::LayerType, Immutable<style::Layer::Impl>);
 
+    // Copies the layer's properties, but not the tiles it currently renders.
+    RenderLayer(const RenderLayer&);
+
     const style::LayerType type;
 
 public:
@@ -63,6 +66,15 @@ public:
 
     virtual void render(PaintParameters&, RenderSource*) = 0;
 
+    // Checks whether rendering this layer tests against the tile clipping masks in the stencil
+    // buffer. Sources without any such layer don't need clipping masks drawn.
+    virtual bool needsClipping(const PaintParameters&) const { return false; }
+
+    // Checks whether this layer only draws opaque fragments. Drawing the same geometry twice
+    // then doesn't change the result, so tiles that overlap only tiles of the same zoom level
+    // don't need clipping masks for it.
+    bool drawsOnlyOpaque() const { return passes == RenderPass::Opaque; }
+
     // Check wether the given geometry intersects
     // with the feature
     virtual bool queryIntersectsFeature(
@@ -72,6 +84,10 @@ public:
             const float,
             const float) const { return false; };
 
+    // Returns a copy of this layer that a rendered feature query can test features against on
+    // another thread, or null if features of this layer can't be queried that way.
+    virtual std::unique_ptr<RenderLayer> cloneForQuery() const { return nullptr; }
+
     virtual std::unique_ptr<Bucket> createBucket(const BucketParameters&, const std::vector<const RenderLayer*>&) const = 0;
 
     void setRenderTiles(std::vector<std::reference_wrapper<RenderTile>>);
@@ -7,6 +7,7 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/layer_impl.hpp>
+#include <mbgl/style/image_impl.hpp>
 
 #include <unordered_map>
 #include <vector>
@@ -21,10 +22,13 @@ class RenderTile;
 class RenderStyle;
 class RenderLayer;
 class RenderedQueryOptions;
+class RenderedFeatureQuery;
 class SourceQueryOptions;
+class SourceFeatureQuery;
 class Tile;
 class RenderSourceObserver;
 class TileParameters;
+class MemoryReport;
 
 class RenderSource : protected TileObserver {
 public:
@@ -52,6 +56,7 @@ public:
                         const std::vector<Immutable<style::Layer::Impl>>&,
                         bool needsRendering,
                         bool needsRelayout,
+                        const ImageDependencies& changedImages,
                         const TileParameters&) = 0;
 
     virtual void startRender(PaintParameters&) = 0;
@@ -66,13 +71,22 @@ public:
                           const RenderStyle& style,
                           const RenderedQueryOptions& options) const = 0;
 
-    virtual std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const = 0;
+    // Adds the tiles a rendered feature query touches to a snapshot of the query.
+    virtual void snapshotRenderedFeatures(RenderedFeatureQuery&,
+                                          const ScreenLineString& geometry,
+                                          const TransformState& transformState,
+                                          const RenderStyle& style) const = 0;
+
+    // Adds the tiles a source feature query scans to a snapshot of the query.
+    virtual void snapshotSourceFeatures(SourceFeatureQuery&) const = 0;
 
     virtual void onLowMemory() = 0;
 
     virtual void dumpDebugLogs() const = 0;
 
+    // Adds the memory held by this source's tiles to the report.
+    virtual void reportMemory(MemoryReport&) const = 0;
+
     void setObserver(RenderSourceObserver*);
 
     Immutable<style::Source::Impl> baseImpl;
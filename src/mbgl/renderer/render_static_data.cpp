@@ -47,15 +47,16 @@ static gl::VertexVector<ExtrusionTextureLayoutVertex> extrusionTextureVertices()
     return result;
 }
 
-RenderStaticData::RenderStaticData(gl::Context& context, float pixelRatio, const optional<std::string>& programCacheDir)
-    : tileVertexBuffer(context.createVertexBuffer(tileVertices())),
+RenderStaticData::RenderStaticData(gl::Context& context, float pixelRatio_, const optional<std::string>& programCacheDir)
+    : pixelRatio(pixelRatio_),
+      tileVertexBuffer(context.createVertexBuffer(tileVertices())),
       rasterVertexBuffer(context.createVertexBuffer(rasterVertices())),
       extrusionTextureVertexBuffer(context.createVertexBuffer(extrusionTextureVertices())),
       quadTriangleIndexBuffer(context.createIndexBuffer(quadTriangleIndices())),
       tileBorderIndexBuffer(context.createIndexBuffer(tileLineStripIndices())),
-      programs(context, ProgramParameters { pixelRatio, false, programCacheDir })
+      programs(context, ProgramParameters { pixelRatio_, false, programCacheDir })
 #ifndef NDEBUG
-    , overdrawPrograms(context, ProgramParameters { pixelRatio, true, programCacheDir })
+    , overdrawPrograms(context, ProgramParameters { pixelRatio_, true, programCacheDir })
 #endif
 {
     tileTriangleSegments.emplace_back(0, 0, 4, 6);
@@ -19,6 +19,8 @@
 #include <mbgl/renderer/style_diff.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/rendered_feature_query.hpp>
+#include <mbgl/renderer/memory_report.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
@@ -107,7 +109,8 @@ void RenderStyle::update(const UpdateParameters& parameters) {
         parameters.annotationManager,
         *imageManager,
         *glyphManager,
-        parameters.prefetchZoomDelta
+        parameters.prefetchZoomDelta,
+        tileTracer
     };
 
     glyphManager->setURL(parameters.glyphURL);
@@ -143,6 +146,18 @@ void RenderStyle::update(const UpdateParameters& parameters) {
         imageManager->updateImage(entry.second.after);
     }
 
+    // Only tiles whose layout referenced one of these images need to be laid out again.
+    ImageDependencies changedImages;
+    for (const auto& entry : imageDiff.removed) {
+        changedImages.insert(entry.first);
+    }
+    for (const auto& entry : imageDiff.added) {
+        changedImages.insert(entry.first);
+    }
+    for (const auto& entry : imageDiff.changed) {
+        changedImages.insert(entry.first);
+    }
+
     imageManager->setLoaded(parameters.spriteLoaded);
 
 
@@ -195,38 +210,43 @@ void RenderStyle::update(const UpdateParameters& parameters) {
         renderSources.emplace(entry.first, std::move(renderSource));
     }
 
-    // Update all sources.
-    for (const auto& source : *sourceImpls) {
-        std::vector<Immutable<Layer::Impl>> filteredLayers;
+    // Group layers by source in a single pass, rather than scanning every layer for each source.
+    struct SourceLayers {
+        std::vector<Immutable<Layer::Impl>> layers;
         bool needsRendering = false;
         bool needsRelayout = false;
+    };
 
-        for (const auto& layer : *layerImpls) {
-            if (layer->type == LayerType::Background ||
-                layer->type == LayerType::Custom ||
-                layer->source != source->id) {
-                continue;
-            }
+    std::unordered_map<std::string, SourceLayers> layersBySource;
 
-            if (!needsRendering && getRenderLayer(layer->id)->needsRendering(zoomHistory.lastZoom)) {
-                needsRendering = true;
-            }
+    for (const auto& layer : *layerImpls) {
+        if (layer->type == LayerType::Background ||
+            layer->type == LayerType::Custom) {
+            continue;
+        }
 
-            if (!needsRelayout && (
-                hasLayoutDifference(layerDiff, layer->id) ||
-                !imageDiff.added.empty() ||
-                !imageDiff.removed.empty() ||
-                !imageDiff.changed.empty())) {
-                needsRelayout = true;
-            }
+        SourceLayers& entry = layersBySource[layer->source];
+
+        if (!entry.needsRendering && getRenderLayer(layer->id)->needsRendering(zoomHistory.lastZoom)) {
+            entry.needsRendering = true;
+        }
 
-            filteredLayers.push_back(layer);
+        if (!entry.needsRelayout && hasLayoutDifference(layerDiff, layer->id)) {
+            entry.needsRelayout = true;
         }
 
+        entry.layers.push_back(layer);
+    }
+
+    // Update all sources.
+    for (const auto& source : *sourceImpls) {
+        const SourceLayers& entry = layersBySource[source->id];
+
         renderSources.at(source->id)->update(source,
-                                             filteredLayers,
-                                             needsRendering,
-                                             needsRelayout,
+                                             entry.layers,
+                                             entry.needsRendering,
+                                             entry.needsRelayout,
+                                             changedImages,
                                              tileParameters);
     }
 }
@@ -375,24 +395,9 @@ std::vector<Feature> RenderStyle::queryRenderedFeatures(const ScreenLineString&
                                                   const RenderedQueryOptions& options) const {
     std::unordered_map<std::string, std::vector<Feature>> resultsByLayer;
 
-    if (options.layerIDs) {
-        std::unordered_set<std::string> sourceIDs;
-        for (const auto& layerID : *options.layerIDs) {
-            if (const RenderLayer* layer = getRenderLayer(layerID)) {
-                sourceIDs.emplace(layer->baseImpl->source);
-            }
-        }
-        for (const auto& sourceID : sourceIDs) {
-            if (RenderSource* renderSource = getRenderSource(sourceID)) {
-                auto sourceResults = renderSource->queryRenderedFeatures(geometry, transformState, *this, options);
-                std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
-            }
-        }
-    } else {
-        for (const auto& entry : renderSources) {
-            auto sourceResults = entry.second->queryRenderedFeatures(geometry, transformState, *this, options);
-            std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
-        }
+    for (const RenderSource* renderSource : getQueriedSources(options)) {
+        auto sourceResults = renderSource->queryRenderedFeatures(geometry, transformState, *this, options);
+        std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
     }
 
     std::vector<Feature> result;
@@ -416,6 +421,54 @@ std::vector<Feature> RenderStyle::queryRenderedFeatures(const ScreenLineString&
     return result;
 }
 
+void RenderStyle::snapshotRenderedFeatures(RenderedFeatureQuery& query,
+                                           const ScreenLineString& geometry,
+                                           const TransformState& transformState) const {
+    // Only layers that are rendered end up in the results, see queryRenderedFeatures().
+    for (const auto& layerImpl : *layerImpls) {
+        const RenderLayer* layer = getRenderLayer(layerImpl->id);
+        if (!layer->needsRendering(zoomHistory.lastZoom)) {
+            continue;
+        }
+        const auto& layerIDs = query.options.layerIDs;
+        if (layerIDs && std::find(layerIDs->begin(), layerIDs->end(), layer->getID()) == layerIDs->end()) {
+            continue;
+        }
+        if (auto clone = layer->cloneForQuery()) {
+            query.layerOrder.push_back(layer->getID());
+            query.layers.emplace(layer->getID(), std::move(clone));
+        }
+    }
+
+    for (const RenderSource* renderSource : getQueriedSources(query.options)) {
+        renderSource->snapshotRenderedFeatures(query, geometry, transformState, *this);
+    }
+}
+
+std::vector<const RenderSource*> RenderStyle::getQueriedSources(const RenderedQueryOptions& options) const {
+    std::vector<const RenderSource*> result;
+
+    if (options.layerIDs) {
+        std::unordered_set<std::string> sourceIDs;
+        for (const auto& layerID : *options.layerIDs) {
+            if (const RenderLayer* layer = getRenderLayer(layerID)) {
+                sourceIDs.emplace(layer->baseImpl->source);
+            }
+        }
+        for (const auto& sourceID : sourceIDs) {
+            if (RenderSource* renderSource = getRenderSource(sourceID)) {
+                result.push_back(renderSource);
+            }
+        }
+    } else {
+        for (const auto& entry : renderSources) {
+            result.push_back(entry.second.get());
+        }
+    }
+
+    return result;
+}
+
 void RenderStyle::onLowMemory() {
     for (const auto& entry : renderSources) {
         entry.second->onLowMemory();
@@ -446,4 +499,13 @@ void RenderStyle::dumpDebugLogs() const {
     imageManager->dumpDebugLogs();
 }
 
+void RenderStyle::reportMemory(MemoryReport& report) const {
+    for (const auto& entry : renderSources) {
+        entry.second->reportMemory(report);
+    }
+
+    imageManager->reportMemory(report);
+    report.add("", "", MemoryCategory::Glyphs, glyphManager->byteSize());
+}
+
 } // namespace mbgl
@@ -5,6 +5,7 @@
 #include <mbgl/renderer/render_source_observer.hpp>
 #include <mbgl/renderer/render_layer.hpp>
 #include <mbgl/renderer/render_light.hpp>
+#include <mbgl/tile/tile_trace.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/map/zoom_history.hpp>
 #include <mbgl/map/mode.hpp>
@@ -22,9 +23,11 @@ class LineAtlas;
 class RenderData;
 class TransformState;
 class RenderedQueryOptions;
+class RenderedFeatureQuery;
 class Scheduler;
 class UpdateParameters;
 class RenderStyleObserver;
+class MemoryReport;
 
 namespace style {
 class Image;
@@ -59,9 +62,16 @@ public:
                                                const TransformState& transformState,
                                                const RenderedQueryOptions& options) const;
 
+    // Fills a query with copies of the queried layers and tiles, so that it can run on
+    // another thread.
+    void snapshotRenderedFeatures(RenderedFeatureQuery&,
+                                  const ScreenLineString& geometry,
+                                  const TransformState& transformState) const;
+
     void onLowMemory();
 
     void dumpDebugLogs() const;
+    void reportMemory(MemoryReport&) const;
 
     Scheduler& scheduler;
     FileSource& fileSource;
@@ -69,6 +79,9 @@ public:
     std::unique_ptr<ImageManager> imageManager;
     std::unique_ptr<LineAtlas> lineAtlas;
 
+    // Must outlive the tiles of render sources, which record into it from their workers.
+    TileTracer tileTracer;
+
 private:
     Immutable<std::vector<Immutable<style::Image::Impl>>> imageImpls;
     Immutable<std::vector<Immutable<style::Source::Impl>>> sourceImpls;
@@ -85,6 +98,9 @@ private:
     void onTileChanged(RenderSource&, const OverscaledTileID&) override;
     void onTileError(RenderSource&, const OverscaledTileID&, std::exception_ptr) override;
 
+    // The sources of the layers a query names, or all sources if it doesn't name any.
+    std::vector<const RenderSource*> getQueriedSources(const RenderedQueryOptions&) const;
+
     RenderStyleObserver* observer;
     ZoomHistory zoomHistory;
 };
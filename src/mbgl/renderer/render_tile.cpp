@@ -5,7 +5,9 @@
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/util/enum.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/string.hpp>
 
 namespace mbgl {
 
@@ -67,6 +69,35 @@ void RenderTile::startRender(PaintParameters& parameters) {
     matrix::multiply(nearClippedMatrix, parameters.nearClippedProjMatrix, nearClippedMatrix);
 }
 
+// The most recent duration of each stage the tile went through, three stages per line.
+static std::vector<std::string> timingsText(const TileTrace& trace) {
+    std::vector<std::string> lines;
+    std::string line;
+    std::size_t stages = 0;
+
+    for (std::size_t i = 0; i < TileTimings::stageCount; i++) {
+        const auto stage = TileStage(i);
+        const optional<Duration> duration = trace.getLastDuration(stage);
+        if (!duration) {
+            continue;
+        }
+
+        if (stages++ % 3 == 0 && !line.empty()) {
+            lines.push_back(std::move(line));
+            line.clear();
+        } else if (!line.empty()) {
+            line += ", ";
+        }
+        line += Enum<TileStage>::toString(stage);
+        line += " " + util::toString(std::chrono::duration_cast<Milliseconds>(*duration).count()) + "ms";
+    }
+
+    if (!line.empty()) {
+        lines.push_back(std::move(line));
+    }
+    return lines;
+}
+
 void RenderTile::finishRender(PaintParameters& parameters) {
     if (!used || parameters.debugOptions == MapDebugOptions::NoDebug)
         return;
@@ -74,15 +105,21 @@ void RenderTile::finishRender(PaintParameters& parameters) {
     static const style::Properties<>::PossiblyEvaluated properties {};
     static const DebugProgram::PaintPropertyBinders paintAttibuteData(properties, 0);
 
-    if (parameters.debugOptions & (MapDebugOptions::Timestamps | MapDebugOptions::ParseStatus)) {
+    if (parameters.debugOptions & (MapDebugOptions::Timestamps | MapDebugOptions::ParseStatus | MapDebugOptions::TileTimings)) {
+        std::vector<std::string> timings;
+        if (parameters.debugOptions & MapDebugOptions::TileTimings) {
+            timings = timingsText(tile.trace);
+        }
+
         if (!tile.debugBucket || tile.debugBucket->renderable != tile.isRenderable() ||
             tile.debugBucket->complete != tile.isComplete() ||
             !(tile.debugBucket->modified == tile.modified) ||
             !(tile.debugBucket->expires == tile.expires) ||
+            tile.debugBucket->timings != timings ||
             tile.debugBucket->debugMode != parameters.debugOptions) {
             tile.debugBucket = std::make_unique<DebugBucket>(
                 tile.id, tile.isRenderable(), tile.isComplete(), tile.modified,
-                tile.expires, parameters.debugOptions, parameters.context);
+                tile.expires, std::move(timings), parameters.debugOptions, parameters.context);
         }
 
         parameters.programs.debug.draw(
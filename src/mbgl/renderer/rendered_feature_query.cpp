@@ -0,0 +1,74 @@
+#include <mbgl/renderer/rendered_feature_query.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/text/collision_tile.hpp>
+
+#include <cassert>
+#include <iterator>
+
+namespace mbgl {
+
+RenderedFeatureQuery::RenderedFeatureQuery(RenderedQueryOptions options_)
+    : options(std::move(options_)) {
+}
+
+RenderedFeatureQuery::~RenderedFeatureQuery() = default;
+
+RenderedFeatureQuery::Result RenderedFeatureQuery::queryTile(std::size_t index) const {
+    assert(index < tiles.size());
+    const Tile& tile = tiles[index];
+
+    Result result;
+    tile.featureIndex->query(result,
+                             tile.queryGeometry,
+                             tile.bearing,
+                             tile.tileSize,
+                             tile.scale,
+                             options,
+                             *tile.data,
+                             tile.id,
+                             [&] (const std::string& layerID) -> const RenderLayer* {
+                                 auto it = layers.find(layerID);
+                                 return it == layers.end() ? nullptr : it->second.get();
+                             },
+                             tile.collisionTile.get(),
+                             tile.additionalRadius);
+    return result;
+}
+
+RenderedFeatureQuery::FeatureResult RenderedFeatureQuery::toFeatures(const Result& handles) const {
+    FeatureResult result;
+    for (const auto& layer : handles) {
+        auto& features = result[layer.first];
+        features.reserve(layer.second.size());
+        for (const auto& handle : layer.second) {
+            features.push_back(handle.toFeature(options.properties, options.includeGeometry));
+        }
+    }
+    return result;
+}
+
+template <class T>
+static std::vector<T> mergeByLayer(const std::vector<std::string>& layerOrder,
+                                   std::vector<std::unordered_map<std::string, std::vector<T>>> results) {
+    std::vector<T> result;
+    for (const auto& layerID : layerOrder) {
+        for (auto& tileResult : results) {
+            auto it = tileResult.find(layerID);
+            if (it != tileResult.end()) {
+                std::move(it->second.begin(), it->second.end(), std::back_inserter(result));
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<FeatureHandle> RenderedFeatureQuery::merge(std::vector<Result> results) const {
+    return mergeByLayer(layerOrder, std::move(results));
+}
+
+std::vector<Feature> RenderedFeatureQuery::merge(std::vector<FeatureResult> results) const {
+    return mergeByLayer(layerOrder, std::move(results));
+}
+
+} // namespace mbgl
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <mbgl/renderer/feature_handle.hpp>
+#include <mbgl/renderer/query.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+class CollisionTile;
+class FeatureIndex;
+class RenderLayer;
+
+// A copy of everything a rendered feature query reads from the current frame: the feature
+// indexes and data of the queried tiles and the evaluated properties of the queried layers.
+// None of it is touched by rendering, so the tiles can be queried on other threads.
+class RenderedFeatureQuery {
+public:
+    // The features found in a tile, by layer ID.
+    using Result = std::unordered_map<std::string, std::vector<FeatureHandle>>;
+    using FeatureResult = std::unordered_map<std::string, std::vector<Feature>>;
+
+    class Tile {
+    public:
+        std::shared_ptr<const FeatureIndex> featureIndex;
+        std::unique_ptr<const GeometryTileData> data;
+        std::shared_ptr<const CollisionTile> collisionTile;
+        CanonicalTileID id;
+        GeometryCoordinates queryGeometry;
+        float bearing;
+        double tileSize;
+        double scale;
+        int16_t additionalRadius;
+    };
+
+    explicit RenderedFeatureQuery(RenderedQueryOptions);
+    ~RenderedFeatureQuery();
+
+    // Queries the tile at the given index. Safe to call from any thread, and concurrently
+    // for different tiles.
+    Result queryTile(std::size_t index) const;
+
+    // Converts the features of a tile result, copying only the properties and geometries
+    // the options ask for.
+    FeatureResult toFeatures(const Result&) const;
+
+    // Combines the results of all tiles, in tile order, into a list sorted by layer order.
+    std::vector<FeatureHandle> merge(std::vector<Result>) const;
+    std::vector<Feature> merge(std::vector<FeatureResult>) const;
+
+    const RenderedQueryOptions options;
+
+    // Copies of the queried layers, and their IDs in style order.
+    std::unordered_map<std::string, std::unique_ptr<const RenderLayer>> layers;
+    std::vector<std::string> layerOrder;
+
+    std::vector<Tile> tiles;
+};
+
+} // namespace mbgl
@@ -1,5 +1,6 @@
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/renderer/renderer_impl.hpp>
+#include <mbgl/renderer/render_style.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 
@@ -33,22 +34,50 @@ std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenCoordinate& poi
     return impl->queryRenderedFeatures({ point }, options);
 }
 
+static ScreenLineString toLineString(const ScreenBox& box) {
+    return {
+        box.min,
+        {box.max.x, box.min.y},
+        box.max,
+        {box.min.x, box.max.y},
+        box.min
+    };
+}
+
 std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options) const {
-    return impl->queryRenderedFeatures(
-            {
-                    box.min,
-                    {box.max.x, box.min.y},
-                    box.max,
-                    {box.min.x, box.max.y},
-                    box.min
-            },
-            options
-    );
+    return impl->queryRenderedFeatures(toLineString(box), options);
+}
+
+void Renderer::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options, QueryCallback callback) {
+    impl->queryRenderedFeatures(geometry, options, std::move(callback));
+}
+
+void Renderer::queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions& options, QueryCallback callback) {
+    impl->queryRenderedFeatures({ point }, options, std::move(callback));
+}
+
+void Renderer::queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options, QueryCallback callback) {
+    impl->queryRenderedFeatures(toLineString(box), options, std::move(callback));
+}
+
+std::vector<FeatureHandle> Renderer::queryRenderedFeatureHandles(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+    return impl->queryRenderedFeatureHandles(geometry, options);
+}
+
+std::vector<FeatureHandle> Renderer::queryRenderedFeatureHandles(const ScreenCoordinate& point, const RenderedQueryOptions& options) const {
+    return impl->queryRenderedFeatureHandles({ point }, options);
+}
+
+std::vector<FeatureHandle> Renderer::queryRenderedFeatureHandles(const ScreenBox& box, const RenderedQueryOptions& options) const {
+    return impl->queryRenderedFeatureHandles(toLineString(box), options);
 }
 
 AnnotationIDs Renderer::queryPointAnnotations(const ScreenBox& box) const {
     RenderedQueryOptions options;
     options.layerIDs = {{ AnnotationManager::PointLayerID }};
+    // Only the ids are needed.
+    options.properties = std::vector<std::string>();
+    options.includeGeometry = false;
     auto features = queryRenderedFeatures(box, options);
     std::set<AnnotationID> set;
     for (auto &feature : features) {
@@ -67,6 +96,26 @@ std::vector<Feature> Renderer::querySourceFeatures(const std::string& sourceID,
     return impl->querySourceFeatures(sourceID, options);
 }
 
+std::vector<FeatureHandle> Renderer::querySourceFeatureHandles(const std::string& sourceID, const SourceQueryOptions& options) const {
+    return impl->querySourceFeatureHandles(sourceID, options);
+}
+
+void Renderer::setFrameProfiling(FrameProfileCallback callback) {
+    impl->frameProfileCallback = std::move(callback);
+}
+
+void Renderer::setTileTracing(bool enabled) {
+    impl->tileTracing = enabled;
+}
+
+MemoryReport Renderer::getMemoryReport() const {
+    return impl->getMemoryReport();
+}
+
+TileTimings Renderer::getTileTimings() const {
+    return impl->renderStyle->tileTracer.getTimings();
+}
+
 void Renderer::dumpDebugLogs() {
     impl->dumDebugLogs();
 }
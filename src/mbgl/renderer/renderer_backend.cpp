@@ -1,5 +1,6 @@
 #include <mbgl/renderer/renderer_backend.hpp>
 #include <mbgl/renderer/backend_scope.hpp>
+#include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/extension.hpp>
 #include <mbgl/gl/debugging.hpp>
@@ -21,6 +22,15 @@ gl::Context& RendererBackend::getContext() {
     return *context;
 }
 
+std::shared_ptr<RenderStaticData> RendererBackend::getStaticData(float pixelRatio, const optional<std::string>& programCacheDir) {
+    auto result = staticData.lock();
+    if (!result || result->pixelRatio != pixelRatio) {
+        result = std::make_shared<RenderStaticData>(getContext(), pixelRatio, programCacheDir);
+        staticData = result;
+    }
+    return result;
+}
+
 PremultipliedImage RendererBackend::readFramebuffer(const Size& size) const {
     assert(context);
     return context->readFramebuffer<PremultipliedImage>(size);
@@ -2,12 +2,20 @@
 #include <mbgl/renderer/render_style.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_item.hpp>
+#include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/render_source.hpp>
+#include <mbgl/renderer/source_feature_query.hpp>
+#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/renderer/backend_scope.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/gl/debugging.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/scheduler.hpp>
+
+#include <algorithm>
 
 namespace mbgl {
 
@@ -18,6 +26,29 @@ static RendererObserver& nullObserver() {
     return observer;
 }
 
+// Queries the tiles of feature queries in parallel.
+class Renderer::Impl::QueryWorker {
+public:
+    void queryRenderedFeatures(ActorRef<Renderer::Impl> parent,
+                               uint64_t queryID,
+                               std::shared_ptr<const RenderedFeatureQuery> query,
+                               std::size_t tileIndex) {
+        parent.invoke(&Renderer::Impl::onTileQueried, queryID, tileIndex, query->toFeatures(query->queryTile(tileIndex)));
+    }
+
+    RenderedFeatureQuery::Result queryRenderedFeatureHandles(std::shared_ptr<const RenderedFeatureQuery> query, std::size_t tileIndex) {
+        return query->queryTile(tileIndex);
+    }
+
+    std::vector<Feature> querySourceFeatures(std::shared_ptr<const SourceFeatureQuery> query, std::size_t tileIndex) {
+        return query->toFeatures(query->queryTile(tileIndex));
+    }
+
+    std::vector<FeatureHandle> querySourceFeatureHandles(std::shared_ptr<const SourceFeatureQuery> query, std::size_t tileIndex) {
+        return query->queryTile(tileIndex);
+    }
+};
+
 Renderer::Impl::Impl(RendererBackend& backend_,
                      float pixelRatio_,
                      FileSource& fileSource_,
@@ -32,10 +63,23 @@ Renderer::Impl::Impl(RendererBackend& backend_,
         , renderStyle(std::make_unique<RenderStyle>(scheduler_, fileSource_)) {
 
     renderStyle->setObserver(this);
+
+    // Each worker scans one tile at a time, so the scheduler can't run more than this many at once.
+    for (std::size_t i = 0; i < scheduler_.concurrency(); i++) {
+        queryWorkers.push_back(std::make_unique<Actor<QueryWorker>>(scheduler_));
+    }
 }
 
 Renderer::Impl::~Impl() {
+    // Drop the results of pending queries, and wait for the workers to finish the tiles
+    // they're querying.
+    if (mailbox) {
+        mailbox->close();
+    }
+    queryWorkers.clear();
+
     BackendScope guard { backend };
+    frameProfiler.reset();
     renderStyle.reset();
     staticData.reset();
 };
@@ -50,11 +94,20 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
     
     assert(BackendScope::exists());
 
+    renderStyle->tileTracer.setEnabled(tileTracing || (updateParameters.debugOptions & MapDebugOptions::TileTimings));
     renderStyle->update(updateParameters);
     transformState = updateParameters.transformState;
 
     if (!staticData) {
-        staticData = std::make_unique<RenderStaticData>(backend.getContext(), pixelRatio, programCacheDir);
+        staticData = backend.getStaticData(pixelRatio, programCacheDir);
+    }
+
+    if (!frameProfileCallback) {
+        frameProfiler.reset();
+    } else if (!frameProfiler) {
+        frameProfiler = std::make_unique<FrameProfiler>(backend.getContext().getTimerQueryExtension(), [this] (FrameProfile profile) {
+            frameProfileCallback(profile);
+        }, &backend.getContext().getDrawCalls());
     }
 
     PaintParameters parameters {
@@ -79,7 +132,13 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
 
         backend.updateAssumedState();
 
+        if (frameProfiler) {
+            frameProfiler->beginFrame();
+        }
         doRender(parameters);
+        if (frameProfiler) {
+            frameProfiler->endFrame();
+        }
         parameters.context.performCleanup();
 
         observer->onDidFinishRenderingFrame(
@@ -99,7 +158,13 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
 
         backend.updateAssumedState();
 
+        if (frameProfiler) {
+            frameProfiler->beginFrame();
+        }
         doRender(parameters);
+        if (frameProfiler) {
+            frameProfiler->endFrame();
+        }
 
         observer->onDidFinishRenderingFrame(RendererObserver::RenderMode::Full, false);
         observer->onDidFinishRenderingMap();
@@ -107,6 +172,9 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         // Cleanup only after signaling completion
         parameters.context.performCleanup();
     }
+
+    gpuBufferBytes = parameters.context.getBufferBytes();
+    gpuTextureBytes = parameters.context.getTextureBytes();
 }
 
 void Renderer::Impl::doRender(PaintParameters& parameters) {
@@ -126,6 +194,7 @@ void Renderer::Impl::doRender(PaintParameters& parameters) {
     // Uploads all required buffers and images before we do any actual rendering.
     {
         MBGL_DEBUG_GROUP(parameters.context, "upload");
+        const FrameProfiler::Scope profile(frameProfiler.get(), FrameProfile::Category::Pass, "upload", true);
 
         parameters.imageManager.upload(parameters.context, 0);
         parameters.lineAtlas.upload(parameters.context, 0);
@@ -137,6 +206,7 @@ void Renderer::Impl::doRender(PaintParameters& parameters) {
     // tiles whatsoever.
     {
         MBGL_DEBUG_GROUP(parameters.context, "clear");
+        const FrameProfiler::Scope profile(frameProfiler.get(), FrameProfile::Category::Pass, "clear", true);
         parameters.backend.bind();
         parameters.context.clear((parameters.debugOptions & MapDebugOptions::Overdraw)
                         ? Color::black()
@@ -149,18 +219,57 @@ void Renderer::Impl::doRender(PaintParameters& parameters) {
     // Draws the clipping masks to the stencil buffer.
     {
         MBGL_DEBUG_GROUP(parameters.context, "clip");
+        const FrameProfiler::Scope profile(frameProfiler.get(), FrameProfile::Category::Pass, "clip");
+
+        // Only sources with layers that are clipped by the stencil buffer need clipping masks.
+        // When debugging, the tile overlays of every source are drawn clipped, too. Sources whose
+        // clipped layers only draw opaque fragments need masks only on tiles overlapping tiles
+        // of another zoom level; the other tiles are drawn without testing the stencil buffer.
+        const bool debugging = parameters.debugOptions != MapDebugOptions::NoDebug;
+        std::unordered_map<RenderSource*, bool> clippedSources; // Whether every tile needs a mask.
+        for (const auto& item : order) {
+            if (item.source && (debugging || item.layer.needsClipping(parameters))) {
+                bool& everyTile = clippedSources[item.source];
+                everyTile = everyTile || debugging || !item.layer.drawsOnlyOpaque();
+            }
+        }
+
+        algorithm::ClipIDCache::Groups<RenderTile> clippedTiles;
+        for (const auto& source : sources) {
+            auto it = clippedSources.find(source);
+            if (it == clippedSources.end()) {
+                continue;
+            }
+            auto tiles = source->getRenderTiles();
+            if (!it->second) {
+                for (auto& tile : tiles) {
+                    tile.get().clip = {};
+                }
+                tiles = algorithm::overlappingOtherZoomLevels(tiles);
+            }
+            clippedTiles.push_back(std::move(tiles));
+        }
+
+        // Update all clipping IDs, unless the clipped tiles are the same as in the previous frame.
+        if (!clipIDCache.restore(clippedTiles)) {
+            for (const auto& tiles : clippedTiles) {
+                parameters.clipIDGenerator.update(tiles);
+            }
+            clipIDCache.store(clippedTiles, parameters.clipIDGenerator.getClipIDs());
+        }
 
-        // Update all clipping IDs.
         for (const auto& source : sources) {
+            const FrameProfiler::Scope sourceProfile(frameProfiler.get(), FrameProfile::Category::Source, source->baseImpl->id, true);
             source->startRender(parameters);
         }
 
         MBGL_DEBUG_GROUP(parameters.context, "clipping masks");
+        const FrameProfiler::Scope masksProfile(frameProfiler.get(), FrameProfile::Category::Pass, "clipping masks", true);
 
         static const style::FillPaintProperties::PossiblyEvaluated properties {};
         static const FillProgram::PaintPropertyBinders paintAttibuteData(properties, 0);
 
-        for (const auto& clipID : parameters.clipIDGenerator.getClipIDs()) {
+        for (const auto& clipID : clipIDCache.getClipIDs()) {
             parameters.staticData.programs.fill.get(properties).draw(
                 parameters.context,
                 gl::Triangles(),
@@ -232,6 +341,7 @@ void Renderer::Impl::doRender(PaintParameters& parameters) {
     {
         parameters.pass = RenderPass::Opaque;
         MBGL_DEBUG_GROUP(parameters.context, "opaque");
+        const FrameProfiler::Scope profile(frameProfiler.get(), FrameProfile::Category::Pass, "opaque");
 
         if (debug::renderTree) {
             Log::Info(Event::Render, "%*s%s {", indent++ * 4, "", "opaque");
@@ -242,6 +352,7 @@ void Renderer::Impl::doRender(PaintParameters& parameters) {
             parameters.currentLayer = i;
             if (it->layer.hasRenderPass(parameters.pass)) {
                 MBGL_DEBUG_GROUP(parameters.context, it->layer.getID());
+                const FrameProfiler::Scope layerProfile(frameProfiler.get(), FrameProfile::Category::Layer, it->layer.getID(), true);
                 it->layer.render(parameters, it->source);
             }
         }
@@ -256,6 +367,7 @@ void Renderer::Impl::doRender(PaintParameters& parameters) {
     {
         parameters.pass = RenderPass::Translucent;
         MBGL_DEBUG_GROUP(parameters.context, "translucent");
+        const FrameProfiler::Scope profile(frameProfiler.get(), FrameProfile::Category::Pass, "translucent");
 
         if (debug::renderTree) {
             Log::Info(Event::Render, "%*s%s {", indent++ * 4, "", "translucent");
@@ -266,6 +378,7 @@ void Renderer::Impl::doRender(PaintParameters& parameters) {
             parameters.currentLayer = i;
             if (it->layer.hasRenderPass(parameters.pass)) {
                 MBGL_DEBUG_GROUP(parameters.context, it->layer.getID());
+                const FrameProfiler::Scope layerProfile(frameProfiler.get(), FrameProfile::Category::Layer, it->layer.getID(), true);
                 it->layer.render(parameters, it->source);
             }
         }
@@ -281,12 +394,14 @@ void Renderer::Impl::doRender(PaintParameters& parameters) {
     // Renders debug overlays.
     {
         MBGL_DEBUG_GROUP(parameters.context, "debug");
+        const FrameProfiler::Scope profile(frameProfiler.get(), FrameProfile::Category::Pass, "debug");
 
         // Finalize the rendering, e.g. by calling debug render calls per tile.
         // This guarantees that we have at least one function per tile called.
         // When only rendering layers via the stylesheet, it's possible that we don't
         // ever visit a tile during rendering.
         for (const auto& source : sources) {
+            const FrameProfiler::Scope sourceProfile(frameProfiler.get(), FrameProfile::Category::Source, source->baseImpl->id, true);
             source->finishRender(parameters);
         }
     }
@@ -332,11 +447,113 @@ std::vector<Feature> Renderer::Impl::queryRenderedFeatures(const ScreenLineStrin
     return renderStyle->queryRenderedFeatures(geometry, transformState, options);
 }
 
+void Renderer::Impl::queryRenderedFeatures(const ScreenLineString& geometry,
+                                           const RenderedQueryOptions& options,
+                                           QueryCallback callback) {
+    if (!mailbox) {
+        assert(Scheduler::GetCurrent());
+        mailbox = std::make_shared<Mailbox>(*Scheduler::GetCurrent());
+    }
+
+    auto query = std::make_shared<RenderedFeatureQuery>(options);
+    renderStyle->snapshotRenderedFeatures(*query, geometry, transformState);
+
+    const uint64_t queryID = nextQueryID++;
+    const std::size_t tileCount = query->tiles.size();
+    pendingQueries.emplace(queryID, PendingQuery {
+        query, std::vector<RenderedFeatureQuery::FeatureResult>(tileCount), tileCount, std::move(callback)
+    });
+
+    if (tileCount == 0) {
+        // Still answer asynchronously, so that callers see the same behavior for every query.
+        ActorRef<Renderer::Impl>(*this, mailbox).invoke(&Renderer::Impl::finishQuery, queryID);
+        return;
+    }
+
+    // Spread the tiles over the workers, so that they're queried in parallel.
+    for (std::size_t i = 0; i < tileCount; i++) {
+        queryWorkers[nextQueryWorker]->invoke(&QueryWorker::queryRenderedFeatures,
+                                              ActorRef<Renderer::Impl>(*this, mailbox), queryID, query, i);
+        nextQueryWorker = (nextQueryWorker + 1) % queryWorkers.size();
+    }
+}
+
+void Renderer::Impl::onTileQueried(uint64_t queryID, std::size_t tileIndex, RenderedFeatureQuery::FeatureResult result) {
+    auto it = pendingQueries.find(queryID);
+    assert(it != pendingQueries.end());
+    it->second.results[tileIndex] = std::move(result);
+    if (--it->second.remainingTiles == 0) {
+        finishQuery(queryID);
+    }
+}
+
+void Renderer::Impl::finishQuery(uint64_t queryID) {
+    auto it = pendingQueries.find(queryID);
+    assert(it != pendingQueries.end());
+
+    // Erase the query before calling back, which may start another query.
+    PendingQuery pending = std::move(it->second);
+    pendingQueries.erase(it);
+    pending.callback(pending.query->merge(std::move(pending.results)));
+}
+
+std::vector<FeatureHandle> Renderer::Impl::queryRenderedFeatureHandles(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
+    auto query = std::make_shared<RenderedFeatureQuery>(options);
+    renderStyle->snapshotRenderedFeatures(*query, geometry, transformState);
+
+    // Query the tiles in parallel, and wait for the results.
+    std::vector<std::future<RenderedFeatureQuery::Result>> futures;
+    for (std::size_t i = 0; i < query->tiles.size(); i++) {
+        futures.push_back(queryWorkers[i % queryWorkers.size()]->ask(&QueryWorker::queryRenderedFeatureHandles, query, i));
+    }
+
+    std::vector<RenderedFeatureQuery::Result> results;
+    for (auto& future : futures) {
+        results.push_back(future.get());
+    }
+
+    return query->merge(std::move(results));
+}
+
 std::vector<Feature> Renderer::Impl::querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options) const {
     const RenderSource* source = renderStyle->getRenderSource(sourceID);
     if (!source) return {};
 
-    return source->querySourceFeatures(options);
+    auto query = std::make_shared<SourceFeatureQuery>(options);
+    source->snapshotSourceFeatures(*query);
+
+    // Scan the tiles in parallel, and wait for the results.
+    std::vector<std::future<std::vector<Feature>>> futures;
+    for (std::size_t i = 0; i < query->tiles.size(); i++) {
+        futures.push_back(queryWorkers[i % queryWorkers.size()]->ask(&QueryWorker::querySourceFeatures, query, i));
+    }
+
+    std::vector<std::vector<Feature>> results;
+    for (auto& future : futures) {
+        results.push_back(future.get());
+    }
+
+    return query->merge(std::move(results));
+}
+
+std::vector<FeatureHandle> Renderer::Impl::querySourceFeatureHandles(const std::string& sourceID, const SourceQueryOptions& options) const {
+    const RenderSource* source = renderStyle->getRenderSource(sourceID);
+    if (!source) return {};
+
+    auto query = std::make_shared<SourceFeatureQuery>(options);
+    source->snapshotSourceFeatures(*query);
+
+    std::vector<std::future<std::vector<FeatureHandle>>> futures;
+    for (std::size_t i = 0; i < query->tiles.size(); i++) {
+        futures.push_back(queryWorkers[i % queryWorkers.size()]->ask(&QueryWorker::querySourceFeatureHandles, query, i));
+    }
+
+    std::vector<std::vector<FeatureHandle>> results;
+    for (auto& future : futures) {
+        results.push_back(future.get());
+    }
+
+    return query->merge(std::move(results));
 }
 
 void Renderer::Impl::onInvalidate() {
@@ -354,6 +571,14 @@ void Renderer::Impl::onLowMemory() {
     observer->onInvalidate();
 }
 
+MemoryReport Renderer::Impl::getMemoryReport() const {
+    MemoryReport report;
+    renderStyle->reportMemory(report);
+    report.add("", "", MemoryCategory::GPUBuffers, gpuBufferBytes);
+    report.add("", "", MemoryCategory::GPUTextures, gpuTextureBytes);
+    return report;
+}
+
 void Renderer::Impl::dumDebugLogs() {
     renderStyle->dumpDebugLogs();
 }
@@ -5,14 +5,21 @@
 #include <mbgl/renderer/renderer_observer.hpp>
 #include <mbgl/renderer/render_style_observer.hpp>
 #include <mbgl/renderer/frame_history.hpp>
+#include <mbgl/renderer/frame_profiler.hpp>
+#include <mbgl/renderer/rendered_feature_query.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/algorithm/generate_clip_ids.hpp>
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace mbgl {
 
+template <class> class Actor;
+class Mailbox;
 class UpdateParameters;
 class PaintParameters;
 class RenderStyle;
@@ -29,9 +36,13 @@ public:
     void render(const UpdateParameters&);
 
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&) const;
+    void queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&, QueryCallback);
+    std::vector<FeatureHandle> queryRenderedFeatureHandles(const ScreenLineString&, const RenderedQueryOptions&) const;
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&) const;
+    std::vector<FeatureHandle> querySourceFeatureHandles(const std::string& sourceID, const SourceQueryOptions&) const;
 
     void onLowMemory();
+    MemoryReport getMemoryReport() const;
     void dumDebugLogs();
 
     // RenderStyleObserver implementation
@@ -41,6 +52,10 @@ public:
 private:
     void doRender(PaintParameters&);
 
+    class QueryWorker;
+    void onTileQueried(uint64_t queryID, std::size_t tileIndex, RenderedFeatureQuery::FeatureResult);
+    void finishQuery(uint64_t queryID);
+
     friend class Renderer;
 
     RendererBackend& backend;
@@ -59,9 +74,35 @@ private:
     RenderState renderState = RenderState::Never;
     FrameHistory frameHistory;
     TransformState transformState;
+    algorithm::ClipIDCache clipIDCache;
 
     std::unique_ptr<RenderStyle> renderStyle;
-    std::unique_ptr<RenderStaticData> staticData;
+    std::shared_ptr<RenderStaticData> staticData;
+
+    Renderer::FrameProfileCallback frameProfileCallback;
+    std::unique_ptr<FrameProfiler> frameProfiler;
+
+    bool tileTracing = false;
+
+    // Storage allocated through the context, as of the end of the last render.
+    std::size_t gpuBufferBytes = 0;
+    std::size_t gpuTextureBytes = 0;
+
+    // Feature queries. The mailbox receives the results of asynchronous queries on the thread
+    // they're made on, and is created by the first one.
+    class PendingQuery {
+    public:
+        std::shared_ptr<const RenderedFeatureQuery> query;
+        std::vector<RenderedFeatureQuery::FeatureResult> results;
+        std::size_t remainingTiles;
+        QueryCallback callback;
+    };
+
+    std::shared_ptr<Mailbox> mailbox;
+    std::vector<std::unique_ptr<Actor<QueryWorker>>> queryWorkers;
+    std::size_t nextQueryWorker = 0;
+    std::unordered_map<uint64_t, PendingQuery> pendingQueries;
+    uint64_t nextQueryID = 0;
 };
 
 } // namespace mbgl
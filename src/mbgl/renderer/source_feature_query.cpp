@@ -0,0 +1,133 @@
+#include <mbgl/renderer/source_feature_query.hpp>
+#include <mbgl/util/intersection_tests.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
+
+#include <cassert>
+#include <set>
+
+namespace mbgl {
+
+// The bounds as a ring in the coordinates of the given tile.
+static GeometryCoordinates tileSpaceBounds(const LatLngBounds& bounds, const CanonicalTileID& id) {
+    const UnwrappedTileID tileID { 0, id };
+    const GeometryCoordinate min = TileCoordinate::toGeometryCoordinate(tileID, TileCoordinate::fromLatLng(0, bounds.northwest()).p);
+    const GeometryCoordinate max = TileCoordinate::toGeometryCoordinate(tileID, TileCoordinate::fromLatLng(0, bounds.southeast()).p);
+    return { min, { max.x, min.y }, max, { min.x, max.y }, min };
+}
+
+static bool intersects(const GeometryCoordinates& box, const GeometryTileFeature& feature) {
+    const GeometryCollection geometries = feature.getGeometries();
+    switch (feature.getType()) {
+    case FeatureType::Point:
+        return util::polygonIntersectsBufferedMultiPoint(box, geometries, 0);
+    case FeatureType::LineString:
+        return util::polygonIntersectsBufferedMultiLine(box, geometries, 0);
+    case FeatureType::Polygon:
+        return util::polygonIntersectsMultiPolygon(box, geometries);
+    default:
+        return false;
+    }
+}
+
+SourceFeatureQuery::SourceFeatureQuery(SourceQueryOptions options_)
+    : options(std::move(options_)) {
+}
+
+SourceFeatureQuery::~SourceFeatureQuery() = default;
+
+std::vector<FeatureHandle> SourceFeatureQuery::queryTile(std::size_t index) const {
+    assert(index < tiles.size());
+    const Tile& tile = tiles[index];
+
+    optional<GeometryCoordinates> box;
+    if (options.bounds) {
+        box = tileSpaceBounds(*options.bounds, tile.id);
+    }
+
+    std::vector<FeatureHandle> result;
+    std::set<FeatureIdentifier> seen;
+    for (const auto& sourceLayer : tile.sourceLayers) {
+        std::shared_ptr<const GeometryTileLayer> layer = tile.data->getLayer(sourceLayer);
+        if (!layer) {
+            continue;
+        }
+
+        const std::size_t featureCount = layer->featureCount();
+        for (std::size_t i = 0; i < featureCount; i++) {
+            if (options.limit && result.size() >= *options.limit) {
+                return result;
+            }
+
+            auto feature = layer->getFeature(i);
+
+            if (options.filter && !(*options.filter)(*feature)) {
+                continue;
+            }
+
+            if (box && !intersects(*box, *feature)) {
+                continue;
+            }
+
+            // Drop duplicates within the tile here so that they don't count
+            // towards the limit; duplicates across tiles are dropped in merge().
+            if (options.deduplicate) {
+                auto id = feature->getID();
+                if (id && !seen.insert(*id).second) {
+                    continue;
+                }
+            }
+
+            result.emplace_back(layer, std::move(feature), tile.id);
+        }
+    }
+    return result;
+}
+
+std::vector<Feature> SourceFeatureQuery::toFeatures(const std::vector<FeatureHandle>& handles) const {
+    std::vector<Feature> result;
+    result.reserve(handles.size());
+    for (const auto& handle : handles) {
+        result.push_back(handle.toFeature(options.properties, options.includeGeometry));
+    }
+    return result;
+}
+
+static optional<FeatureIdentifier> getID(const FeatureHandle& handle) {
+    return handle.getID();
+}
+
+static const optional<FeatureIdentifier>& getID(const Feature& feature) {
+    return feature.id;
+}
+
+template <class T>
+static std::vector<T> mergeTiles(const SourceQueryOptions& options, std::vector<std::vector<T>> results) {
+    std::vector<T> result;
+    std::set<FeatureIdentifier> seen;
+
+    for (auto& tileResult : results) {
+        for (auto& feature : tileResult) {
+            if (options.deduplicate) {
+                auto id = getID(feature);
+                if (id && !seen.insert(*id).second) {
+                    continue;
+                }
+            }
+            if (options.limit && result.size() >= *options.limit) {
+                return result;
+            }
+            result.push_back(std::move(feature));
+        }
+    }
+    return result;
+}
+
+std::vector<FeatureHandle> SourceFeatureQuery::merge(std::vector<std::vector<FeatureHandle>> results) const {
+    return mergeTiles(options, std::move(results));
+}
+
+std::vector<Feature> SourceFeatureQuery::merge(std::vector<std::vector<Feature>> results) const {
+    return mergeTiles(options, std::move(results));
+}
+
+} // namespace mbgl
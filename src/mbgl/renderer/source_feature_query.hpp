@@ -0,0 +1,48 @@
+#pragma once
+
+#include <mbgl/renderer/feature_handle.hpp>
+#include <mbgl/renderer/query.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// A copy of the tile data a source feature query scans, so that the tiles can be scanned on
+// other threads.
+class SourceFeatureQuery {
+public:
+    class Tile {
+    public:
+        std::unique_ptr<const GeometryTileData> data;
+        CanonicalTileID id;
+
+        // GeoJSON tiles have a single layer, whose name is ignored.
+        std::vector<std::string> sourceLayers;
+    };
+
+    explicit SourceFeatureQuery(SourceQueryOptions);
+    ~SourceFeatureQuery();
+
+    // Returns the features of the tile at the given index that match the filter and bounds,
+    // at most `limit` of them. Safe to call from any thread, and concurrently for different
+    // tiles.
+    std::vector<FeatureHandle> queryTile(std::size_t index) const;
+
+    // Converts features, copying only the properties and geometries the options ask for.
+    std::vector<Feature> toFeatures(const std::vector<FeatureHandle>&) const;
+
+    // Combines the results of all tiles, in tile order, dropping duplicates if requested and
+    // applying the limit.
+    std::vector<FeatureHandle> merge(std::vector<std::vector<FeatureHandle>>) const;
+    std::vector<Feature> merge(std::vector<std::vector<Feature>>) const;
+
+    const SourceQueryOptions options;
+    std::vector<Tile> tiles;
+};
+
+} // namespace mbgl
@@ -3,9 +3,6 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 
-#include <mbgl/algorithm/generate_clip_ids.hpp>
-#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
-
 namespace mbgl {
 
 using namespace style;
@@ -27,6 +24,7 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
                                  const std::vector<Immutable<Layer::Impl>>& layers,
                                  const bool needsRendering,
                                  const bool needsRelayout,
+                                 const ImageDependencies& changedImages,
                                  const TileParameters& parameters) {
     std::swap(baseImpl, baseImpl_);
 
@@ -50,6 +48,7 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
     tilePyramid.update(layers,
                        needsRendering,
                        needsRelayout,
+                       changedImages,
                        parameters,
                        SourceType::GeoJSON,
                        util::tileSize,
@@ -60,7 +59,6 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
 }
 
 void RenderGeoJSONSource::startRender(PaintParameters& parameters) {
-    parameters.clipIDGenerator.update(tilePyramid.getRenderTiles());
     tilePyramid.startRender(parameters);
 }
 
@@ -80,8 +78,15 @@ RenderGeoJSONSource::queryRenderedFeatures(const ScreenLineString& geometry,
     return tilePyramid.queryRenderedFeatures(geometry, transformState, style, options);
 }
 
-std::vector<Feature> RenderGeoJSONSource::querySourceFeatures(const SourceQueryOptions& options) const {
-    return tilePyramid.querySourceFeatures(options);
+void RenderGeoJSONSource::snapshotRenderedFeatures(RenderedFeatureQuery& query,
+                                                   const ScreenLineString& geometry,
+                                                   const TransformState& transformState,
+                                                   const RenderStyle& style) const {
+    tilePyramid.snapshotRenderedFeatures(query, geometry, transformState, style);
+}
+
+void RenderGeoJSONSource::snapshotSourceFeatures(SourceFeatureQuery& query) const {
+    tilePyramid.snapshotSourceFeatures(query);
 }
 
 void RenderGeoJSONSource::onLowMemory() {
@@ -92,4 +97,8 @@ void RenderGeoJSONSource::dumpDebugLogs() const {
     tilePyramid.dumpDebugLogs();
 }
 
+void RenderGeoJSONSource::reportMemory(MemoryReport& report) const {
+    tilePyramid.reportMemory(report, baseImpl->id);
+}
+
 } // namespace mbgl
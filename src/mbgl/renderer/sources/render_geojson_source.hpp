@@ -20,6 +20,7 @@ public:
                 const std::vector<Immutable<style::Layer::Impl>>&,
                 bool needsRendering,
                 bool needsRelayout,
+                const ImageDependencies& changedImages,
                 const TileParameters&) final;
 
     void startRender(PaintParameters&) final;
@@ -33,11 +34,16 @@ public:
                           const RenderStyle& style,
                           const RenderedQueryOptions& options) const final;
 
-    std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const final;
+    void snapshotRenderedFeatures(RenderedFeatureQuery&,
+                                  const ScreenLineString& geometry,
+                                  const TransformState& transformState,
+                                  const RenderStyle& style) const final;
+
+    void snapshotSourceFeatures(SourceFeatureQuery&) const final;
 
     void onLowMemory() final;
     void dumpDebugLogs() const final;
+    void reportMemory(MemoryReport&) const final;
 
 private:
     const style::GeoJSONSource::Impl& impl() const;
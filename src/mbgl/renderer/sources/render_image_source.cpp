@@ -88,14 +88,20 @@ RenderImageSource::queryRenderedFeatures(const ScreenLineString&,
     return std::unordered_map<std::string, std::vector<Feature>> {};
 }
 
-std::vector<Feature> RenderImageSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderImageSource::snapshotRenderedFeatures(RenderedFeatureQuery&,
+                                                 const ScreenLineString&,
+                                                 const TransformState&,
+                                                 const RenderStyle&) const {
+}
+
+void RenderImageSource::snapshotSourceFeatures(SourceFeatureQuery&) const {
 }
 
 void RenderImageSource::update(Immutable<style::Source::Impl> baseImpl_,
                                const std::vector<Immutable<Layer::Impl>>&,
                                const bool needsRendering,
                                const bool,
+                               const ImageDependencies&,
                                const TileParameters& parameters) {
     enabled = needsRendering;
     if (!needsRendering) {
@@ -211,4 +217,10 @@ void RenderImageSource::dumpDebugLogs() const {
     Log::Info(Event::General, "RenderImageSource::loaded: %s", isLoaded() ? "yes" : "no");
 }
 
+void RenderImageSource::reportMemory(MemoryReport& report) const {
+    if (bucket) {
+        bucket->getMemoryUsage().addTo(report, impl().id, "");
+    }
+}
+
 } // namespace mbgl
@@ -22,6 +22,7 @@ public:
                 const std::vector<Immutable<style::Layer::Impl>>&,
                 bool needsRendering,
                 bool needsRelayout,
+                const ImageDependencies& changedImages,
                 const TileParameters&) final;
 
     std::vector<std::reference_wrapper<RenderTile>> getRenderTiles() final {
@@ -34,11 +35,17 @@ public:
                           const RenderStyle& style,
                           const RenderedQueryOptions& options) const final;
 
-    std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const final;
+    void snapshotRenderedFeatures(RenderedFeatureQuery&,
+                                  const ScreenLineString& geometry,
+                                  const TransformState& transformState,
+                                  const RenderStyle& style) const final;
+
+    void snapshotSourceFeatures(SourceFeatureQuery&) const final;
 
     void onLowMemory() final {
     }
     void dumpDebugLogs() const final;
+    void reportMemory(MemoryReport&) const final;
 
 private:
     friend class RenderRasterLayer;
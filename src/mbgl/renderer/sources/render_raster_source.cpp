@@ -24,6 +24,7 @@ void RenderRasterSource::update(Immutable<style::Source::Impl> baseImpl_,
                                 const std::vector<Immutable<Layer::Impl>>& layers,
                                 const bool needsRendering,
                                 const bool needsRelayout,
+                                const ImageDependencies& changedImages,
                                 const TileParameters& parameters) {
     std::swap(baseImpl, baseImpl_);
 
@@ -48,6 +49,7 @@ void RenderRasterSource::update(Immutable<style::Source::Impl> baseImpl_,
     tilePyramid.update(layers,
                        needsRendering,
                        needsRelayout,
+                       changedImages,
                        parameters,
                        SourceType::Raster,
                        impl().getTileSize(),
@@ -78,8 +80,13 @@ RenderRasterSource::queryRenderedFeatures(const ScreenLineString&,
     return std::unordered_map<std::string, std::vector<Feature>> {};
 }
 
-std::vector<Feature> RenderRasterSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderRasterSource::snapshotRenderedFeatures(RenderedFeatureQuery&,
+                                                  const ScreenLineString&,
+                                                  const TransformState&,
+                                                  const RenderStyle&) const {
+}
+
+void RenderRasterSource::snapshotSourceFeatures(SourceFeatureQuery&) const {
 }
 
 void RenderRasterSource::onLowMemory() {
@@ -90,4 +97,8 @@ void RenderRasterSource::dumpDebugLogs() const {
     tilePyramid.dumpDebugLogs();
 }
 
+void RenderRasterSource::reportMemory(MemoryReport& report) const {
+    tilePyramid.reportMemory(report, baseImpl->id);
+}
+
 } // namespace mbgl
@@ -3,9 +3,6 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/tile/vector_tile.hpp>
 
-#include <mbgl/algorithm/generate_clip_ids.hpp>
-#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
-
 namespace mbgl {
 
 using namespace style;
@@ -27,6 +24,7 @@ void RenderVectorSource::update(Immutable<style::Source::Impl> baseImpl_,
                                 const std::vector<Immutable<Layer::Impl>>& layers,
                                 const bool needsRendering,
                                 const bool needsRelayout,
+                                const ImageDependencies& changedImages,
                                 const TileParameters& parameters) {
     std::swap(baseImpl, baseImpl_);
 
@@ -51,6 +49,7 @@ void RenderVectorSource::update(Immutable<style::Source::Impl> baseImpl_,
     tilePyramid.update(layers,
                        needsRendering,
                        needsRelayout,
+                       changedImages,
                        parameters,
                        SourceType::Vector,
                        util::tileSize,
@@ -61,7 +60,6 @@ void RenderVectorSource::update(Immutable<style::Source::Impl> baseImpl_,
 }
 
 void RenderVectorSource::startRender(PaintParameters& parameters) {
-    parameters.clipIDGenerator.update(tilePyramid.getRenderTiles());
     tilePyramid.startRender(parameters);
 }
 
@@ -81,8 +79,15 @@ RenderVectorSource::queryRenderedFeatures(const ScreenLineString& geometry,
     return tilePyramid.queryRenderedFeatures(geometry, transformState, style, options);
 }
 
-std::vector<Feature> RenderVectorSource::querySourceFeatures(const SourceQueryOptions& options) const {
-    return tilePyramid.querySourceFeatures(options);
+void RenderVectorSource::snapshotRenderedFeatures(RenderedFeatureQuery& query,
+                                                  const ScreenLineString& geometry,
+                                                  const TransformState& transformState,
+                                                  const RenderStyle& style) const {
+    tilePyramid.snapshotRenderedFeatures(query, geometry, transformState, style);
+}
+
+void RenderVectorSource::snapshotSourceFeatures(SourceFeatureQuery& query) const {
+    tilePyramid.snapshotSourceFeatures(query);
 }
 
 void RenderVectorSource::onLowMemory() {
@@ -93,4 +98,8 @@ void RenderVectorSource::dumpDebugLogs() const {
     tilePyramid.dumpDebugLogs();
 }
 
+void RenderVectorSource::reportMemory(MemoryReport& report) const {
+    tilePyramid.reportMemory(report, baseImpl->id);
+}
+
 } // namespace mbgl
@@ -16,25 +16,46 @@ StyleDifference<T> diff(const Immutable<std::vector<T>>& a,
         return result;
     }
 
+    auto aBegin = a->begin();
+    auto aEnd = a->end();
+    auto bBegin = b->begin();
+    auto bEnd = b->end();
+
+    auto matched = [&] (const T& before, const T& after) {
+        if (before.get() != after.get()) {
+            result.changed.emplace(after->id, StyleChange<T> { before, after });
+        }
+    };
+
+    // Most updates modify elements in place (e.g. setting a paint property) or insert or remove
+    // a single element (e.g. adding a runtime image). Matching elements in a common prefix or
+    // suffix are always part of an LCS, so strip them in linear time and only run the full
+    // diff over the section in between, which is empty or small in these cases.
+    while (aBegin != aEnd && bBegin != bEnd && eq(*aBegin, *bBegin)) {
+        matched(*aBegin++, *bBegin++);
+    }
+
+    while (aBegin != aEnd && bBegin != bEnd && eq(*(aEnd - 1), *(bEnd - 1))) {
+        matched(*--aEnd, *--bEnd);
+    }
+
     std::vector<T> lcs;
 
-    longest_common_subsequence(a->begin(), a->end(), b->begin(), b->end(), std::back_inserter(lcs), eq);
+    longest_common_subsequence(aBegin, aEnd, bBegin, bEnd, std::back_inserter(lcs), eq);
 
-    auto aIt = a->begin();
-    auto bIt = b->begin();
+    auto aIt = aBegin;
+    auto bIt = bBegin;
     auto lIt = lcs.begin();
 
-    while (aIt != a->end() || bIt != b->end()) {
-        if (aIt != a->end() && (lIt == lcs.end() || !eq(*lIt, *aIt))) {
+    while (aIt != aEnd || bIt != bEnd) {
+        if (aIt != aEnd && (lIt == lcs.end() || !eq(*lIt, *aIt))) {
             result.removed.emplace((*aIt)->id, *aIt);
             aIt++;
-        } else if (bIt != b->end() && (lIt == lcs.end() || !eq(*lIt, *bIt))) {
+        } else if (bIt != bEnd && (lIt == lcs.end() || !eq(*lIt, *bIt))) {
             result.added.emplace((*bIt)->id, *bIt);
             bIt++;
         } else {
-            if (aIt->get() != bIt->get()) {
-                result.changed.emplace((*bIt)->id, StyleChange<T> { *aIt, *bIt });
-            }
+            matched(*aIt, *bIt);
             aIt++;
             bIt++;
             lIt++;
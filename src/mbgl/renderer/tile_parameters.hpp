@@ -10,6 +10,7 @@ class FileSource;
 class AnnotationManager;
 class ImageManager;
 class GlyphManager;
+class TileTracer;
 
 class TileParameters {
 public:
@@ -23,6 +24,7 @@ public:
     ImageManager& imageManager;
     GlyphManager& glyphManager;
     const uint8_t prefetchZoomDelta;
+    TileTracer& tileTracer;
 };
 
 } // namespace mbgl
@@ -4,6 +4,8 @@
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/source_feature_query.hpp>
+#include <mbgl/renderer/memory_report.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/math/clamp.hpp>
@@ -58,21 +60,30 @@ std::vector<std::reference_wrapper<RenderTile>> TilePyramid::getRenderTiles() {
 void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layers,
                          const bool needsRendering,
                          const bool needsRelayout,
+                         const ImageDependencies& changedImages,
                          const TileParameters& parameters,
                          const SourceType type,
                          const uint16_t tileSize,
                          const Range<uint8_t> zoomRange,
                          std::function<std::unique_ptr<Tile> (const OverscaledTileID&)> createTile) {
+    // A tile is stale if the layers changed, or if its last layout referenced
+    // one of the images that were added, removed or changed since the last update.
+    auto isStale = [&](const Tile& tile) {
+        return needsRelayout || (!changedImages.empty() && tile.dependsOnImages(changedImages));
+    };
+
     // If we need a relayout, abandon any cached tiles; they're now stale.
     if (needsRelayout) {
         cache.clear();
+    } else if (!changedImages.empty()) {
+        cache.removeIf(isStale);
     }
 
     // If we're not going to render anything, move our existing tiles into
     // the cache (if they're not stale) or abandon them, and return.
     if (!needsRendering) {
-        if (!needsRelayout) {
-            for (auto& entry : tiles) {
+        for (auto& entry : tiles) {
+            if (!isStale(*entry.second)) {
                 cache.add(entry.first, std::move(entry.second));
             }
         }
@@ -126,7 +137,7 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
             tile.setNecessity(necessity);
         }
 
-        if (needsRelayout) {
+        if (isStale(tile)) {
             tile.setLayers(layers);
         }
     };
@@ -209,8 +220,30 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
                                            const RenderStyle& style,
                                            const RenderedQueryOptions& options) const {
     std::unordered_map<std::string, std::vector<Feature>> result;
+    forEachQueriedTile(geometry, transformState, [&] (const RenderTile& renderTile, const GeometryCoordinates& queryGeometry) {
+        renderTile.tile.queryRenderedFeatures(result,
+                                              queryGeometry,
+                                              transformState,
+                                              style,
+                                              options);
+    });
+    return result;
+}
+
+void TilePyramid::snapshotRenderedFeatures(RenderedFeatureQuery& query,
+                                           const ScreenLineString& geometry,
+                                           const TransformState& transformState,
+                                           const RenderStyle& style) const {
+    forEachQueriedTile(geometry, transformState, [&] (const RenderTile& renderTile, const GeometryCoordinates& queryGeometry) {
+        renderTile.tile.snapshotRenderedFeatures(query, queryGeometry, transformState, style);
+    });
+}
+
+void TilePyramid::forEachQueriedTile(const ScreenLineString& geometry,
+                                     const TransformState& transformState,
+                                     const std::function<void (const RenderTile&, const GeometryCoordinates&)>& fn) const {
     if (renderTiles.empty() || geometry.empty()) {
-        return result;
+        return;
     }
 
     LineString<double> queryGeometry;
@@ -246,24 +279,17 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
             tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(renderTile.id, c));
         }
 
-        renderTile.tile.queryRenderedFeatures(result,
-                                              tileSpaceQueryGeometry,
-                                              transformState,
-                                              style,
-                                              options);
+        fn(renderTile, tileSpaceQueryGeometry);
     }
-
-    return result;
 }
 
-std::vector<Feature> TilePyramid::querySourceFeatures(const SourceQueryOptions& options) const {
-    std::vector<Feature> result;
-
+void TilePyramid::snapshotSourceFeatures(SourceFeatureQuery& query) const {
     for (const auto& pair : tiles) {
-        pair.second->querySourceFeatures(result, options);
+        if (query.options.bounds && !query.options.bounds->intersects(LatLngBounds(pair.first.canonical))) {
+            continue;
+        }
+        pair.second->snapshotSourceFeatures(query);
     }
-
-    return result;
 }
 
 void TilePyramid::setCacheSize(size_t size) {
@@ -284,4 +310,17 @@ void TilePyramid::dumpDebugLogs() const {
     }
 }
 
+void TilePyramid::reportMemory(MemoryReport& report, const std::string& sourceID) const {
+    for (const auto& pair : tiles) {
+        pair.second->reportMemory(report, sourceID);
+    }
+
+    // Cached tiles are reported as a whole, since they're evicted as a whole.
+    MemoryReport cached;
+    cache.forEach([&] (const Tile& tile) {
+        tile.reportMemory(cached, sourceID);
+    });
+    report.add(sourceID, "", MemoryCategory::CachedTiles, cached.total());
+}
+
 } // namespace mbgl
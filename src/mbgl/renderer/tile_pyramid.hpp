@@ -23,8 +23,11 @@ class TransformState;
 class RenderTile;
 class RenderStyle;
 class RenderedQueryOptions;
+class RenderedFeatureQuery;
 class SourceQueryOptions;
+class SourceFeatureQuery;
 class TileParameters;
+class MemoryReport;
 
 class TilePyramid {
 public:
@@ -36,6 +39,7 @@ public:
     void update(const std::vector<Immutable<style::Layer::Impl>>&,
                 bool needsRendering,
                 bool needsRelayout,
+                const ImageDependencies& changedImages,
                 const TileParameters&,
                 SourceType type,
                 uint16_t tileSize,
@@ -53,13 +57,27 @@ public:
                           const RenderStyle& style,
                           const RenderedQueryOptions& options) const;
 
-    std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const;
+    // Adds the query's tiles to a snapshot that RenderedFeatureQuery can query off this thread.
+    void snapshotRenderedFeatures(RenderedFeatureQuery&,
+                                  const ScreenLineString& geometry,
+                                  const TransformState& transformState,
+                                  const RenderStyle& style) const;
+
+    // Calls `fn` for each render tile the geometry intersects, in query order, with the
+    // geometry converted to tile coordinates.
+    void forEachQueriedTile(const ScreenLineString& geometry,
+                            const TransformState& transformState,
+                            const std::function<void (const RenderTile&, const GeometryCoordinates&)>& fn) const;
+
+    // Adds the loaded tiles that intersect the query's bounds to the query.
+    void snapshotSourceFeatures(SourceFeatureQuery&) const;
 
     void setCacheSize(size_t);
     void onLowMemory();
 
     void setObserver(TileObserver*);
     void dumpDebugLogs() const;
+    void reportMemory(MemoryReport&, const std::string& sourceID) const;
 
     bool enabled = false;
 
@@ -2,6 +2,8 @@
 
 #include <mbgl/storage/file_source.hpp>
 
+#include <vector>
+
 namespace mbgl {
 
 namespace util {
@@ -10,7 +12,7 @@ template <typename T> class Thread;
 
 class LocalFileSource : public FileSource {
 public:
-    LocalFileSource();
+    explicit LocalFileSource(std::size_t readerCount = 4);
     ~LocalFileSource() override;
 
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
@@ -20,7 +22,9 @@ public:
 private:
     class Impl;
 
-    std::unique_ptr<util::Thread<Impl>> impl;
+    const std::size_t readerCount;
+    std::vector<std::unique_ptr<util::Thread<Impl>>> readers;
+    std::size_t nextReader = 0;
 };
 
 } // namespace mbgl
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <mbgl/storage/file_source.hpp>
+
+#include <vector>
+
+namespace mbgl {
+
+namespace util {
+template <typename T> class Thread;
+} // namespace util
+
+// Reads tiles from local MBTiles archives, addressed as `mbtiles:///path/to/file.mbtiles`.
+// Requesting such a URL as a source returns TileJSON built from the archive's metadata table,
+// with tile URLs that point back into the archive.
+//
+// Archives are opened read-only. Every reader thread has its own connection to each archive,
+// and requests are spread across the readers, so that tiles are read in parallel.
+class MBTilesFileSource : public FileSource {
+public:
+    explicit MBTilesFileSource(std::size_t readerCount = 4);
+    ~MBTilesFileSource() override;
+
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+
+    static bool acceptsURL(const std::string& url);
+
+private:
+    class Impl;
+
+    std::vector<std::unique_ptr<util::Thread<Impl>>> readers;
+    std::size_t nextReader = 0;
+};
+
+} // namespace mbgl
@@ -16,6 +16,7 @@ Response& Response::operator=(const Response& res) {
     notModified = res.notModified;
     mustRevalidate = res.mustRevalidate;
     data = res.data;
+    compressed = res.compressed;
     modified = res.modified;
     expires = res.expires;
     etag = res.etag;
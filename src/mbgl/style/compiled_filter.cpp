@@ -0,0 +1,382 @@
+#include <mbgl/style/compiled_filter.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+namespace style {
+
+namespace {
+
+uint32_t typeMask(FeatureType type) {
+    return 1u << static_cast<uint8_t>(type);
+}
+
+template <class Op>
+bool compare(const Value& lhs, const Value& rhs, const Op& op) {
+    return Value::binary_visit(lhs, rhs, FilterComparator<Op> { op });
+}
+
+bool equal(const Value& lhs, const Value& rhs) {
+    return compare(lhs, rhs, [] (const auto& lhs_, const auto& rhs_) { return lhs_ == rhs_; });
+}
+
+// Relative cost of evaluating a filter against a feature: `$type` is free, `$id` needs the
+// feature ID, and everything else decodes property values.
+class FilterCost {
+public:
+    template <class T>
+    auto operator()(const T&) const -> decltype(std::declval<T>().key, 0) {
+        return 2;
+    }
+
+    template <class T>
+    auto operator()(const T& filter) const -> decltype(filter.filters, 0) {
+        int cost = 0;
+        for (const auto& child : filter.filters) {
+            cost = std::max(cost, Filter::visit(child, *this));
+        }
+        return cost;
+    }
+
+    int operator()(const NullFilter&) const { return 0; }
+    int operator()(const TypeEqualsFilter&) const { return 0; }
+    int operator()(const TypeNotEqualsFilter&) const { return 0; }
+    int operator()(const TypeInFilter&) const { return 0; }
+    int operator()(const TypeNotInFilter&) const { return 0; }
+    int operator()(const IdentifierEqualsFilter&) const { return 1; }
+    int operator()(const IdentifierNotEqualsFilter&) const { return 1; }
+    int operator()(const IdentifierInFilter&) const { return 1; }
+    int operator()(const IdentifierNotInFilter&) const { return 1; }
+    int operator()(const HasIdentifierFilter&) const { return 1; }
+    int operator()(const NotHasIdentifierFilter&) const { return 1; }
+};
+
+} // namespace
+
+bool CompiledFilter::ValueSet::contains(const Value& value) const {
+    if (value.is<std::string>()) {
+        return strings.count(value.get<std::string>());
+    } else if (value.is<bool>()) {
+        return value.get<bool>() ? hasTrue : hasFalse;
+    } else if (value.is<uint64_t>()) {
+        return numbers.count(double(value.get<uint64_t>()));
+    } else if (value.is<int64_t>()) {
+        return numbers.count(double(value.get<int64_t>()));
+    } else if (value.is<double>()) {
+        return numbers.count(value.get<double>());
+    }
+    return false;
+}
+
+class CompiledFilter::Compiler {
+public:
+    CompiledFilter& program;
+
+    void operator()(const NullFilter&) {
+        emit(Op::True);
+    }
+
+    void operator()(const EqualsFilter& filter) {
+        emit(Op::Equals, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const NotEqualsFilter& filter) {
+        emit(Op::NotEquals, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const LessThanFilter& filter) {
+        emit(Op::LessThan, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const LessThanEqualsFilter& filter) {
+        emit(Op::LessThanEquals, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const GreaterThanFilter& filter) {
+        emit(Op::GreaterThan, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const GreaterThanEqualsFilter& filter) {
+        emit(Op::GreaterThanEquals, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const InFilter& filter) {
+        emit(Op::In, key(filter.key), valueSet(filter.values));
+    }
+
+    void operator()(const NotInFilter& filter) {
+        emit(Op::NotIn, key(filter.key), valueSet(filter.values));
+    }
+
+    void operator()(const AnyFilter& filter) {
+        emitGroup(Op::Any, filter.filters);
+    }
+
+    void operator()(const AllFilter& filter) {
+        emitGroup(Op::All, filter.filters);
+    }
+
+    void operator()(const NoneFilter& filter) {
+        emitGroup(Op::None, filter.filters);
+    }
+
+    void operator()(const HasFilter& filter) {
+        emit(Op::Has, key(filter.key));
+    }
+
+    void operator()(const NotHasFilter& filter) {
+        emit(Op::NotHas, key(filter.key));
+    }
+
+    void operator()(const TypeEqualsFilter& filter) {
+        emit(Op::TypeIn, 0, typeMask(filter.value));
+    }
+
+    void operator()(const TypeNotEqualsFilter& filter) {
+        emit(Op::TypeNotIn, 0, typeMask(filter.value));
+    }
+
+    void operator()(const TypeInFilter& filter) {
+        emit(Op::TypeIn, 0, typeMasks(filter.values));
+    }
+
+    void operator()(const TypeNotInFilter& filter) {
+        emit(Op::TypeNotIn, 0, typeMasks(filter.values));
+    }
+
+    void operator()(const IdentifierEqualsFilter& filter) {
+        emit(Op::IdentifierIn, 0, identifiers({ filter.value }));
+    }
+
+    void operator()(const IdentifierNotEqualsFilter& filter) {
+        emit(Op::IdentifierNotIn, 0, identifiers({ filter.value }));
+    }
+
+    void operator()(const IdentifierInFilter& filter) {
+        emit(Op::IdentifierIn, 0, identifiers(filter.values));
+    }
+
+    void operator()(const IdentifierNotInFilter& filter) {
+        emit(Op::IdentifierNotIn, 0, identifiers(filter.values));
+    }
+
+    void operator()(const HasIdentifierFilter&) {
+        emit(Op::HasIdentifier);
+    }
+
+    void operator()(const NotHasIdentifierFilter&) {
+        emit(Op::NotHasIdentifier);
+    }
+
+private:
+    uint32_t emit(Op op, uint32_t key_ = 0, uint32_t operand = 0) {
+        const auto index = static_cast<uint32_t>(program.instructions.size());
+        program.instructions.push_back({ op, key_, operand, index + 1 });
+        return index;
+    }
+
+    void emitGroup(Op op, const std::vector<Filter>& filters) {
+        const uint32_t index = emit(op);
+
+        // Filters have no side effects, so children can be evaluated in any order. Put the
+        // cheapest ones first to decide as many features as possible without property lookups.
+        std::vector<const Filter*> ordered;
+        ordered.reserve(filters.size());
+        for (const auto& filter : filters) {
+            ordered.push_back(&filter);
+        }
+        std::stable_sort(ordered.begin(), ordered.end(), [] (const Filter* lhs, const Filter* rhs) {
+            return Filter::visit(*lhs, FilterCost()) < Filter::visit(*rhs, FilterCost());
+        });
+
+        for (const Filter* filter : ordered) {
+            Filter::visit(*filter, *this);
+        }
+
+        program.instructions[index].next = static_cast<uint32_t>(program.instructions.size());
+    }
+
+    uint32_t key(const std::string& key_) {
+        auto& keys = program.keys;
+        auto it = std::find(keys.begin(), keys.end(), key_);
+        if (it == keys.end()) {
+            it = keys.insert(keys.end(), key_);
+        }
+        return static_cast<uint32_t>(it - keys.begin());
+    }
+
+    uint32_t value(const Value& value_) {
+        program.values.push_back(value_);
+        return static_cast<uint32_t>(program.values.size() - 1);
+    }
+
+    uint32_t valueSet(const std::vector<Value>& values) {
+        ValueSet set;
+        for (const auto& value_ : values) {
+            if (value_.is<std::string>()) {
+                set.strings.insert(value_.get<std::string>());
+            } else if (value_.is<bool>()) {
+                (value_.get<bool>() ? set.hasTrue : set.hasFalse) = true;
+            } else if (value_.is<uint64_t>()) {
+                set.numbers.insert(double(value_.get<uint64_t>()));
+            } else if (value_.is<int64_t>()) {
+                set.numbers.insert(double(value_.get<int64_t>()));
+            } else if (value_.is<double>()) {
+                set.numbers.insert(value_.get<double>());
+            }
+            // Other values are not allowed by the style specification and never match.
+        }
+        program.valueSets.push_back(std::move(set));
+        return static_cast<uint32_t>(program.valueSets.size() - 1);
+    }
+
+    uint32_t typeMasks(const std::vector<FeatureType>& types) {
+        uint32_t mask = 0;
+        for (const auto type : types) {
+            mask |= typeMask(type);
+        }
+        return mask;
+    }
+
+    uint32_t identifiers(std::vector<FeatureIdentifier> values) {
+        program.identifiers.push_back(std::move(values));
+        return static_cast<uint32_t>(program.identifiers.size() - 1);
+    }
+};
+
+CompiledFilter::CompiledFilter(const Filter& filter) {
+    Compiler compiler { *this };
+    Filter::visit(filter, compiler);
+}
+
+optional<CompiledFilter::KeyIndices> CompiledFilter::resolveKeys(const GeometryTileLayer& layer) const {
+    KeyIndices result;
+    result.reserve(keys.size());
+    for (const auto& key : keys) {
+        optional<std::size_t> index = layer.getKeyIndex(key);
+        if (!index) {
+            return {};
+        }
+        result.push_back(*index);
+    }
+    return result;
+}
+
+bool CompiledFilter::operator()(const GeometryTileFeature& feature, const optional<KeyIndices>& keyIndices) const {
+    return evaluate(0, feature, keyIndices);
+}
+
+bool CompiledFilter::evaluate(uint32_t index, const GeometryTileFeature& feature, const optional<KeyIndices>& keyIndices) const {
+    const Instruction& instruction = instructions[index];
+
+    auto getValue = [&] () -> optional<Value> {
+        return keyIndices ? feature.getIndexedValue((*keyIndices)[instruction.key])
+                          : feature.getValue(keys[instruction.key]);
+    };
+
+    switch (instruction.op) {
+    case Op::True:
+        return true;
+
+    case Op::Equals: {
+        optional<Value> actual = getValue();
+        return actual && equal(*actual, values[instruction.operand]);
+    }
+
+    case Op::NotEquals: {
+        optional<Value> actual = getValue();
+        return !actual || !equal(*actual, values[instruction.operand]);
+    }
+
+    case Op::LessThan: {
+        optional<Value> actual = getValue();
+        return actual && compare(*actual, values[instruction.operand], [] (const auto& lhs_, const auto& rhs_) { return lhs_ < rhs_; });
+    }
+
+    case Op::LessThanEquals: {
+        optional<Value> actual = getValue();
+        return actual && compare(*actual, values[instruction.operand], [] (const auto& lhs_, const auto& rhs_) { return lhs_ <= rhs_; });
+    }
+
+    case Op::GreaterThan: {
+        optional<Value> actual = getValue();
+        return actual && compare(*actual, values[instruction.operand], [] (const auto& lhs_, const auto& rhs_) { return lhs_ > rhs_; });
+    }
+
+    case Op::GreaterThanEquals: {
+        optional<Value> actual = getValue();
+        return actual && compare(*actual, values[instruction.operand], [] (const auto& lhs_, const auto& rhs_) { return lhs_ >= rhs_; });
+    }
+
+    case Op::In: {
+        optional<Value> actual = getValue();
+        return actual && valueSets[instruction.operand].contains(*actual);
+    }
+
+    case Op::NotIn: {
+        optional<Value> actual = getValue();
+        return !actual || !valueSets[instruction.operand].contains(*actual);
+    }
+
+    case Op::Has:
+        return bool(getValue());
+
+    case Op::NotHas:
+        return !getValue();
+
+    case Op::Any:
+        for (uint32_t child = index + 1; child < instruction.next; child = instructions[child].next) {
+            if (evaluate(child, feature, keyIndices)) {
+                return true;
+            }
+        }
+        return false;
+
+    case Op::All:
+        for (uint32_t child = index + 1; child < instruction.next; child = instructions[child].next) {
+            if (!evaluate(child, feature, keyIndices)) {
+                return false;
+            }
+        }
+        return true;
+
+    case Op::None:
+        for (uint32_t child = index + 1; child < instruction.next; child = instructions[child].next) {
+            if (evaluate(child, feature, keyIndices)) {
+                return false;
+            }
+        }
+        return true;
+
+    case Op::TypeIn:
+        return instruction.operand & typeMask(feature.getType());
+
+    case Op::TypeNotIn:
+        return !(instruction.operand & typeMask(feature.getType()));
+
+    case Op::IdentifierIn: {
+        const optional<FeatureIdentifier> id = feature.getID();
+        const auto& candidates = identifiers[instruction.operand];
+        return id && std::find(candidates.begin(), candidates.end(), *id) != candidates.end();
+    }
+
+    case Op::IdentifierNotIn: {
+        const optional<FeatureIdentifier> id = feature.getID();
+        const auto& candidates = identifiers[instruction.operand];
+        return !id || std::find(candidates.begin(), candidates.end(), *id) == candidates.end();
+    }
+
+    case Op::HasIdentifier:
+        return bool(feature.getID());
+
+    case Op::NotHasIdentifier:
+        return !feature.getID();
+    }
+
+    return false;
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <mbgl/style/filter.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace mbgl {
+
+class GeometryTileFeature;
+class GeometryTileLayer;
+
+namespace style {
+
+/*
+   A `Filter` flattened into a linear program, for evaluating the same filter against
+   every feature of a tile layer.
+
+   Compared to visiting the `Filter` variant tree, the compiled program:
+
+     * stores instructions in pre-order in a single vector, with each instruction recording
+       where its subtree ends, so `any`/`all`/`none` walk their children without recursion
+       into separately allocated vectors and stop at the first decisive child;
+     * tests `$type` and `$id` conditions before conditions on feature properties within
+       `any`/`all`/`none`, since they don't need to decode property values;
+     * interns property keys, so every instruction refers to a key by index, and the keys can
+       be resolved against a tile layer's key table once for all of its features;
+     * turns `in`/`!in` lists into hash sets and `$type` lists into bit masks.
+
+   Evaluation results are identical to `Filter::operator()`.
+*/
+class CompiledFilter {
+public:
+    using KeyIndices = std::vector<std::size_t>;
+
+    explicit CompiledFilter(const Filter&);
+
+    // Resolves the filter's property keys against the key table of `layer`. Returns nothing
+    // if the layer has no key table, in which case properties are looked up by name.
+    optional<KeyIndices> resolveKeys(const GeometryTileLayer& layer) const;
+
+    // Evaluates the filter for a feature. If given, `keyIndices` must have been resolved
+    // against the layer the feature belongs to.
+    bool operator()(const GeometryTileFeature&, const optional<KeyIndices>& keyIndices = {}) const;
+
+    // Property keys referenced by the filter, in the order instructions refer to them.
+    const std::vector<std::string>& getKeys() const { return keys; }
+
+private:
+    enum class Op : uint8_t {
+        True,
+        Equals,
+        NotEquals,
+        LessThan,
+        LessThanEquals,
+        GreaterThan,
+        GreaterThanEquals,
+        In,
+        NotIn,
+        Has,
+        NotHas,
+        Any,
+        All,
+        None,
+        TypeIn,
+        TypeNotIn,
+        IdentifierIn,
+        IdentifierNotIn,
+        HasIdentifier,
+        NotHasIdentifier
+    };
+
+    class Instruction {
+    public:
+        Op op;
+        uint32_t key;     // Index into `keys`, for property conditions.
+        uint32_t operand; // Index into the operand table for `op`, or a `$type` bit mask.
+        uint32_t next;    // Index of the first instruction after this one's subtree.
+    };
+
+    // A set of filter values, using the same equality as `FilterComparator`: numbers of
+    // any type are compared as doubles, and strings and booleans only match themselves.
+    class ValueSet {
+    public:
+        bool contains(const Value&) const;
+
+        std::unordered_set<std::string> strings;
+        std::unordered_set<double> numbers;
+        bool hasTrue = false;
+        bool hasFalse = false;
+    };
+
+    class Compiler;
+
+    bool evaluate(uint32_t index, const GeometryTileFeature&, const optional<KeyIndices>&) const;
+
+    std::vector<Instruction> instructions;
+    std::vector<std::string> keys;
+    std::vector<Value> values;
+    std::vector<ValueSet> valueSets;
+    std::vector<std::vector<FeatureIdentifier>> identifiers;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -303,7 +303,7 @@ public:
         writer.Key("base");
         writer.Double(f.base);
         writer.Key("stops");
-        stringifyStops(f.stops);
+        stringifyStops(f.getStops());
     }
 
     template <class T>
@@ -311,7 +311,7 @@ public:
         writer.Key("type");
         writer.String("interval");
         writer.Key("stops");
-        stringifyStops(f.stops);
+        stringifyStops(f.getStops());
     }
 
     template <class T>
@@ -319,7 +319,7 @@ public:
         writer.Key("type");
         writer.String("categorical");
         writer.Key("stops");
-        stringifyStops(f.stops);
+        stringifyStops(f.getStops());
     }
 
     template <class T>
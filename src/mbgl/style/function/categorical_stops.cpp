@@ -24,8 +24,8 @@ optional<T> CategoricalStops<T>::evaluate(const Value& value) const {
     if (!v) {
         return {};
     }
-    auto it = stops.find(*v);
-    return it == stops.end() ? optional<T>() : it->second;
+    auto it = hashedStops.find(std::cref(*v));
+    return it == hashedStops.end() ? optional<T>() : *it->second;
 }
 
 template class CategoricalStops<float>;
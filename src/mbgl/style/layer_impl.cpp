@@ -9,5 +9,13 @@ Layer::Impl::Impl(LayerType type_, std::string layerID, std::string sourceID)
       source(std::move(sourceID)) {
 }
 
+const CompiledFilter& Layer::Impl::getCompiledFilter() const {
+    // Layouts of several tiles may ask for it at the same time, on different worker threads.
+    std::call_once(compiledFilter.compiled, [&] {
+        compiledFilter.filter = std::make_unique<CompiledFilter>(filter);
+    });
+    return *compiledFilter.filter;
+}
+
 } // namespace style
 } // namespace mbgl
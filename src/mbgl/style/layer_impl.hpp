@@ -3,12 +3,15 @@
 #include <mbgl/style/layer.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/style/filter.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
 
 #include <string>
 #include <limits>
+#include <memory>
+#include <mutex>
 
 namespace mbgl {
 
@@ -41,6 +44,10 @@ public:
     // Utility function for automatic layer grouping.
     virtual void stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const = 0;
 
+    // Returns `filter` compiled for evaluation against tile features. It's compiled on first
+    // use, and shared by all tiles laid out with this layer.
+    const CompiledFilter& getCompiledFilter() const;
+
     const LayerType type;
     std::string id;
     std::string source;
@@ -52,6 +59,20 @@ public:
 
 protected:
     Impl(const Impl&) = default;
+
+private:
+    // Copies are made to be modified, so they start out without a compiled filter.
+    class LazyCompiledFilter {
+    public:
+        LazyCompiledFilter() = default;
+        LazyCompiledFilter(const LazyCompiledFilter&) {}
+        LazyCompiledFilter& operator=(const LazyCompiledFilter&) = delete;
+
+        std::once_flag compiled;
+        std::unique_ptr<const CompiledFilter> filter;
+    };
+
+    mutable LazyCompiledFilter compiledFilter;
 };
 
 } // namespace style
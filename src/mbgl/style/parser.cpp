@@ -281,7 +281,7 @@ std::vector<FontStack> Parser::fontStacks() const {
             } else if (textFont.isCameraFunction()) {
                 textFont.asCameraFunction().stops.match(
                     [&] (const auto& stops) {
-                        for (const auto& stop : stops.stops) {
+                        for (const auto& stop : stops.getStops()) {
                             optional.insert(stop.second);
                         }
                     }
@@ -80,6 +80,10 @@ float CollisionTile::findPlacementScale(const Point<float>& anchor, const Collis
     return minPlacementScale;
 }
 
+std::size_t CollisionTile::byteSize() const {
+    return (tree.size() + ignoredTree.size()) * sizeof(CollisionTreeBox);
+}
+
 float CollisionTile::placeFeature(const CollisionFeature& feature, bool allowOverlap, bool avoidEdges) {
     static const float infinity = std::numeric_limits<float>::infinity();
     static const std::array<CollisionBox, 4> edges {{
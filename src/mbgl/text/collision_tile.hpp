@@ -47,6 +47,9 @@ public:
 
     std::vector<IndexedSubfeature> queryRenderedSymbols(const GeometryCoordinates&, float scale) const;
 
+    // Approximate bytes held by the collision trees.
+    std::size_t byteSize() const;
+
     const PlacementConfig config;
 
     float minScale = 0.5f;
@@ -142,4 +142,14 @@ void GlyphManager::removeRequestor(GlyphRequestor& requestor) {
     }
 }
 
+std::size_t GlyphManager::byteSize() const {
+    std::size_t result = 0;
+    for (const auto& entry : entries) {
+        for (const auto& glyph : entry.second.glyphs) {
+            result += glyph.second->bitmap.bytes();
+        }
+    }
+    return result;
+}
+
 } // namespace mbgl
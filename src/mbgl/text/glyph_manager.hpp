@@ -39,6 +39,9 @@ public:
         glyphURL = url;
     }
 
+    // Bytes of the glyph bitmaps loaded so far.
+    std::size_t byteSize() const;
+
     void setObserver(GlyphManagerObserver*);
 
 private:
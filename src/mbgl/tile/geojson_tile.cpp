@@ -1,6 +1,7 @@
 #include <mbgl/tile/geojson_tile.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/source_feature_query.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
 #include <mbgl/util/string.hpp>
@@ -113,26 +114,14 @@ void GeoJSONTile::updateData(mapbox::geometry::feature_collection<int16_t> featu
 
 void GeoJSONTile::setNecessity(Necessity) {}
     
-void GeoJSONTile::querySourceFeatures(
-    std::vector<Feature>& result,
-    const SourceQueryOptions& options) {
-    
-    // Ignore the sourceLayer, there is only one
-    auto layer = getData()->getLayer({});
-    
-    if (layer) {
-        auto featureCount = layer->featureCount();
-        for (std::size_t i = 0; i < featureCount; i++) {
-            auto feature = layer->getFeature(i);
-            
-            // Apply filter, if any
-            if (options.filter && !(*options.filter)(*feature)) {
-                continue;
-            }
-            
-            result.push_back(convertFeature(*feature, id.canonical));
-        }
+void GeoJSONTile::snapshotSourceFeatures(SourceFeatureQuery& query) const {
+    const GeometryTileData* data = getData();
+    if (!data) {
+        return;
     }
+
+    // Ignore the sourceLayer, there is only one
+    query.tiles.push_back({ data->clone(), id.canonical, { std::string() } });
 }
 
 } // namespace mbgl
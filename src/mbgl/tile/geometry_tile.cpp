@@ -11,6 +11,9 @@
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/rendered_feature_query.hpp>
+#include <mbgl/renderer/source_feature_query.hpp>
+#include <mbgl/renderer/memory_report.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/storage/file_source.hpp>
@@ -23,6 +26,7 @@
 #include <mbgl/actor/scheduler.hpp>
 
 #include <iostream>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -31,13 +35,14 @@ using namespace style;
 GeometryTile::GeometryTile(const OverscaledTileID& id_,
                            std::string sourceID_,
                            const TileParameters& parameters)
-    : Tile(id_),
+    : Tile(id_, &parameters.tileTracer),
       sourceID(std::move(sourceID_)),
       mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
       worker(parameters.workerScheduler,
              ActorRef<GeometryTile>(*this, mailbox),
              id_,
              obsolete,
+             trace,
              parameters.mode,
              parameters.pixelRatio),
       glyphManager(parameters.glyphManager),
@@ -72,6 +77,7 @@ void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
     pending = true;
 
     ++correlationID;
+    trace.begin(TileStage::Queue, correlationID);
     worker.invoke(&GeometryTileWorker::setData, std::move(data_), correlationID);
 }
 
@@ -91,6 +97,7 @@ void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
 
 void GeometryTile::invokePlacement() {
     if (requestedConfig) {
+        trace.begin(TileStage::Queue, correlationID);
         worker.invoke(&GeometryTileWorker::setPlacementConfig, *requestedConfig, correlationID);
     }
 }
@@ -117,20 +124,35 @@ void GeometryTile::setLayers(const std::vector<Immutable<Layer::Impl>>& layers)
     }
 
     ++correlationID;
+    trace.begin(TileStage::Queue, correlationID);
     worker.invoke(&GeometryTileWorker::setLayers, std::move(impls), correlationID);
 }
 
+bool GeometryTile::dependsOnImages(const ImageDependencies& imageIDs) const {
+    for (const auto& imageID : imageIDs) {
+        if (imageDependencies.count(imageID)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void GeometryTile::onLayout(LayoutResult result) {
+    TileTrace::Scope traceScope(trace, TileStage::Apply);
+
     loaded = true;
     renderable = true;
     nonSymbolBuckets = std::move(result.nonSymbolBuckets);
     featureIndex = std::move(result.featureIndex);
     data = std::move(result.tileData);
+    imageDependencies = std::move(result.imageDependencies);
     collisionTile.reset();
     observer->onTileChanged(*this);
 }
 
 void GeometryTile::onPlacement(PlacementResult result) {
+    TileTrace::Scope traceScope(trace, TileStage::Apply);
+
     loaded = true;
     renderable = true;
     if (result.correlationID == correlationID) {
@@ -169,8 +191,11 @@ void GeometryTile::onImagesAvailable(ImageMap images) {
     worker.invoke(&GeometryTileWorker::onImagesAvailable, std::move(images));
 }
 
-void GeometryTile::getImages(ImageDependencies imageDependencies) {
-    imageManager.getImages(*this, std::move(imageDependencies));
+void GeometryTile::getImages(ImageDependencies imageDependencies_) {
+    // Record the dependencies before the image manager takes its snapshot, so that an
+    // image change arriving before the corresponding onLayout still triggers a relayout.
+    imageDependencies = imageDependencies_;
+    imageManager.getImages(*this, std::move(imageDependencies_));
 }
 
 void GeometryTile::upload(gl::Context& context) {
@@ -232,40 +257,46 @@ void GeometryTile::queryRenderedFeatures(
                         *this);
 }
 
-void GeometryTile::querySourceFeatures(
-    std::vector<Feature>& result,
-    const SourceQueryOptions& options) {
+void GeometryTile::snapshotRenderedFeatures(
+    RenderedFeatureQuery& query,
+    const GeometryCoordinates& queryGeometry,
+    const TransformState& transformState,
+    const RenderStyle& style) const {
+
+    if (!featureIndex || !data) return;
+
+    const double tileSize = util::tileSize * id.overscaleFactor();
+    const double scale = std::pow(2, transformState.getZoom() - id.overscaledZ);
+    const int16_t additionalRadius = FeatureIndex::getAdditionalQueryRadius(
+        query.options, style, *this, util::EXTENT / tileSize / scale);
+
+    // Clones share the underlying tile buffer or features, so this doesn't copy any data.
+    query.tiles.push_back({
+        featureIndex,
+        data->clone(),
+        collisionTile,
+        id.canonical,
+        queryGeometry,
+        transformState.getAngle(),
+        tileSize,
+        scale,
+        additionalRadius
+    });
+}
 
+void GeometryTile::snapshotSourceFeatures(SourceFeatureQuery& query) const {
     // Data not yet available
     if (!data) {
         return;
     }
-    
+
     // No source layers, specified, nothing to do
-    if (!options.sourceLayers) {
+    if (!query.options.sourceLayers) {
         Log::Warning(Event::General, "At least one sourceLayer required");
         return;
     }
 
-    for (auto sourceLayer : *options.sourceLayers) {
-        // Go throught all sourceLayers, if any
-        // to gather all the features
-        auto layer = data->getLayer(sourceLayer);
-        
-        if (layer) {
-            auto featureCount = layer->featureCount();
-            for (std::size_t i = 0; i < featureCount; i++) {
-                auto feature = layer->getFeature(i);
-
-                // Apply filter, if any
-                if (options.filter && !(*options.filter)(*feature)) {
-                    continue;
-                }
-
-                result.push_back(convertFeature(*feature, id.canonical));
-            }
-        }
-    }
+    query.tiles.push_back({ data->clone(), id.canonical, *query.options.sourceLayers });
 }
 
 float GeometryTile::yStretch() const {
@@ -275,4 +306,25 @@ float GeometryTile::yStretch() const {
     return lastYStretch;
 }
 
+void GeometryTile::reportMemory(MemoryReport& report, const std::string& source) const {
+    // Layers with the same layout share a bucket, which is reported for one of them.
+    std::unordered_set<const Bucket*> reported;
+    auto reportBuckets = [&] (const std::unordered_map<std::string, std::shared_ptr<Bucket>>& buckets) {
+        for (const auto& entry : buckets) {
+            if (reported.insert(entry.second.get()).second) {
+                entry.second->getMemoryUsage().addTo(report, source, entry.first);
+            }
+        }
+    };
+    reportBuckets(nonSymbolBuckets);
+    reportBuckets(symbolBuckets);
+
+    report.add(source, "", MemoryCategory::FeatureIndex, featureIndex ? featureIndex->byteSize() : 0);
+    report.add(source, "", MemoryCategory::TileData, data ? data->byteSize() : 0);
+    report.add(source, "", MemoryCategory::CollisionTiles, collisionTile ? collisionTile->byteSize() : 0);
+    report.add(source, "", MemoryCategory::Atlases,
+               (glyphAtlasImage ? glyphAtlasImage->bytes() : 0) +
+               (iconAtlasImage ? iconAtlasImage->bytes() : 0));
+}
+
 } // namespace mbgl
@@ -39,6 +39,7 @@ public:
 
     void setPlacementConfig(const PlacementConfig&) override;
     void setLayers(const std::vector<Immutable<style::Layer::Impl>>&) override;
+    bool dependsOnImages(const ImageDependencies&) const override;
     
     void onGlyphsAvailable(GlyphMap) override;
     void onImagesAvailable(ImageMap) override;
@@ -59,26 +60,35 @@ public:
             const RenderStyle&,
             const RenderedQueryOptions& options) override;
 
-    void querySourceFeatures(
-        std::vector<Feature>& result,
-        const SourceQueryOptions&) override;
+    void snapshotRenderedFeatures(
+            RenderedFeatureQuery&,
+            const GeometryCoordinates& queryGeometry,
+            const TransformState&,
+            const RenderStyle&) const override;
+
+    void snapshotSourceFeatures(SourceFeatureQuery&) const override;
 
     void cancel() override;
 
+    void reportMemory(MemoryReport&, const std::string& source) const override;
+
     class LayoutResult {
     public:
         std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
         std::unique_ptr<FeatureIndex> featureIndex;
         std::unique_ptr<GeometryTileData> tileData;
+        ImageDependencies imageDependencies;
         uint64_t correlationID;
 
         LayoutResult(std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets_,
                      std::unique_ptr<FeatureIndex> featureIndex_,
                      std::unique_ptr<GeometryTileData> tileData_,
+                     ImageDependencies imageDependencies_,
                      uint64_t correlationID_)
             : nonSymbolBuckets(std::move(nonSymbolBuckets_)),
               featureIndex(std::move(featureIndex_)),
               tileData(std::move(tileData_)),
+              imageDependencies(std::move(imageDependencies_)),
               correlationID(correlationID_) {}
     };
     void onLayout(LayoutResult);
@@ -109,7 +119,7 @@ public:
     float yStretch() const override;
     
 protected:
-    const GeometryTileData* getData() {
+    const GeometryTileData* getData() const {
         return data.get();
     }
 
@@ -132,14 +142,20 @@ private:
     optional<PlacementConfig> requestedConfig;
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
-    std::unique_ptr<FeatureIndex> featureIndex;
+
+    // Shared with snapshots taken by rendered feature queries.
+    std::shared_ptr<const FeatureIndex> featureIndex;
     std::unique_ptr<const GeometryTileData> data;
 
+    // Images referenced by the most recent layout. Used to decide whether an image
+    // change requires this tile to be laid out again.
+    ImageDependencies imageDependencies;
+
     optional<AlphaImage> glyphAtlasImage;
     optional<PremultipliedImage> iconAtlasImage;
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
-    std::unique_ptr<CollisionTile> collisionTile;
+    std::shared_ptr<const CollisionTile> collisionTile;
     
     util::Throttler placementThrottler;
     float lastYStretch;
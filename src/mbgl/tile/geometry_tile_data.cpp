@@ -3,14 +3,17 @@
 
 #include <mapbox/geometry/wagyu/wagyu.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
-static double signedArea(const GeometryCoordinates& ring) {
+template <class Ring>
+static double signedArea(const Ring& ring) {
     double sum = 0;
 
     for (std::size_t i = 0, len = ring.size(), j = len - 1; i < len; j = i++) {
-        const GeometryCoordinate& p1 = ring[i];
-        const GeometryCoordinate& p2 = ring[j];
+        const auto& p1 = ring[i];
+        const auto& p2 = ring[j];
         sum += (p2.x - p1.x) * (p1.y + p2.y);
     }
 
@@ -51,17 +54,20 @@ GeometryCollection fixupPolygons(const GeometryCollection& rings) {
     return toGeometryCollection(std::move(multipolygon));
 }
 
-std::vector<GeometryCollection> classifyRings(const GeometryCollection& rings) {
-    std::vector<GeometryCollection> polygons;
-
+// Splits rings into polygons made of an outer ring followed by its holes, calling
+// `addPolygon()` when a polygon starts and `addRing(ring)` for each of its rings.
+template <class AddPolygon, class AddRing>
+static void splitPolygons(const GeometryCollection& rings, AddPolygon addPolygon, AddRing addRing) {
     std::size_t len = rings.size();
 
     if (len <= 1) {
-        polygons.push_back(rings);
-        return polygons;
+        addPolygon();
+        for (const auto& ring : rings) {
+            addRing(ring);
+        }
+        return;
     }
 
-    GeometryCollection polygon;
     int8_t ccw = 0;
 
     for (std::size_t i = 0; i < len; i++) {
@@ -73,21 +79,33 @@ std::vector<GeometryCollection> classifyRings(const GeometryCollection& rings) {
         if (ccw == 0)
             ccw = (area < 0 ? -1 : 1);
 
-        if (ccw == (area < 0 ? -1 : 1) && !polygon.empty()) {
-            polygons.push_back(polygon);
-            polygon.clear();
-        }
+        if (ccw == (area < 0 ? -1 : 1))
+            addPolygon();
 
-        polygon.push_back(rings[i]);
+        addRing(rings[i]);
     }
+}
 
-    if (!polygon.empty())
-        polygons.push_back(polygon);
+std::vector<GeometryCollection> classifyRings(const GeometryCollection& rings) {
+    std::vector<GeometryCollection> polygons;
+    splitPolygons(rings,
+        [&] { polygons.emplace_back(); },
+        [&] (const GeometryCoordinates& ring) { polygons.back().push_back(ring); });
+    return polygons;
+}
 
+ArenaVector<ArenaPolygon> classifyRings(const GeometryCollection& rings, Arena& arena) {
+    ArenaVector<ArenaPolygon> polygons(arena);
+    // Arena memory isn't reclaimed when a vector grows, so allocate the worst case up front.
+    polygons.reserve(std::max<std::size_t>(rings.size(), 1));
+    splitPolygons(rings,
+        [&] { polygons.emplace_back(arena); },
+        [&] (const GeometryCoordinates& ring) { polygons.back().emplace_back(ring.begin(), ring.end(), arena); });
     return polygons;
 }
 
-void limitHoles(GeometryCollection& polygon, uint32_t maxHoles) {
+template <class Polygon>
+static void limitPolygonHoles(Polygon& polygon, uint32_t maxHoles) {
     if (polygon.size() > 1 + maxHoles) {
         std::nth_element(polygon.begin() + 1,
                          polygon.begin() + 1 + maxHoles,
@@ -95,11 +113,19 @@ void limitHoles(GeometryCollection& polygon, uint32_t maxHoles) {
                          [] (const auto& a, const auto& b) {
                              return std::fabs(signedArea(a)) > std::fabs(signedArea(b));
                          });
-        polygon.resize(1 + maxHoles);
+        polygon.erase(polygon.begin() + 1 + maxHoles, polygon.end());
     }
 }
 
-static Feature::geometry_type convertGeometry(const GeometryTileFeature& geometryTileFeature, const CanonicalTileID& tileID) {
+void limitHoles(GeometryCollection& polygon, uint32_t maxHoles) {
+    limitPolygonHoles(polygon, maxHoles);
+}
+
+void limitHoles(ArenaPolygon& polygon, uint32_t maxHoles) {
+    limitPolygonHoles(polygon, maxHoles);
+}
+
+Feature::geometry_type convertGeometry(const GeometryTileFeature& geometryTileFeature, const CanonicalTileID& tileID) {
     const double size = util::EXTENT * std::pow(2, tileID.z);
     const double x0 = util::EXTENT * tileID.x;
     const double y0 = util::EXTENT * tileID.y;
@@ -3,6 +3,7 @@
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/optional.hpp>
+#include <mbgl/util/arena.hpp>
 
 #include <cstdint>
 #include <string>
@@ -42,6 +43,11 @@ public:
     virtual ~GeometryTileFeature() = default;
     virtual FeatureType getType() const = 0;
     virtual optional<Value> getValue(const std::string& key) const = 0;
+
+    // Looks up a property by an index obtained from GeometryTileLayer::getKeyIndex() on the
+    // layer this feature belongs to.
+    virtual optional<Value> getIndexedValue(std::size_t) const { return {}; }
+
     virtual PropertyMap getProperties() const { return PropertyMap(); }
     virtual optional<FeatureIdentifier> getID() const { return {}; }
     virtual GeometryCollection getGeometries() const = 0;
@@ -57,6 +63,11 @@ public:
     virtual std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const = 0;
 
     virtual std::string getName() const = 0;
+
+    // Layers that store property keys in a shared table can resolve a key once and then look it
+    // up in each feature with GeometryTileFeature::getIndexedValue(), instead of comparing key
+    // strings for every feature. Returns nothing for layers without a key table.
+    virtual optional<std::size_t> getKeyIndex(const std::string&) const { return {}; }
 };
 
 class GeometryTileData {
@@ -67,17 +78,31 @@ public:
     // Returns the layer with the given name. The returned layer object *may* outlive the data
     // object.
     virtual std::unique_ptr<GeometryTileLayer> getLayer(const std::string&) const = 0;
+
+    // Approximate bytes of the data held by this object. Clones may share their data.
+    virtual std::size_t byteSize() const { return 0; }
 };
 
 // classifies an array of rings into polygons with outer rings and holes
 std::vector<GeometryCollection> classifyRings(const GeometryCollection&);
 
+// Polygons whose rings are stored in an `Arena`, for layout temporaries.
+using ArenaGeometryCoordinates = ArenaVector<GeometryCoordinate>;
+using ArenaPolygon = ArenaVector<ArenaGeometryCoordinates>;
+
+// Same as above, but copies the rings into `arena`.
+ArenaVector<ArenaPolygon> classifyRings(const GeometryCollection&, Arena&);
+
 // Truncate polygon to the largest `maxHoles` inner rings by area.
 void limitHoles(GeometryCollection&, uint32_t maxHoles);
+void limitHoles(ArenaPolygon&, uint32_t maxHoles);
 
 // convert from GeometryTileFeature to Feature (eventually we should eliminate GeometryTileFeature)
 Feature convertFeature(const GeometryTileFeature&, const CanonicalTileID&);
 
+// Converts just the geometry, from tile coordinates to latitude/longitude.
+Feature::geometry_type convertGeometry(const GeometryTileFeature&, const CanonicalTileID&);
+
 // Fix up possibly-non-V2-compliant polygon geometry using angus clipper.
 // The result is guaranteed to have correctly wound, strictly simple rings.
 GeometryCollection fixupPolygons(const GeometryCollection&);
@@ -1,12 +1,13 @@
 #include <mbgl/tile/geometry_tile_worker.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/tile/tile_trace.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/group_by_layout.hpp>
 #include <mbgl/style/filter.hpp>
-#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
@@ -14,6 +15,7 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/arena.hpp>
 
 #include <unordered_set>
 
@@ -25,12 +27,14 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        ActorRef<GeometryTile> parent_,
                                        OverscaledTileID id_,
                                        const std::atomic<bool>& obsolete_,
+                                       TileTrace& trace_,
                                        const MapMode mode_,
                                        const float pixelRatio_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
       id(std::move(id_)),
       obsolete(obsolete_),
+      trace(trace_),
       mode(mode_),
       pixelRatio(pixelRatio_) {
 }
@@ -71,6 +75,8 @@ GeometryTileWorker::~GeometryTileWorker() = default;
 */
 
 void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_, uint64_t correlationID_) {
+    trace.end(TileStage::Queue, correlationID_);
+
     try {
         data = std::move(data_);
         correlationID = correlationID_;
@@ -93,6 +99,8 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
 }
 
 void GeometryTileWorker::setLayers(std::vector<Immutable<Layer::Impl>> layers_, uint64_t correlationID_) {
+    trace.end(TileStage::Queue, correlationID_);
+
     try {
         layers = std::move(layers_);
         correlationID = correlationID_;
@@ -117,6 +125,8 @@ void GeometryTileWorker::setLayers(std::vector<Immutable<Layer::Impl>> layers_,
 }
 
 void GeometryTileWorker::setPlacementConfig(PlacementConfig placementConfig_, uint64_t correlationID_) {
+    trace.end(TileStage::Queue, correlationID_);
+
     try {
         placementConfig = std::move(placementConfig_);
         correlationID = correlationID_;
@@ -141,6 +151,10 @@ void GeometryTileWorker::setPlacementConfig(PlacementConfig placementConfig_, ui
 }
 
 void GeometryTileWorker::symbolDependenciesChanged() {
+    if (!hasPendingSymbolDependencies()) {
+        trace.end(TileStage::Dependencies, correlationID);
+    }
+
     try {
         switch (state) {
         case Idle:
@@ -266,6 +280,8 @@ void GeometryTileWorker::redoLayout() {
         return;
     }
 
+    trace.begin(TileStage::Layout, correlationID);
+
     std::vector<std::string> symbolOrder;
     for (auto it = layers->rbegin(); it != layers->rend(); it++) {
         if ((*it)->type == LayerType::Symbol) {
@@ -278,6 +294,9 @@ void GeometryTileWorker::redoLayout() {
     auto featureIndex = std::make_unique<FeatureIndex>();
     BucketParameters parameters { id, mode, pixelRatio };
 
+    // Holds the temporaries of a single layer's buckets, and is reset after each layer.
+    Arena arena;
+
     GlyphDependencies glyphDependencies;
     ImageDependencies imageDependencies;
 
@@ -314,21 +333,24 @@ void GeometryTileWorker::redoLayout() {
             symbolLayoutMap.emplace(leader.getID(), std::move(layout));
             symbolLayoutsNeedPreparation = true;
         } else {
-            const Filter& filter = leader.baseImpl->filter;
+            const CompiledFilter& filter = leader.baseImpl->getCompiledFilter();
+            const auto keyIndices = filter.resolveKeys(*geometryLayer);
             const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
             std::shared_ptr<Bucket> bucket = leader.createBucket(parameters, group);
 
             for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
                 std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
 
-                if (!filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
+                if (!filter(*feature, keyIndices))
                     continue;
 
                 GeometryCollection geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries);
+                bucket->addFeature(*feature, geometries, arena);
                 featureIndex->insert(geometries, i, sourceLayerID, leader.getID());
             }
 
+            arena.reset();
+
             if (!bucket->hasData()) {
                 continue;
             }
@@ -349,14 +371,20 @@ void GeometryTileWorker::redoLayout() {
 
     requestNewGlyphs(glyphDependencies);
     requestNewImages(imageDependencies);
+    if (hasPendingSymbolDependencies()) {
+        trace.begin(TileStage::Dependencies, correlationID);
+    }
 
     parent.invoke(&GeometryTile::onLayout, GeometryTile::LayoutResult {
         std::move(buckets),
         std::move(featureIndex),
         *data ? (*data)->clone() : nullptr,
+        std::move(imageDependencies),
         correlationID
     });
 
+    trace.end(TileStage::Layout, correlationID);
+
     attemptPlacement();
 }
 
@@ -373,6 +401,8 @@ void GeometryTileWorker::attemptPlacement() {
     if (!data || !layers || !placementConfig || hasPendingSymbolDependencies()) {
         return;
     }
+
+    TileTrace::Scope traceScope(trace, TileStage::Placement, correlationID);
     
     optional<AlphaImage> glyphAtlasImage;
     optional<PremultipliedImage> iconAtlasImage;
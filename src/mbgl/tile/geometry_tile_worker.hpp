@@ -18,6 +18,7 @@ namespace mbgl {
 class GeometryTile;
 class GeometryTileData;
 class SymbolLayout;
+class TileTrace;
 
 namespace style {
 class Layer;
@@ -29,6 +30,7 @@ public:
                        ActorRef<GeometryTile> parent,
                        OverscaledTileID,
                        const std::atomic<bool>&,
+                       TileTrace&,
                        const MapMode,
                        const float pixelRatio);
     ~GeometryTileWorker();
@@ -58,6 +60,7 @@ private:
 
     const OverscaledTileID id;
     const std::atomic<bool>& obsolete;
+    TileTrace& trace;
     const MapMode mode;
     const float pixelRatio;
 
@@ -15,7 +15,7 @@ namespace mbgl {
 RasterTile::RasterTile(const OverscaledTileID& id_,
                        const TileParameters& parameters,
                        const Tileset& tileset)
-    : Tile(id_),
+    : Tile(id_, &parameters.tileTracer),
       loader(*this, id_, parameters, tileset),
       mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
       worker(parameters.workerScheduler,
@@ -34,11 +34,12 @@ void RasterTile::setError(std::exception_ptr err) {
 }
 
 void RasterTile::setData(std::shared_ptr<const std::string> data,
+                             bool compressed,
                              optional<Timestamp> modified_,
                              optional<Timestamp> expires_) {
     modified = modified_;
     expires = expires_;
-    worker.invoke(&RasterTileWorker::parse, data);
+    worker.invoke(&RasterTileWorker::parse, data, compressed);
 }
 
 void RasterTile::onParsed(std::unique_ptr<RasterBucket> result) {
@@ -56,8 +57,11 @@ void RasterTile::onError(std::exception_ptr err) {
 }
 
 void RasterTile::upload(gl::Context& context) {
-    if (bucket) {
+    if (bucket && bucket->needsUpload()) {
         bucket->upload(context);
+        // The texture holds the pixels now. Keeping the decoded copy would double the memory
+        // of every rendered and cached raster tile.
+        bucket->releaseImage();
     }
 }
 
@@ -65,6 +69,12 @@ Bucket* RasterTile::getBucket(const style::Layer::Impl&) const {
     return bucket.get();
 }
 
+void RasterTile::reportMemory(MemoryReport& report, const std::string& source) const {
+    if (bucket) {
+        bucket->getMemoryUsage().addTo(report, source, "");
+    }
+}
+
 void RasterTile::setMask(TileMask&& mask) {
     if (bucket) {
         bucket->setMask(std::move(mask));
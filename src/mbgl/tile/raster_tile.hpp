@@ -26,6 +26,7 @@ public:
 
     void setError(std::exception_ptr);
     void setData(std::shared_ptr<const std::string> data,
+                 bool compressed,
                  optional<Timestamp> modified_,
                  optional<Timestamp> expires_);
 
@@ -35,6 +36,7 @@ public:
     Bucket* getBucket(const style::Layer::Impl&) const override;
 
     void setMask(TileMask&&) override;
+    void reportMemory(MemoryReport&, const std::string& source) const override;
 
     void onParsed(std::unique_ptr<RasterBucket> result);
     void onError(std::exception_ptr);
@@ -3,6 +3,7 @@
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/actor/actor.hpp>
 #include <mbgl/util/premultiply.hpp>
+#include <mbgl/util/compression.hpp>
 
 namespace mbgl {
 
@@ -10,14 +11,15 @@ RasterTileWorker::RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTi
     : parent(std::move(parent_)) {
 }
 
-void RasterTileWorker::parse(std::shared_ptr<const std::string> data) {
+void RasterTileWorker::parse(std::shared_ptr<const std::string> data, bool compressed) {
     if (!data) {
         parent.invoke(&RasterTile::onParsed, nullptr); // No data; empty tile.
         return;
     }
 
     try {
-        auto bucket = std::make_unique<RasterBucket>(decodeImage(*data));
+        const std::string decompressed = compressed ? util::decompress(*data) : std::string();
+        auto bucket = std::make_unique<RasterBucket>(decodeImage(compressed ? decompressed : *data));
         parent.invoke(&RasterTile::onParsed, std::move(bucket));
     } catch (...) {
         parent.invoke(&RasterTile::onError, std::current_exception());
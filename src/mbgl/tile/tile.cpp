@@ -9,7 +9,8 @@ namespace mbgl {
 
 static TileObserver nullObserver;
 
-Tile::Tile(OverscaledTileID id_) : id(std::move(id_)), observer(&nullObserver) {
+Tile::Tile(OverscaledTileID id_, TileTracer* tracer)
+    : id(std::move(id_)), trace(tracer), observer(&nullObserver) {
 }
 
 Tile::~Tile() = default;
@@ -36,8 +37,12 @@ void Tile::queryRenderedFeatures(
         const RenderStyle&,
         const RenderedQueryOptions&) {}
 
-void Tile::querySourceFeatures(
-        std::vector<Feature>&,
-        const SourceQueryOptions&) {}
+void Tile::snapshotRenderedFeatures(
+        RenderedFeatureQuery&,
+        const GeometryCoordinates&,
+        const TransformState&,
+        const RenderStyle&) const {}
+
+void Tile::snapshotSourceFeatures(SourceFeatureQuery&) const {}
 
 } // namespace mbgl
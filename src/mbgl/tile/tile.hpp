@@ -6,11 +6,13 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/tile/tile_trace.hpp>
 #include <mbgl/renderer/tile_mask.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/style/layer_impl.hpp>
+#include <mbgl/style/image_impl.hpp>
 
 #include <string>
 #include <memory>
@@ -25,7 +27,9 @@ class TileObserver;
 class PlacementConfig;
 class RenderStyle;
 class RenderedQueryOptions;
-class SourceQueryOptions;
+class RenderedFeatureQuery;
+class SourceFeatureQuery;
+class MemoryReport;
 
 namespace gl {
 class Context;
@@ -33,7 +37,7 @@ class Context;
 
 class Tile : private util::noncopyable {
 public:
-    Tile(OverscaledTileID);
+    Tile(OverscaledTileID, TileTracer* = nullptr);
     virtual ~Tile();
 
     void setObserver(TileObserver* observer);
@@ -55,6 +59,10 @@ public:
 
     virtual void setPlacementConfig(const PlacementConfig&) {}
     virtual void setLayers(const std::vector<Immutable<style::Layer::Impl>>&) {}
+
+    // Returns true if the last layout of this tile referenced any of the given images,
+    // i.e. if it needs a relayout when they are added, removed or changed.
+    virtual bool dependsOnImages(const ImageDependencies&) const { return false; }
     virtual void setMask(TileMask&&) {}
 
     virtual void queryRenderedFeatures(
@@ -64,9 +72,17 @@ public:
             const RenderStyle&,
             const RenderedQueryOptions& options);
 
-    virtual void querySourceFeatures(
-            std::vector<Feature>& result,
-            const SourceQueryOptions&);
+    // Adds what a rendered feature query needs from this tile to the query, so that the
+    // query can run on another thread.
+    virtual void snapshotRenderedFeatures(
+            RenderedFeatureQuery&,
+            const GeometryCoordinates& queryGeometry,
+            const TransformState&,
+            const RenderStyle&) const;
+
+    // Adds this tile's data to a source feature query, so that the query can scan it on
+    // another thread.
+    virtual void snapshotSourceFeatures(SourceFeatureQuery&) const;
 
     void setTriedOptional();
 
@@ -101,12 +117,18 @@ public:
 
     void dumpDebugLogs() const;
 
+    // Adds the memory held by this tile to the report, attributed to the given source.
+    virtual void reportMemory(MemoryReport&, const std::string&) const {}
+
     const OverscaledTileID id;
     optional<Timestamp> modified;
     optional<Timestamp> expires;
 
     // Contains the tile ID string for painting debug information.
     std::unique_ptr<DebugBucket> debugBucket;
+
+    // Timestamped events of this tile's requests, layouts and placements.
+    TileTrace trace;
     
     virtual float yStretch() const { return 1.0f; }
 
@@ -63,4 +63,21 @@ void TileCache::clear() {
     tiles.clear();
 }
 
+void TileCache::removeIf(const std::function<bool (const Tile&)>& predicate) {
+    for (auto it = tiles.begin(); it != tiles.end();) {
+        if (predicate(*it->second)) {
+            orderedKeys.remove(it->first);
+            it = tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TileCache::forEach(const std::function<void (const Tile&)>& fn) const {
+    for (const auto& pair : tiles) {
+        fn(*pair.second);
+    }
+}
+
 } // namespace mbgl
@@ -2,6 +2,7 @@
 
 #include <mbgl/tile/tile_id.hpp>
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <map>
@@ -21,6 +22,11 @@ public:
     bool has(const OverscaledTileID& key);
     void clear();
 
+    // Removes every cached tile for which the predicate returns true.
+    void removeIf(const std::function<bool (const Tile&)>&);
+
+    void forEach(const std::function<void (const Tile&)>&) const;
+
 private:
     std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
     std::list<OverscaledTileID> orderedKeys;
@@ -25,6 +25,8 @@ TileLoader<T>::TileLoader(T& tile_,
         tileset.scheme)),
       fileSource(parameters.fileSource) {
     assert(!request);
+    // Tiles are inflated on the worker thread that parses them; see T::setData.
+    resource.acceptsCompressedData = true;
     if (fileSource.supportsOptionalRequests()) {
         // When supported, the first request is always optional, even if the TileLoader
         // is marked as required. That way, we can let the first optional request continue
@@ -52,8 +54,10 @@ void TileLoader<T>::loadOptional() {
     assert(!request);
 
     resource.necessity = Resource::Optional;
+    tile.trace.begin(TileStage::Request);
     request = fileSource.request(resource, [this](Response res) {
         request.reset();
+        tile.trace.end(TileStage::Request);
 
         tile.setTriedOptional();
 
@@ -99,7 +103,7 @@ void TileLoader<T>::loadedData(const Response& res) {
         resource.priorModified = res.modified;
         resource.priorExpires = res.expires;
         resource.priorEtag = res.etag;
-        tile.setData(res.noContent ? nullptr : res.data, res.modified, res.expires);
+        tile.setData(res.noContent ? nullptr : res.data, res.compressed, res.modified, res.expires);
     }
 }
 
@@ -108,7 +112,11 @@ void TileLoader<T>::loadRequired() {
     assert(!request);
 
     resource.necessity = Resource::Required;
-    request = fileSource.request(resource, [this](Response res) { loadedData(res); });
+    tile.trace.begin(TileStage::Request);
+    request = fileSource.request(resource, [this](Response res) {
+        tile.trace.end(TileStage::Request);
+        loadedData(res);
+    });
 }
 
 } // namespace mbgl
@@ -0,0 +1,128 @@
+#include <mbgl/tile/tile_trace.hpp>
+#include <mbgl/util/enum.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mbgl {
+
+MBGL_DEFINE_ENUM(TileStage, {
+    { TileStage::Request, "request" },
+    { TileStage::Queue, "queue" },
+    { TileStage::Layout, "layout" },
+    { TileStage::Dependencies, "dependencies" },
+    { TileStage::Placement, "placement" },
+    { TileStage::Apply, "apply" },
+});
+
+constexpr std::size_t TileTimings::stageCount;
+constexpr std::size_t TileTimings::Histogram::bucketCount;
+constexpr std::size_t TileTrace::capacity;
+
+static Duration bucketLimit(std::size_t bucket) {
+    return std::chrono::duration_cast<Duration>(Milliseconds(int64_t(1) << bucket));
+}
+
+void TileTimings::Histogram::add(Duration duration) {
+    std::size_t bucket = 0;
+    while (bucket + 1 < bucketCount && duration >= bucketLimit(bucket)) {
+        bucket++;
+    }
+
+    buckets[bucket]++;
+    count++;
+    total += duration;
+    max = std::max(max, duration);
+}
+
+Duration TileTimings::Histogram::quantile(double q) const {
+    if (count == 0) {
+        return Duration::zero();
+    }
+
+    const uint64_t rank = std::max<uint64_t>(1, std::ceil(std::min(1.0, std::max(0.0, q)) * count));
+    uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket + 1 < bucketCount; bucket++) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            return std::min(bucketLimit(bucket), max);
+        }
+    }
+    return max;
+}
+
+void TileTracer::add(TileStage stage, Duration duration) {
+    std::lock_guard<std::mutex> lock(mutex);
+    timings[stage].add(duration);
+}
+
+TileTimings TileTracer::getTimings() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return timings;
+}
+
+TileTrace::TileTrace(TileTracer* tracer_)
+    : tracer(tracer_) {
+}
+
+void TileTrace::begin(TileStage stage, uint64_t correlationID) {
+    if (tracer && tracer->isEnabled()) {
+        record(stage, Phase::Begin, correlationID);
+    }
+}
+
+void TileTrace::end(TileStage stage, uint64_t correlationID) {
+    if (tracer && tracer->isEnabled()) {
+        record(stage, Phase::End, correlationID);
+    }
+}
+
+void TileTrace::record(TileStage stage, Phase phase, uint64_t correlationID) {
+    const TimePoint now = Clock::now();
+    optional<Duration> duration;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (phase == Phase::End) {
+            // Find the begin event this one completes, newest first.
+            for (std::size_t i = 1; i <= size; i++) {
+                const Event& event = events[(next + capacity - i) % capacity];
+                if (event.stage != stage ||
+                    (stage == TileStage::Queue && event.correlationID != correlationID)) {
+                    continue;
+                }
+                if (event.phase == Phase::Begin) {
+                    duration = now - event.time;
+                    lastDurations[static_cast<std::size_t>(stage)] = duration;
+                }
+                break;
+            }
+        }
+
+        events[next] = { now, correlationID, stage, phase };
+        next = (next + 1) % capacity;
+        size = std::min(size + 1, capacity);
+    }
+
+    if (duration) {
+        tracer->add(stage, *duration);
+    }
+}
+
+std::vector<TileTrace::Event> TileTrace::getEvents() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Event> result;
+    result.reserve(size);
+    for (std::size_t i = size; i > 0; i--) {
+        result.push_back(events[(next + capacity - i) % capacity]);
+    }
+    return result;
+}
+
+optional<Duration> TileTrace::getLastDuration(TileStage stage) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastDurations[static_cast<std::size_t>(stage)];
+}
+
+} // namespace mbgl
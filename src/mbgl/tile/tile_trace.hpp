@@ -0,0 +1,100 @@
+#pragma once
+
+#include <mbgl/renderer/tile_timings.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace mbgl {
+
+// Aggregates the stage durations measured by the TileTraces of all tiles of a RenderStyle.
+// While disabled, tracing an event costs a single atomic load.
+class TileTracer : private util::noncopyable {
+public:
+    void setEnabled(bool enabled_) { enabled = enabled_; }
+    bool isEnabled() const { return enabled; }
+
+    void add(TileStage, Duration);
+    TileTimings getTimings() const;
+
+private:
+    std::atomic<bool> enabled { false };
+
+    mutable std::mutex mutex;
+    TileTimings timings;
+};
+
+/*
+   A ring buffer of timestamped events covering the stages of a single tile. Events are
+   recorded both on the render thread (requests, messages sent to the worker, applying
+   results) and on the worker (layout, dependencies, placement).
+
+   Each stage is traced as a pair of begin and end events. An end event completes the most
+   recent begin event of the same stage, unless that stage has been ended since. Several
+   messages may be waiting in the worker's mailbox at once, so Queue events must also
+   match by correlation ID.
+*/
+class TileTrace : private util::noncopyable {
+public:
+    enum class Phase : uint8_t {
+        Begin,
+        End
+    };
+
+    class Event {
+    public:
+        TimePoint time;
+        uint64_t correlationID;
+        TileStage stage;
+        Phase phase;
+    };
+
+    static constexpr std::size_t capacity = 32;
+
+    explicit TileTrace(TileTracer* = nullptr);
+
+    void begin(TileStage, uint64_t correlationID = 0);
+    void end(TileStage, uint64_t correlationID = 0);
+
+    // Traces a stage for the lifetime of the scope.
+    class Scope : private util::noncopyable {
+    public:
+        Scope(TileTrace& trace_, TileStage stage_, uint64_t correlationID_ = 0)
+            : trace(trace_), stage(stage_), correlationID(correlationID_) {
+            trace.begin(stage, correlationID);
+        }
+
+        ~Scope() {
+            trace.end(stage, correlationID);
+        }
+
+    private:
+        TileTrace& trace;
+        const TileStage stage;
+        const uint64_t correlationID;
+    };
+
+    // Returns the recorded events, oldest first.
+    std::vector<Event> getEvents() const;
+
+    // Returns the duration of the most recently completed instance of the stage.
+    optional<Duration> getLastDuration(TileStage) const;
+
+private:
+    void record(TileStage, Phase, uint64_t correlationID);
+
+    TileTracer* const tracer;
+
+    mutable std::mutex mutex;
+    std::array<Event, capacity> events;
+    std::size_t size = 0;
+    std::size_t next = 0;
+    std::array<optional<Duration>, TileTimings::stageCount> lastDurations;
+};
+
+} // namespace mbgl
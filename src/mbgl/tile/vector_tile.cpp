@@ -17,12 +17,13 @@ void VectorTile::setNecessity(Necessity necessity) {
 }
 
 void VectorTile::setData(std::shared_ptr<const std::string> data_,
+                         bool compressed,
                          optional<Timestamp> modified_,
                          optional<Timestamp> expires_) {
     modified = modified_;
     expires = expires_;
 
-    GeometryTile::setData(data_ ? std::make_unique<VectorTileData>(data_) : nullptr);
+    GeometryTile::setData(data_ ? std::make_unique<VectorTileData>(data_, compressed) : nullptr);
 }
 
 } // namespace mbgl
@@ -17,6 +17,7 @@ public:
 
     void setNecessity(Necessity) final;
     void setData(std::shared_ptr<const std::string> data,
+                 bool compressed,
                  optional<Timestamp> modified,
                  optional<Timestamp> expires);
 
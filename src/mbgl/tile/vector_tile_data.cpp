@@ -1,11 +1,19 @@
 #include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/constants.hpp>
 
+#include <limits>
+
 namespace mbgl {
 
-VectorTileFeature::VectorTileFeature(const mapbox::vector_tile::layer& layer,
+VectorTileFeature::VectorTileFeature(const VectorTileLayer& layer_,
                                      const protozero::data_view& view)
-    : feature(view, layer) {
+    : layer(layer_),
+      feature(view, layer.layer) {
+    protozero::pbf_reader reader(view);
+    while (reader.next(2 /* tags */)) {
+        tags = reader.get_packed_uint32();
+    }
 }
 
 FeatureType VectorTileFeature::getType() const {
@@ -22,7 +30,28 @@ FeatureType VectorTileFeature::getType() const {
 }
 
 optional<Value> VectorTileFeature::getValue(const std::string& key) const {
-    return feature.getValue(key);
+    auto it = layer.tables->keyIndices.find(key);
+    if (it == layer.tables->keyIndices.end()) {
+        return {};
+    }
+    return getIndexedValue(it->second);
+}
+
+optional<Value> VectorTileFeature::getIndexedValue(std::size_t keyIndex) const {
+    for (auto it = tags.begin(); it != tags.end();) {
+        const std::size_t tagKey = *it++;
+        if (it == tags.end()) {
+            break;
+        }
+        const std::size_t tagValue = *it++;
+        if (tagKey == keyIndex) {
+            if (tagValue >= layer.tables->values.size()) {
+                return {};
+            }
+            return layer.tables->values[tagValue];
+        }
+    }
+    return {};
 }
 
 std::unordered_map<std::string, Value> VectorTileFeature::getProperties() const {
@@ -43,9 +72,61 @@ GeometryCollection VectorTileFeature::getGeometries() const {
     }
 }
 
+static Value parseValue(protozero::pbf_reader reader) {
+    Value value;
+    while (reader.next()) {
+        switch (reader.tag()) {
+        case 1: // string_value
+            value = reader.get_string();
+            break;
+        case 2: // float_value
+            value = static_cast<double>(reader.get_float());
+            break;
+        case 3: // double_value
+            value = reader.get_double();
+            break;
+        case 4: // int_value
+            value = static_cast<int64_t>(reader.get_int64());
+            break;
+        case 5: // uint_value
+            value = static_cast<uint64_t>(reader.get_uint64());
+            break;
+        case 6: // sint_value
+            value = static_cast<int64_t>(reader.get_sint64());
+            break;
+        case 7: // bool_value
+            value = reader.get_bool();
+            break;
+        default:
+            reader.skip();
+            break;
+        }
+    }
+    return value;
+}
+
+VectorTileLayer::Tables::Tables(const protozero::data_view& view) {
+    std::size_t keyCount = 0;
+    protozero::pbf_reader reader(view);
+    while (reader.next()) {
+        switch (reader.tag()) {
+        case 3: // keys
+            keyIndices.emplace(reader.get_string(), keyCount++);
+            break;
+        case 4: // values
+            values.push_back(parseValue(reader.get_message()));
+            break;
+        default:
+            reader.skip();
+            break;
+        }
+    }
+}
+
 VectorTileLayer::VectorTileLayer(std::shared_ptr<const std::string> data_,
-                                 const protozero::data_view& view)
-    : data(std::move(data_)), layer(view) {
+                                 const protozero::data_view& view,
+                                 std::shared_ptr<const Tables> tables_)
+    : data(std::move(data_)), layer(view), tables(std::move(tables_)) {
 }
 
 std::size_t VectorTileLayer::featureCount() const {
@@ -53,37 +134,64 @@ std::size_t VectorTileLayer::featureCount() const {
 }
 
 std::unique_ptr<GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i) const {
-    return std::make_unique<VectorTileFeature>(layer, layer.getFeature(i));
+    return std::make_unique<VectorTileFeature>(*this, layer.getFeature(i));
 }
 
 std::string VectorTileLayer::getName() const {
     return layer.getName();
 }
 
-VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_) : data(std::move(data_)) {
+optional<std::size_t> VectorTileLayer::getKeyIndex(const std::string& key) const {
+    auto it = tables->keyIndices.find(key);
+    if (it == tables->keyIndices.end()) {
+        // No feature can have this key, so return an index that no tag refers to.
+        return std::numeric_limits<std::size_t>::max();
+    }
+    return it->second;
+}
+
+VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_, bool compressed_)
+    : data(std::move(data_)), compressed(compressed_) {
 }
 
 std::unique_ptr<GeometryTileData> VectorTileData::clone() const {
-    return std::make_unique<VectorTileData>(data);
+    return std::make_unique<VectorTileData>(data, compressed);
+}
+
+const std::string& VectorTileData::getData() const {
+    if (compressed) {
+        data = std::make_shared<const std::string>(util::decompress(*data));
+        compressed = false;
+    }
+    return *data;
+}
+
+std::size_t VectorTileData::byteSize() const {
+    return data ? data->size() : 0;
 }
 
 std::unique_ptr<GeometryTileLayer> VectorTileData::getLayer(const std::string& name) const {
     if (!parsed) {
         // We're parsing this lazily so that we can construct VectorTileData objects on the main
         // thread without incurring the overhead of parsing immediately.
-        layers = mapbox::vector_tile::buffer(*data).getLayers();
+        layers = mapbox::vector_tile::buffer(getData()).getLayers();
         parsed = true;
     }
 
     auto it = layers.find(name);
-    if (it != layers.end()) {
-        return std::make_unique<VectorTileLayer>(data, it->second);
+    if (it == layers.end()) {
+        return nullptr;
+    }
+
+    auto& layerTables = tables[name];
+    if (!layerTables) {
+        layerTables = std::make_shared<VectorTileLayer::Tables>(it->second);
     }
-    return nullptr;
+    return std::make_unique<VectorTileLayer>(data, it->second, layerTables);
 }
 
 std::vector<std::string> VectorTileData::layerNames() const {
-    return mapbox::vector_tile::buffer(*data).layerNames();
+    return mapbox::vector_tile::buffer(getData()).layerNames();
 }
 
 } // namespace mbgl
@@ -9,46 +9,76 @@
 
 namespace mbgl {
 
+class VectorTileLayer;
+
 class VectorTileFeature : public GeometryTileFeature {
 public:
-    VectorTileFeature(const mapbox::vector_tile::layer&, const protozero::data_view&);
+    VectorTileFeature(const VectorTileLayer&, const protozero::data_view&);
 
     FeatureType getType() const override;
     optional<Value> getValue(const std::string& key) const override;
+    optional<Value> getIndexedValue(std::size_t) const override;
     std::unordered_map<std::string, Value> getProperties() const override;
     optional<FeatureIdentifier> getID() const override;
     GeometryCollection getGeometries() const override;
 
 private:
+    const VectorTileLayer& layer;
     mapbox::vector_tile::feature feature;
+
+    // Packed (key index, value index) pairs referring to the layer's key and value tables.
+    protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator> tags;
 };
 
 class VectorTileLayer : public GeometryTileLayer {
 public:
-    VectorTileLayer(std::shared_ptr<const std::string> data, const protozero::data_view&);
+    // The layer's key and value tables, decoded once and shared by all of its features.
+    class Tables {
+    public:
+        explicit Tables(const protozero::data_view&);
+
+        std::unordered_map<std::string, std::size_t> keyIndices;
+        std::vector<Value> values;
+    };
+
+    VectorTileLayer(std::shared_ptr<const std::string> data,
+                    const protozero::data_view&,
+                    std::shared_ptr<const Tables>);
 
     std::size_t featureCount() const override;
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override;
     std::string getName() const override;
+    optional<std::size_t> getKeyIndex(const std::string&) const override;
 
 private:
+    friend class VectorTileFeature;
+
     std::shared_ptr<const std::string> data;
     mapbox::vector_tile::layer layer;
+    std::shared_ptr<const Tables> tables;
 };
 
 class VectorTileData : public GeometryTileData {
 public:
-    VectorTileData(std::shared_ptr<const std::string> data);
+    // `compressed` data is inflated on first use, i.e. on the worker thread that parses it.
+    VectorTileData(std::shared_ptr<const std::string> data, bool compressed = false);
 
     std::unique_ptr<GeometryTileData> clone() const override;
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override;
+    std::size_t byteSize() const override;
 
     std::vector<std::string> layerNames() const;
 
 private:
-    std::shared_ptr<const std::string> data;
+    const std::string& getData() const;
+
+    mutable std::shared_ptr<const std::string> data;
+    mutable bool compressed;
     mutable bool parsed = false;
     mutable std::map<std::string, const protozero::data_view> layers;
+
+    // Tables of the layers returned so far, so that asking for a layer again doesn't decode them.
+    mutable std::unordered_map<std::string, std::shared_ptr<const VectorTileLayer::Tables>> tables;
 };
 
 } // namespace mbgl
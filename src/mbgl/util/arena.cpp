@@ -0,0 +1,57 @@
+#include <mbgl/util/arena.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mbgl {
+
+Arena::Arena(std::size_t initialBlockSize_)
+    : initialBlockSize(initialBlockSize_) {
+}
+
+void* Arena::allocate(std::size_t size, std::size_t alignment) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+    assert(alignment <= alignof(std::max_align_t));
+
+    allocations++;
+    used += size;
+
+    // Blocks come from `new char[]`, which aligns them for any fundamental type, so aligning
+    // offsets within a block is enough.
+    if (!blocks.empty()) {
+        const std::size_t start = (offset + alignment - 1) & ~(alignment - 1);
+        if (start + size <= blocks.back().size) {
+            offset = start + size;
+            return blocks.back().data.get() + start;
+        }
+    }
+
+    // Grow geometrically, so that the number of blocks stays logarithmic in the total size.
+    const std::size_t blockSize = std::max(blocks.empty() ? initialBlockSize : blocks.back().size * 2, size);
+    blocks.push_back({ std::unique_ptr<char[]>(new char[blockSize]), blockSize });
+    offset = size;
+    return blocks.back().data.get();
+}
+
+void Arena::reset() {
+    // The last block is the largest one.
+    if (blocks.size() > 1) {
+        Block last = std::move(blocks.back());
+        blocks.clear();
+        blocks.push_back(std::move(last));
+    }
+
+    offset = 0;
+    allocations = 0;
+    used = 0;
+}
+
+std::size_t Arena::capacity() const {
+    std::size_t result = 0;
+    for (const auto& block : blocks) {
+        result += block.size;
+    }
+    return result;
+}
+
+} // namespace mbgl
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+
+/*
+   A monotonic allocator for temporaries that don't outlive a layout pass, such as the
+   polygons produced by `classifyRings()` or the triangles of a single line.
+
+   Allocations bump a pointer into the current block and are never freed individually.
+   `reset()` releases everything at once and keeps the largest block, so that a layout
+   pass that resets the arena after every layer reuses the same memory for all of them.
+*/
+class Arena : private util::noncopyable {
+public:
+    explicit Arena(std::size_t initialBlockSize = 16 * 1024);
+
+    // `alignment` must be a power of two no larger than `alignof(std::max_align_t)`.
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    void reset();
+
+    // Number of allocations and bytes handed out since the last reset.
+    std::size_t allocationCount() const { return allocations; }
+    std::size_t bytesAllocated() const { return used; }
+
+    // Bytes of blocks currently held by the arena.
+    std::size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    const std::size_t initialBlockSize;
+    std::vector<Block> blocks;
+    std::size_t offset = 0;
+    std::size_t allocations = 0;
+    std::size_t used = 0;
+};
+
+// A standard allocator that allocates from an `Arena`. Deallocation is a no-op.
+template <class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(Arena& arena_) : arena(&arena_) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) {}
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return arena != other.arena;
+    }
+
+private:
+    template <class U>
+    friend class ArenaAllocator;
+
+    Arena* arena;
+};
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace mbgl
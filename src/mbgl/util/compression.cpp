@@ -1,10 +1,16 @@
 #include <mbgl/util/compression.hpp>
+#include <mbgl/util/noncopyable.hpp>
 
 #include <zlib.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <vector>
 
 // Check zlib library version.
 const static bool zlibVersionCheck __attribute__((unused)) = []() {
@@ -27,74 +33,191 @@ namespace util {
 // cause a link error.
 #undef compress
 
-std::string compress(const std::string &raw) {
-    z_stream deflate_stream;
-    memset(&deflate_stream, 0, sizeof(deflate_stream));
+namespace {
 
-    // TODO: reuse z_streams
-    if (deflateInit(&deflate_stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
-        throw std::runtime_error("failed to initialize deflate");
+class DeflateStream : private util::noncopyable {
+public:
+    DeflateStream() {
+        memset(&stream, 0, sizeof(stream));
+        if (deflateInit(&stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+            throw std::runtime_error("failed to initialize deflate");
+        }
     }
 
-    deflate_stream.next_in = (Bytef *)raw.data();
-    deflate_stream.avail_in = uInt(raw.size());
+    ~DeflateStream() {
+        deflateEnd(&stream);
+    }
 
-    std::string result;
-    char out[16384];
+    void reset() {
+        deflateReset(&stream);
+    }
 
-    int code;
-    do {
-        deflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        deflate_stream.avail_out = sizeof(out);
-        code = deflate(&deflate_stream, Z_FINISH);
-        if (result.size() < deflate_stream.total_out) {
-            // append the block to the output string
-            result.append(out, deflate_stream.total_out - result.size());
+    z_stream stream;
+};
+
+class InflateStream : private util::noncopyable {
+public:
+    // By default, detect zlib and gzip headers automatically: the cache stores zlib data that
+    // it compressed itself as well as gzip data as it was received from servers.
+    explicit InflateStream(int windowBits = MAX_WBITS + 32) {
+        memset(&stream, 0, sizeof(stream));
+        if (inflateInit2(&stream, windowBits) != Z_OK) {
+            throw std::runtime_error("failed to initialize inflate");
         }
-    } while (code == Z_OK);
+    }
+
+    ~InflateStream() {
+        inflateEnd(&stream);
+    }
 
-    deflateEnd(&deflate_stream);
+    void reset() {
+        inflateReset(&stream);
+    }
 
-    if (code != Z_STREAM_END) {
-        throw std::runtime_error(deflate_stream.msg);
+    z_stream stream;
+};
+
+// Setting up a z_stream allocates its window and (for deflate) several hundred kilobytes of
+// state, so streams are reset and reused rather than initialized for every call. Compression
+// runs on a handful of threads at most, which is all the streams a pool keeps around.
+template <class Stream>
+class StreamPool : private util::noncopyable {
+public:
+    std::unique_ptr<Stream> acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!streams.empty()) {
+                auto stream = std::move(streams.back());
+                streams.pop_back();
+                return stream;
+            }
+        }
+        return std::make_unique<Stream>();
     }
 
-    return result;
+    void release(std::unique_ptr<Stream> stream) {
+        stream->reset();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (streams.size() < 4) {
+            streams.push_back(std::move(stream));
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Stream>> streams;
+};
+
+StreamPool<DeflateStream>& deflatePool() {
+    static StreamPool<DeflateStream> pool;
+    return pool;
 }
 
-std::string decompress(const std::string &raw) {
-    z_stream inflate_stream;
-    memset(&inflate_stream, 0, sizeof(inflate_stream));
+StreamPool<InflateStream>& inflatePool() {
+    static StreamPool<InflateStream> pool;
+    return pool;
+}
 
-    // TODO: reuse z_streams
-    if (inflateInit(&inflate_stream) != Z_OK) {
-        throw std::runtime_error("failed to initialize inflate");
+// gzip data ends with its inflated length modulo 2^32, which lets us allocate the output
+// exactly. zlib data doesn't record it, so we start from a typical ratio for tiles instead.
+std::size_t inflatedSizeHint(const std::string& raw) {
+    const auto bytes = reinterpret_cast<const uint8_t*>(raw.data());
+    if (raw.size() >= 18 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+        const uint8_t* trailer = bytes + raw.size() - 4;
+        const std::size_t size = std::size_t(trailer[0]) | std::size_t(trailer[1]) << 8 |
+                                 std::size_t(trailer[2]) << 16 | std::size_t(trailer[3]) << 24;
+        // deflate can't compress better than about 1:1032; anything beyond that is corrupt
+        // or has wrapped around.
+        if (size > 0 && size / 1032 <= raw.size()) {
+            // One more byte lets inflate reach the end of the stream without growing the output.
+            return size + 1;
+        }
     }
+    return std::max<std::size_t>(raw.size() * 4, 1024);
+}
 
-    inflate_stream.next_in = (Bytef *)raw.data();
-    inflate_stream.avail_in = uInt(raw.size());
+std::string inflateAll(z_stream& stream, const std::string& raw) {
+    stream.next_in = (Bytef *)raw.data();
+    stream.avail_in = uInt(raw.size());
 
-    std::string result;
-    char out[15384];
+    const std::size_t hint = inflatedSizeHint(raw);
+    std::string result(hint, '\0');
 
-    int code;
-    do {
-        inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        inflate_stream.avail_out = sizeof(out);
-        code = inflate(&inflate_stream, 0);
-        // result.append(out, sizeof(out) - inflate_stream.avail_out);
-        if (result.size() < inflate_stream.total_out) {
-            result.append(out, inflate_stream.total_out - result.size());
+    int code = Z_OK;
+    while (code == Z_OK) {
+        if (stream.total_out == result.size()) {
+            result.resize(result.size() * 2);
         }
-    } while (code == Z_OK);
-
-    inflateEnd(&inflate_stream);
+        stream.next_out = reinterpret_cast<Bytef *>(&result[stream.total_out]);
+        stream.avail_out = uInt(result.size() - stream.total_out);
+        code = inflate(&stream, Z_NO_FLUSH);
+    }
 
     if (code != Z_STREAM_END) {
-        throw std::runtime_error(inflate_stream.msg ? inflate_stream.msg : "decompression error");
+        throw std::runtime_error(stream.msg ? stream.msg : "decompression error");
+    }
+
+    const bool exact = stream.total_out + 1 == hint;
+    result.resize(stream.total_out);
+    if (!exact) {
+        // Don't hold on to the slack of a guessed or grown allocation; the result may be
+        // kept for as long as the tile is.
+        result.shrink_to_fit();
     }
 
     return result;
 }
+
+class ZlibCodec : public Codec {
+public:
+    std::string compress(const std::string& raw) const override {
+        auto deflater = deflatePool().acquire();
+        z_stream& stream = deflater->stream;
+
+        // deflateBound() guarantees that a single call with Z_FINISH completes the stream.
+        std::string result(deflateBound(&stream, uLong(raw.size())), '\0');
+
+        stream.next_in = (Bytef *)raw.data();
+        stream.avail_in = uInt(raw.size());
+        stream.next_out = reinterpret_cast<Bytef *>(&result[0]);
+        stream.avail_out = uInt(result.size());
+
+        if (deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+            throw std::runtime_error(stream.msg ? stream.msg : "compression error");
+        }
+
+        result.resize(stream.total_out);
+        deflatePool().release(std::move(deflater));
+        return result;
+    }
+
+    std::string decompress(const std::string& raw) const override {
+        auto inflater = inflatePool().acquire();
+        std::string result = inflateAll(inflater->stream, raw);
+        inflatePool().release(std::move(inflater));
+        return result;
+    }
+};
+
+} // namespace
+
+const Codec& zlib() {
+    static const ZlibCodec codec;
+    return codec;
+}
+
+std::string compress(const std::string& raw) {
+    return zlib().compress(raw);
+}
+
+std::string decompress(const std::string& raw) {
+    return zlib().decompress(raw);
+}
+
+std::string decompressRaw(const std::string& raw) {
+    InflateStream inflater(-MAX_WBITS);
+    return inflateAll(inflater.stream, raw);
+}
+
 } // namespace util
 } // namespace mbgl
@@ -76,6 +76,16 @@ std::vector<T> GridIndex<T>::query(const BBox& queryBBox) const {
 }
 
 
+template <class T>
+std::size_t GridIndex<T>::byteSize() const {
+    std::size_t result = elements.capacity() * sizeof(std::pair<T, BBox>) +
+                         cells.capacity() * sizeof(std::vector<size_t>);
+    for (const auto& cell : cells) {
+        result += cell.capacity() * sizeof(size_t);
+    }
+    return result;
+}
+
 template <class T>
 int32_t GridIndex<T>::convertToCellCoord(int32_t x) const {
     return util::max(0.0, util::min(d - 1.0, std::floor(x * scale) + padding));
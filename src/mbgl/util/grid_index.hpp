@@ -19,6 +19,9 @@ public:
     void insert(T&& t, const BBox&);
     std::vector<T> query(const BBox&) const;
 
+    // Bytes of storage allocated by the index itself, excluding memory owned by elements.
+    std::size_t byteSize() const;
+
 private:
     int32_t convertToCellCoord(int32_t x) const;
 
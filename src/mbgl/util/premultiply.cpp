@@ -2,9 +2,49 @@
 
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace mbgl {
 namespace util {
 
+// Computes (c * a + 127) / 255, i.e. c * a / 255 rounded to the nearest integer, without a
+// division. The result is exact for all 8 bit values of c and a.
+static inline uint8_t multiplyAlpha(uint32_t c, uint32_t a) {
+    const uint32_t t = c * a + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+#if defined(__SSE2__)
+// Premultiplies four pixels at a time, with the same arithmetic as multiplyAlpha(). Returns
+// the number of bytes processed; the remaining pixels are left to the scalar loop.
+static size_t premultiplySSE2(uint8_t* data, size_t bytes) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+    // Premultiplies two pixels, widened to 16 bits per channel.
+    auto premultiplyPixels = [&] (__m128i pixels) {
+        __m128i alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+        alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i t = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), bias);
+        t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        return _mm_or_si128(_mm_andnot_si128(alphaMask, t), _mm_and_si128(alphaMask, pixels));
+    };
+
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i* ptr = reinterpret_cast<__m128i*>(data + i);
+        const __m128i pixels = _mm_loadu_si128(ptr);
+        const __m128i lo = premultiplyPixels(_mm_unpacklo_epi8(pixels, zero));
+        const __m128i hi = premultiplyPixels(_mm_unpackhi_epi8(pixels, zero));
+        _mm_storeu_si128(ptr, _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+#endif
+
 PremultipliedImage premultiply(UnassociatedImage&& src) {
     PremultipliedImage dst;
 
@@ -13,14 +53,18 @@ PremultipliedImage premultiply(UnassociatedImage&& src) {
     dst.data = std::move(src.data);
 
     uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    i = premultiplySSE2(data, dst.bytes());
+#endif
+    for (; i < dst.bytes(); i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
         uint8_t& a = data[i + 3];
-        r = (r * a + 127) / 255;
-        g = (g * a + 127) / 255;
-        b = (b * a + 127) / 255;
+        r = multiplyAlpha(r, a);
+        g = multiplyAlpha(g, a);
+        b = multiplyAlpha(b, a);
     }
 
     return dst;
@@ -404,3 +404,62 @@ TEST(GenerateClipIDs, SecondSourceHasParentOfFirstSource) {
               }),
               clipIDs);
 }
+
+TEST(GenerateClipIDs, OverlappingOtherZoomLevels) {
+    std::vector<Renderable> renderables{
+        // Neighbours at the same zoom level.
+        Renderable{ UnwrappedTileID{ 3, 0, 0 }, {} },
+        Renderable{ UnwrappedTileID{ 3, 1, 0 }, {} },
+        // Touches the corner of 3/1/0.
+        Renderable{ UnwrappedTileID{ 4, 4, 2 }, {} },
+        // Would touch the edge of 3/0/0, but isn't used.
+        Renderable{ UnwrappedTileID{ 4, 0, 2 }, {}, false },
+        // Shares its canonical ID with 4/0/0, but lies in the next world copy.
+        Renderable{ UnwrappedTileID{ 4, 16, 0 }, {} },
+    };
+
+    const auto overlapping = algorithm::overlappingOtherZoomLevels<Renderable>({ renderables.begin(), renderables.end() });
+
+    std::vector<UnwrappedTileID> ids;
+    for (const auto& renderable : overlapping) {
+        ids.push_back(renderable.get().id);
+    }
+    EXPECT_EQ(std::vector<UnwrappedTileID>({ UnwrappedTileID{ 3, 1, 0 }, UnwrappedTileID{ 4, 4, 2 } }), ids);
+}
+
+TEST(ClipIDCache, RestoresUnchangedRenderables) {
+    std::vector<Renderable> renderables{
+        Renderable{ UnwrappedTileID{ 0, 0, 0 }, {} },
+        Renderable{ UnwrappedTileID{ 1, 0, 0 }, {} },
+    };
+    renderables.reserve(3); // Keep references stable when adding a tile below.
+    std::vector<std::reference_wrapper<Renderable>> group{ renderables.begin(), renderables.end() };
+
+    algorithm::ClipIDCache cache;
+    EXPECT_FALSE(cache.restore<Renderable>({ group }));
+
+    algorithm::ClipIDGenerator generator;
+    generator.update(group);
+    cache.store<Renderable>({ group }, generator.getClipIDs());
+
+    const auto generated = renderables;
+    for (auto& renderable : renderables) {
+        renderable.clip = {};
+    }
+
+    EXPECT_TRUE(cache.restore<Renderable>({ group }));
+    EXPECT_EQ(generated, renderables);
+    EXPECT_EQ(generator.getClipIDs(), cache.getClipIDs());
+
+    // A different set of tiles invalidates the cache.
+    renderables.emplace_back(UnwrappedTileID{ 1, 0, 1 }, ClipID{});
+    EXPECT_FALSE(cache.restore<Renderable>({ { renderables.begin(), renderables.end() } }));
+
+    // So does a change in which tiles are used, or in how they are grouped by source.
+    renderables.pop_back();
+    renderables[1].used = false;
+    EXPECT_FALSE(cache.restore<Renderable>({ group }));
+    renderables[1].used = true;
+    EXPECT_FALSE(cache.restore<Renderable>({ { renderables[0] }, { renderables[1] } }));
+    EXPECT_TRUE(cache.restore<Renderable>({ group }));
+}
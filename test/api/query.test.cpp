@@ -1,4 +1,5 @@
 #include <mbgl/map/map.hpp>
+#include <mbgl/actor/actor.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/test/stub_file_source.hpp>
 #include <mbgl/test/util.hpp>
@@ -8,11 +9,18 @@
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
 #include <mbgl/style/source.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/gl/headless_frontend.hpp>
 
+#include <chrono>
+#include <future>
+#include <thread>
+
 using namespace mbgl;
 using namespace mbgl::style;
+using namespace std::chrono_literals;
 
 namespace {
 
@@ -83,6 +91,60 @@ TEST(Query, QueryRenderedFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QueryRenderedFeaturesAsync) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({ 0, 0 });
+    auto& renderer = *test.frontend.getRenderer();
+    const std::vector<RenderedQueryOptions> queries {
+        {},
+        {{{ "layer1", "layer2" }}, {}},
+        {{}, { EqualsFilter { "key1", std::string("value1") } }}
+    };
+
+    std::size_t pending = queries.size() + 1;
+    for (const auto& options : queries) {
+        const auto expected = renderer.queryRenderedFeatures(zz, options);
+        renderer.queryRenderedFeatures(zz, options, [&, expected] (std::vector<Feature> features) {
+            EXPECT_EQ(expected.size(), features.size());
+            for (std::size_t i = 0; i < std::min(expected.size(), features.size()); i++) {
+                EXPECT_EQ(expected[i].properties, features[i].properties);
+            }
+            if (--pending == 0) {
+                test.loop.stop();
+            }
+        });
+    }
+
+    renderer.queryRenderedFeatures(test.map.pixelForLatLng({ 9, 9 }), {}, [&] (std::vector<Feature> features) {
+        EXPECT_TRUE(features.empty());
+        if (--pending == 0) {
+            test.loop.stop();
+        }
+    });
+
+    test.loop.run();
+    EXPECT_EQ(0u, pending);
+}
+
+TEST(Query, QueryRenderedFeatureHandles) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({ 0, 0 });
+    auto& renderer = *test.frontend.getRenderer();
+
+    auto features = renderer.queryRenderedFeatures(zz);
+    auto handles = renderer.queryRenderedFeatureHandles(zz);
+    ASSERT_EQ(features.size(), handles.size());
+    for (std::size_t i = 0; i < features.size(); i++) {
+        EXPECT_EQ(features[i].id, handles[i].getID());
+        EXPECT_EQ(features[i].properties, handles[i].getProperties());
+        EXPECT_EQ(features[i].geometry, handles[i].getGeometry());
+    }
+
+    EXPECT_TRUE(renderer.queryRenderedFeatureHandles(test.map.pixelForLatLng({ 9, 9 })).empty());
+}
+
 TEST(Query, QuerySourceFeatures) {
     QueryTest test;
 
@@ -122,3 +184,137 @@ TEST(Query, QuerySourceFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QuerySourceFeaturesDeduplicate) {
+    QueryTest test;
+
+    // At zoom 1, the point at 0,0 lies on the corner of four tiles, and is part of each.
+    test.map.setZoom(1);
+    test.frontend.render(test.map);
+
+    auto features1 = test.frontend.getRenderer()->querySourceFeatures("source4");
+    EXPECT_GT(features1.size(), 1u);
+
+    SourceQueryOptions options;
+    options.deduplicate = true;
+    auto features2 = test.frontend.getRenderer()->querySourceFeatures("source4", options);
+    ASSERT_EQ(features2.size(), 1u);
+    EXPECT_EQ(*features2[0].id, FeatureIdentifier(std::string("feature1")));
+
+    options.deduplicate = false;
+    options.limit = 2;
+    auto features3 = test.frontend.getRenderer()->querySourceFeatures("source4", options);
+    EXPECT_EQ(features3.size(), 2u);
+}
+
+TEST(Query, QuerySourceFeaturesDeduplicateLimit) {
+    QueryTest test;
+
+    // Feature "a" has a part at 0,0, which lies in all four zoom 1 tiles, and a second part in
+    // the north-west tile only. Feature "b" lies in the north-west tile after both parts of "a".
+    auto feature = [] (Point<double> point, std::string id) {
+        Feature result { point };
+        result.id = FeatureIdentifier(std::move(id));
+        return result;
+    };
+    FeatureCollection collection {
+        feature({ 0, 0 }, "a"),
+        feature({ -1, 1 }, "a"),
+        feature({ -10, 10 }, "b")
+    };
+
+    auto source = std::make_unique<GeoJSONSource>("source7");
+    source->setGeoJSON(collection);
+    test.map.getStyle().addSource(std::move(source));
+    test.map.getStyle().addLayer(std::make_unique<CircleLayer>("layer7", "source7"));
+    test.map.setZoom(1);
+    test.frontend.render(test.map);
+
+    SourceQueryOptions options;
+    options.deduplicate = true;
+    options.limit = 2;
+    auto features = test.frontend.getRenderer()->querySourceFeatures("source7", options);
+    ASSERT_EQ(features.size(), 2u);
+    EXPECT_EQ(*features[0].id, FeatureIdentifier(std::string("a")));
+    EXPECT_EQ(*features[1].id, FeatureIdentifier(std::string("b")));
+}
+
+TEST(Query, QuerySourceFeaturesWhileThreadPoolBusy) {
+    QueryTest test;
+
+    test.map.setZoom(1);
+    test.frontend.render(test.map);
+
+    // Occupy every thread of the pool with work that doesn't depend on this thread. The query
+    // has to wait for that work to finish, but its workers never wait on this thread, so a
+    // busy pool delays a synchronous query without deadlocking it.
+    struct Blocker {
+        Blocker(ActorRef<Blocker>) {}
+        void block(std::promise<void> entered, std::shared_future<void> released) {
+            entered.set_value();
+            released.wait();
+        }
+    };
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::vector<std::unique_ptr<Actor<Blocker>>> blockers;
+    for (std::size_t i = 0; i < test.threadPool.concurrency(); i++) {
+        std::promise<void> entered;
+        std::future<void> hasEntered = entered.get_future();
+        blockers.push_back(std::make_unique<Actor<Blocker>>(test.threadPool));
+        blockers.back()->invoke(&Blocker::block, std::move(entered), released);
+        hasEntered.wait();
+    }
+
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(100ms);
+        release.set_value();
+    });
+
+    auto features = test.frontend.getRenderer()->querySourceFeatures("source4");
+    EXPECT_EQ(std::future_status::ready, released.wait_for(0ms));
+    EXPECT_GT(features.size(), 1u);
+
+    releaser.join();
+}
+
+TEST(Query, QuerySourceFeaturesBounds) {
+    QueryTest test;
+
+    SourceQueryOptions options;
+    options.bounds = LatLngBounds::hull({ -1, -1 }, { 1, 1 });
+    auto features1 = test.frontend.getRenderer()->querySourceFeatures("source4", options);
+    EXPECT_EQ(features1.size(), 1u);
+
+    options.bounds = LatLngBounds::hull({ 10, 10 }, { 20, 20 });
+    auto features2 = test.frontend.getRenderer()->querySourceFeatures("source4", options);
+    EXPECT_EQ(features2.size(), 0u);
+}
+
+TEST(Query, QuerySourceFeaturesProperties) {
+    QueryTest test;
+    auto& renderer = *test.frontend.getRenderer();
+
+    SourceQueryOptions options;
+    options.properties = {{ "key1", "key5" }};
+    auto features1 = renderer.querySourceFeatures("source4", options);
+    ASSERT_EQ(features1.size(), 1u);
+    EXPECT_EQ(features1[0].properties, PropertyMap({{ "key1", std::string("value1") }}));
+    EXPECT_TRUE(features1[0].geometry.is<Point<double>>());
+
+    options.properties = std::vector<std::string>();
+    options.includeGeometry = false;
+    auto features2 = renderer.querySourceFeatures("source4", options);
+    ASSERT_EQ(features2.size(), 1u);
+    EXPECT_TRUE(features2[0].properties.empty());
+    ASSERT_TRUE(features2[0].geometry.is<mapbox::geometry::geometry_collection<double>>());
+    EXPECT_TRUE(features2[0].geometry.get<mapbox::geometry::geometry_collection<double>>().empty());
+    EXPECT_EQ(*features2[0].id, FeatureIdentifier(std::string("feature1")));
+
+    auto handles = renderer.querySourceFeatureHandles("source4");
+    ASSERT_EQ(handles.size(), 1u);
+    EXPECT_EQ(*handles[0].getID(), FeatureIdentifier(std::string("feature1")));
+    EXPECT_EQ(*handles[0].getValue("key2"), Value(1.5));
+    EXPECT_FALSE(handles[0].getValue("key5"));
+    EXPECT_EQ(handles[0].getProperties().size(), 4u);
+}
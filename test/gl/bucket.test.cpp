@@ -37,6 +37,7 @@ using namespace mbgl;
 namespace {
 
 PropertyMap properties;
+Arena arena;
 
 } // namespace
 
@@ -47,7 +48,7 @@ TEST(Buckets, CircleBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 
     GeometryCollection point { { { 0, 0 } } };
-    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Point, point, properties }, point);
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Point, point, properties }, point, arena);
     ASSERT_TRUE(bucket.hasData());
     ASSERT_TRUE(bucket.needsUpload());
 
@@ -63,10 +64,15 @@ TEST(Buckets, FillBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 
     GeometryCollection polygon { { { 0, 0 }, { 0, 1 }, { 1, 1 } } };
-    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, polygon, properties }, polygon);
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, polygon, properties }, polygon, arena);
     ASSERT_TRUE(bucket.hasData());
     ASSERT_TRUE(bucket.needsUpload());
 
+    BucketMemoryUsage usage = bucket.getMemoryUsage();
+    EXPECT_EQ(bucket.vertices.byteSize(), usage.vertexBytes);
+    EXPECT_EQ(bucket.lines.byteSize() + bucket.triangles.byteSize(), usage.indexBytes);
+    EXPECT_EQ(0u, usage.paintAttributeBytes);
+
     bucket.upload(context);
     ASSERT_FALSE(bucket.needsUpload());
 }
@@ -79,11 +85,11 @@ TEST(Buckets, LineBucket) {
 
     // Ignore invalid feature type.
     GeometryCollection point { { { 0, 0 } } };
-    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Point, point, properties }, point);
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Point, point, properties }, point, arena);
     ASSERT_FALSE(bucket.hasData());
 
     GeometryCollection line { { { 0, 0 }, { 1, 1 } } };
-    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::LineString, line, properties }, line);
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::LineString, line, properties }, line, arena);
     ASSERT_TRUE(bucket.hasData());
     ASSERT_TRUE(bucket.needsUpload());
 
@@ -106,7 +112,7 @@ TEST(Buckets, SymbolBucket) {
 
     // SymbolBucket::addFeature() is a no-op.
     GeometryCollection point { { { 0, 0 } } };
-    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Point, point, properties }, point);
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Point, point, properties }, point, arena);
     ASSERT_FALSE(bucket.hasData());
     ASSERT_FALSE(bucket.needsUpload());
 
@@ -135,6 +141,23 @@ TEST(Buckets, RasterBucket) {
     ASSERT_TRUE(bucket.needsUpload());
 }
 
+TEST(Buckets, RasterBucketReleaseImage) {
+    gl::Context context;
+    RasterBucket bucket = { PremultipliedImage({ 1, 1 }) };
+    bucket.upload(context);
+
+    bucket.releaseImage();
+    EXPECT_FALSE(bucket.image);
+    EXPECT_EQ(0u, bucket.getMemoryUsage().imageBytes);
+
+    // The bucket keeps drawing from its texture, and uploads new buffers when its mask changes.
+    EXPECT_TRUE(bucket.hasData());
+    bucket.setMask({ CanonicalTileID{ 1, 0, 0 } });
+    ASSERT_TRUE(bucket.needsUpload());
+    bucket.upload(context);
+    EXPECT_FALSE(bucket.needsUpload());
+}
+
 TEST(Buckets, RasterBucketMaskEmpty) {
     RasterBucket bucket{ nullptr };
     bucket.setMask({});
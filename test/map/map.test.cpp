@@ -6,6 +6,8 @@
 #include <mbgl/map/map.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/headless_frontend.hpp>
+#include <mbgl/renderer/renderer.hpp>
+#include <mbgl/renderer/frame_profile.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/storage/default_file_source.hpp>
@@ -17,6 +19,7 @@
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
 #include <mbgl/style/layers/background_layer.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
 #include <mbgl/util/color.hpp>
 
 using namespace mbgl;
@@ -55,11 +58,18 @@ public:
         }
     }
 
+    void onDidFinishRenderingStill(std::size_t coalescedRequests, Duration latency) final {
+        if (didFinishRenderingStill) {
+            didFinishRenderingStill(coalescedRequests, latency);
+        }
+    }
+
     std::function<void()> onWillStartLoadingMapCallback;
     std::function<void()> onDidFinishLoadingMapCallback;
     std::function<void()> didFailLoadingMapCallback;
     std::function<void()> didFinishLoadingStyleCallback;
     std::function<void(RenderMode)> didFinishRenderingFrame;
+    std::function<void(std::size_t, Duration)> didFinishRenderingStill;
 };
 
 template <class FileSource = StubFileSource>
@@ -420,6 +430,213 @@ TEST(Map, AddLayer) {
     test::checkImage("test/fixtures/map/add_layer", test.frontend.render(test.map));
 }
 
+TEST(Map, RenderPNG) {
+    MapTest<> test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    auto layer = std::make_unique<BackgroundLayer>("background");
+    layer->setBackgroundColor({ { 1, 0, 0, 1 } });
+    test.map.getStyle().addLayer(std::move(layer));
+
+    // Queue up more renders than there are encoders, so that encoding overlaps rendering.
+    auto first = test.frontend.renderPNG(test.map);
+    auto second = test.frontend.renderPNG(test.map);
+    auto third = test.frontend.renderPNG(test.map);
+
+    const std::string png = first.get();
+    test::checkImage("test/fixtures/map/add_layer", decodeImage(png));
+    EXPECT_EQ(png, second.get());
+    EXPECT_EQ(png, third.get());
+}
+
+TEST(Map, SharedBackend) {
+    util::RunLoop runLoop;
+    StubFileSource fileSource;
+    ThreadPool threadPool { 4 };
+    auto backend = std::make_shared<HeadlessBackend>();
+
+    auto addBackground = [](Map& map, Color color) {
+        map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+        auto layer = std::make_unique<BackgroundLayer>("background");
+        layer->setBackgroundColor({ color });
+        map.getStyle().addLayer(std::move(layer));
+    };
+
+    HeadlessFrontend frontendA { { 256, 256 }, 1, fileSource, threadPool, backend };
+    Map mapA(frontendA, MapObserver::nullObserver(), frontendA.getSize(), 1, fileSource, threadPool, MapMode::Still);
+    addBackground(mapA, { 1, 0, 0, 1 });
+
+    HeadlessFrontend frontendB { { 128, 64 }, 1, fileSource, threadPool, backend };
+    Map mapB(frontendB, MapObserver::nullObserver(), frontendB.getSize(), 1, fileSource, threadPool, MapMode::Still);
+    addBackground(mapB, { 0, 0, 1, 1 });
+
+    EXPECT_EQ(frontendA.getBackend(), frontendB.getBackend());
+
+    // Alternate between both maps; each render must resize the shared framebuffer back.
+    for (unsigned i = 0; i < 2; ++i) {
+        test::checkImage("test/fixtures/map/add_layer", frontendA.render(mapA));
+
+        auto image = frontendB.render(mapB);
+        EXPECT_EQ(Size(128, 64), image.size);
+        EXPECT_EQ(0, image.data[0]);
+        EXPECT_EQ(0, image.data[1]);
+        EXPECT_EQ(255, image.data[2]);
+        EXPECT_EQ(255, image.data[3]);
+    }
+}
+
+TEST(Map, CoalesceStillImageRequests) {
+    MapTest<> test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    unsigned renders = 0;
+    std::size_t coalesced = 0;
+    test.observer.didFinishRenderingStill = [&] (std::size_t coalescedRequests, Duration latency) {
+        renders++;
+        coalesced = coalescedRequests;
+        EXPECT_GE(latency, Duration::zero());
+    };
+
+    unsigned completed = 0;
+    auto callback = [&] (std::exception_ptr error) {
+        EXPECT_FALSE(error);
+        completed++;
+    };
+
+    test.map.renderStill(callback);
+    test.map.renderStill(callback);
+    test.map.renderStill(callback);
+
+    while (completed < 3) {
+        test.runLoop.runOnce();
+    }
+
+    EXPECT_EQ(1u, renders);
+    EXPECT_EQ(3u, coalesced);
+}
+
+TEST(Map, StillImageRequestsAfterCameraChange) {
+    MapTest<> test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    std::vector<std::size_t> coalesced;
+    test.observer.didFinishRenderingStill = [&] (std::size_t coalescedRequests, Duration) {
+        coalesced.push_back(coalescedRequests);
+    };
+
+    unsigned completed = 0;
+    auto callback = [&] (std::exception_ptr error) {
+        EXPECT_FALSE(error);
+        completed++;
+    };
+
+    test.map.renderStill(callback);
+    test.map.setZoom(2);
+    test.map.renderStill(callback);
+    test.map.renderStill(callback);
+
+    while (completed < 3) {
+        test.runLoop.runOnce();
+    }
+
+    // The second and third requests share a render, which starts after the first one finished.
+    EXPECT_EQ(std::vector<std::size_t>({ 1, 2 }), coalesced);
+}
+
+TEST(Map, StillImageRequestsRenderTheirOwnState) {
+    MapTest<> test;
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    auto layer = std::make_unique<BackgroundLayer>("background");
+    layer->setBackgroundColor({ Color::red() });
+    test.map.getStyle().addLayer(std::move(layer));
+
+    std::vector<PremultipliedImage> images;
+    auto callback = [&] (std::exception_ptr error) {
+        EXPECT_FALSE(error);
+        images.push_back(test.frontend.readStillImage());
+    };
+
+    // The change is made before the first request renders, but belongs to the second request.
+    test.map.renderStill(callback);
+    test.map.getStyle().getLayer("background")->as<BackgroundLayer>()->setBackgroundColor({ Color::blue() });
+    test.map.renderStill(callback);
+
+    while (images.size() < 2) {
+        test.runLoop.runOnce();
+    }
+
+    EXPECT_EQ(255, images[0].data[0]);
+    EXPECT_EQ(0, images[0].data[2]);
+    EXPECT_EQ(0, images[1].data[0]);
+    EXPECT_EQ(255, images[1].data[2]);
+}
+
+TEST(Map, OpaqueFillOcclusion) {
+    MapTest<> test;
+
+    // Two opaque fills with a polygon covering the whole world, on top of a background layer.
+    test.map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "world": {
+          "type": "geojson",
+          "data": {
+            "type": "Polygon",
+            "coordinates": [ [ [ -180, -89 ], [ 180, -89 ], [ 180, 89 ], [ -180, 89 ], [ -180, -89 ] ] ]
+          }
+        }
+      },
+      "layers": [
+        { "id": "background", "type": "background", "paint": { "background-color": "red" } },
+        { "id": "lower", "type": "fill", "source": "world", "paint": { "fill-color": "green", "fill-antialias": false } },
+        { "id": "upper", "type": "fill", "source": "world", "paint": { "fill-color": "blue", "fill-antialias": false } }
+      ]
+    })STYLE");
+
+    // Only the upper fill is visible.
+    auto image = test.frontend.render(test.map);
+    for (std::size_t i = 0; i < image.bytes(); i += 4) {
+        ASSERT_EQ(0, image.data[i]);
+        ASSERT_EQ(0, image.data[i + 1]);
+        ASSERT_EQ(255, image.data[i + 2]);
+        ASSERT_EQ(255, image.data[i + 3]);
+    }
+
+    std::vector<FrameProfile> profiles;
+    test.frontend.getRenderer()->setFrameProfiling([&] (const FrameProfile& profile) {
+        profiles.push_back(profile);
+    });
+
+    // Profiles with GPU timings are reported a few frames late, so only the last one of several
+    // frames is certain to reflect the current style.
+    auto lowerDrawCalls = [&] {
+        profiles.clear();
+        for (int i = 0; i < 10; i++) {
+            test.frontend.render(test.map);
+        }
+        EXPECT_FALSE(profiles.empty());
+        std::size_t drawCalls = 0;
+        for (const auto& span : profiles.back().spans) {
+            if (span.category == FrameProfile::Category::Layer && span.name == "lower") {
+                drawCalls += span.drawCalls;
+            }
+        }
+        return drawCalls;
+    };
+
+    // The upper fill covers every tile, so the lower fill isn't drawn at all. Its fragments would
+    // fail the depth test anyway, so this saves draw calls, not fragment shading or overdraw.
+    EXPECT_EQ(0u, lowerDrawCalls());
+
+    // A translated fill doesn't cover its tiles, so the lower fill is drawn again.
+    test.map.getStyle().getLayer("upper")->as<FillLayer>()->setFillTranslate(std::array<float, 2> {{ 1, 0 }});
+    EXPECT_LT(0u, lowerDrawCalls());
+}
+
 TEST(Map, WithoutVAOExtension) {
     MapTest<DefaultFileSource> test { ":memory:", "test/fixtures/api/assets" };
 
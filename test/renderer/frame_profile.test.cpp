@@ -0,0 +1,167 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_file_source.hpp>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/gl/headless_frontend.hpp>
+#include <mbgl/renderer/renderer.hpp>
+#include <mbgl/renderer/frame_profile.hpp>
+#include <mbgl/renderer/frame_profiler.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+TEST(FrameProfiler, Spans) {
+    std::vector<FrameProfile> profiles;
+    FrameProfiler profiler(nullptr, [&] (FrameProfile profile) {
+        profiles.push_back(std::move(profile));
+    });
+
+    profiler.beginFrame();
+    {
+        FrameProfiler::Scope pass(&profiler, FrameProfile::Category::Pass, "opaque");
+        FrameProfiler::Scope layer(&profiler, FrameProfile::Category::Layer, "water", true);
+    }
+    {
+        FrameProfiler::Scope source(&profiler, FrameProfile::Category::Source, "composite", true);
+    }
+    profiler.endFrame();
+
+    // Without timer queries, profiles are reported as soon as the frame ends.
+    ASSERT_EQ(1u, profiles.size());
+    const auto& spans = profiles[0].spans;
+    ASSERT_EQ(4u, spans.size());
+
+    EXPECT_EQ(FrameProfile::Category::Frame, spans[0].category);
+    EXPECT_EQ(FrameProfile::Category::Pass, spans[1].category);
+    EXPECT_EQ("opaque", spans[1].name);
+    EXPECT_EQ(FrameProfile::Category::Layer, spans[2].category);
+    EXPECT_EQ("water", spans[2].name);
+    EXPECT_EQ(FrameProfile::Category::Source, spans[3].category);
+    EXPECT_EQ("composite", spans[3].name);
+
+    // Nested spans lie within the span that contains them.
+    EXPECT_LE(spans[1].start, spans[2].start);
+    EXPECT_LE(spans[2].start + spans[2].duration, spans[1].start + spans[1].duration);
+    EXPECT_LE(spans[1].start + spans[1].duration, spans[3].start);
+    EXPECT_LE(spans[3].start + spans[3].duration, spans[0].duration);
+
+    for (const auto& span : spans) {
+        EXPECT_FALSE(bool(span.gpuDuration));
+        EXPECT_EQ(0u, span.drawCalls);
+    }
+}
+
+TEST(FrameProfiler, DrawCalls) {
+    std::vector<FrameProfile> profiles;
+    std::size_t drawCalls = 0;
+    FrameProfiler profiler(nullptr, [&] (FrameProfile profile) {
+        profiles.push_back(std::move(profile));
+    }, &drawCalls);
+
+    drawCalls = 5;
+    profiler.beginFrame();
+    drawCalls += 1;
+    {
+        FrameProfiler::Scope pass(&profiler, FrameProfile::Category::Pass, "opaque");
+        drawCalls += 2;
+        FrameProfiler::Scope layer(&profiler, FrameProfile::Category::Layer, "water");
+        drawCalls += 3;
+    }
+    profiler.endFrame();
+
+    // Spans count the draw calls made while they were open, including those of nested spans.
+    ASSERT_EQ(1u, profiles.size());
+    const auto& spans = profiles[0].spans;
+    ASSERT_EQ(3u, spans.size());
+    EXPECT_EQ(6u, spans[0].drawCalls);
+    EXPECT_EQ(5u, spans[1].drawCalls);
+    EXPECT_EQ(3u, spans[2].drawCalls);
+}
+
+TEST(FrameProfiler, Disabled) {
+    std::size_t profiles = 0;
+    FrameProfiler profiler(nullptr, [&] (FrameProfile) {
+        profiles++;
+    });
+
+    // Scopes without a profiler, or outside of a frame, record nothing.
+    {
+        FrameProfiler::Scope scope(nullptr, FrameProfile::Category::Pass, "opaque", true);
+    }
+    {
+        FrameProfiler::Scope scope(&profiler, FrameProfile::Category::Pass, "opaque", true);
+    }
+
+    EXPECT_EQ(0u, profiles);
+}
+
+TEST(FrameProfiler, Renderer) {
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    ThreadPool threadPool { 4 };
+    HeadlessFrontend frontend { 1, fileSource, threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, fileSource,
+              threadPool, MapMode::Still };
+
+    map.getStyle().loadJSON(util::read_file("test/fixtures/api/query_style.json"));
+
+    std::vector<FrameProfile> profiles;
+    frontend.getRenderer()->setFrameProfiling([&] (const FrameProfile& profile) {
+        profiles.push_back(profile);
+    });
+
+    // Profiles with GPU timings are reported once their queries complete, a few frames later.
+    for (int i = 0; i < 10 && profiles.empty(); i++) {
+        frontend.render(map);
+    }
+
+    ASSERT_FALSE(profiles.empty());
+    ASSERT_FALSE(profiles[0].spans.empty());
+    EXPECT_EQ(FrameProfile::Category::Frame, profiles[0].spans[0].category);
+    EXPECT_GT(profiles[0].spans[0].drawCalls, 0u);
+    EXPECT_NE(profiles[0].spans.end(), std::find_if(profiles[0].spans.begin(), profiles[0].spans.end(), [] (const auto& span) {
+        return span.category == FrameProfile::Category::Pass && span.name == "translucent";
+    }));
+
+    // No profiles are reported once profiling is disabled.
+    frontend.getRenderer()->setFrameProfiling({});
+    const std::size_t reported = profiles.size();
+    frontend.render(map);
+    EXPECT_EQ(reported, profiles.size());
+}
+
+TEST(FrameProfile, ChromeTrace) {
+    FrameProfile profile;
+    profile.start = TimePoint(Milliseconds(1000));
+    profile.spans.push_back({ FrameProfile::Category::Frame, "frame", Duration::zero(), Milliseconds(16), {}, 0 });
+    profile.spans.push_back({ FrameProfile::Category::Layer, "water", Milliseconds(2), Milliseconds(3), { Milliseconds(1) }, 12 });
+
+    FrameProfile next = profile;
+    next.start += Milliseconds(20);
+
+    JSDocument document;
+    document.Parse<0>(encodeChromeTrace({ profile, next }).c_str());
+    ASSERT_FALSE(document.HasParseError());
+
+    const JSValue& events = document["traceEvents"];
+    ASSERT_TRUE(events.IsArray());
+    ASSERT_EQ(4u, events.Size());
+
+    EXPECT_STREQ("water", events[1]["name"].GetString());
+    EXPECT_STREQ("layer", events[1]["cat"].GetString());
+    EXPECT_STREQ("X", events[1]["ph"].GetString());
+    EXPECT_DOUBLE_EQ(2000, events[1]["ts"].GetDouble());
+    EXPECT_DOUBLE_EQ(3000, events[1]["dur"].GetDouble());
+    EXPECT_DOUBLE_EQ(1000, events[1]["args"]["gpu"].GetDouble());
+    EXPECT_EQ(12u, events[1]["args"]["drawCalls"].GetUint64());
+    EXPECT_FALSE(events[0].HasMember("args"));
+
+    // Timestamps are relative to the start of the first frame.
+    EXPECT_DOUBLE_EQ(20000, events[2]["ts"].GetDouble());
+}
@@ -0,0 +1,60 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_file_source.hpp>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/gl/headless_frontend.hpp>
+#include <mbgl/renderer/renderer.hpp>
+#include <mbgl/renderer/memory_report.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/style/image.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+using namespace mbgl;
+
+TEST(MemoryReport, Totals) {
+    MemoryReport report;
+    report.add("source", "layer", MemoryCategory::Geometry, 100);
+    report.add("source", "layer", MemoryCategory::PaintAttributes, 20);
+    report.add("source", "", MemoryCategory::FeatureIndex, 10);
+    report.add("", "", MemoryCategory::Glyphs, 1);
+
+    // Empty entries are omitted.
+    report.add("source", "layer", MemoryCategory::Images, 0);
+
+    EXPECT_EQ(4u, report.entries.size());
+    EXPECT_EQ(131u, report.total());
+    EXPECT_EQ(100u, report.total(MemoryCategory::Geometry));
+    EXPECT_EQ(0u, report.total(MemoryCategory::Images));
+    EXPECT_EQ(130u, report.totalForSource("source"));
+    EXPECT_EQ(120u, report.totalForLayer("layer"));
+}
+
+TEST(MemoryReport, Renderer) {
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    ThreadPool threadPool { 4 };
+    HeadlessFrontend frontend { 1, fileSource, threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, fileSource,
+              threadPool, MapMode::Still };
+
+    map.getStyle().loadJSON(util::read_file("test/fixtures/api/query_style.json"));
+    auto icon = std::make_unique<style::Image>("test-icon",
+        decodeImage(util::read_file("test/fixtures/sprites/default_marker.png")), 1.0);
+    const std::size_t iconBytes = icon->getImage().bytes();
+    map.getStyle().addImage(std::move(icon));
+
+    frontend.render(map);
+
+    const MemoryReport report = frontend.getRenderer()->getMemoryReport();
+    EXPECT_GT(report.total(MemoryCategory::Geometry), 0u);
+    EXPECT_GT(report.total(MemoryCategory::FeatureIndex), 0u);
+    EXPECT_GE(report.total(MemoryCategory::Images), iconBytes);
+    EXPECT_GT(report.total(MemoryCategory::GPUBuffers), 0u);
+    EXPECT_GT(report.total(MemoryCategory::GPUTextures), 0u);
+    EXPECT_GT(report.totalForSource("source1"), 0u);
+    EXPECT_GT(report.totalForLayer("layer1"), 0u);
+    EXPECT_EQ(0u, report.totalForSource("unknown"));
+}
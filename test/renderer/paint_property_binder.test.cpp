@@ -0,0 +1,63 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/renderer/paint_property_binder.hpp>
+#include <mbgl/programs/attributes.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+static StubGeometryTileFeature feature(int64_t value) {
+    return StubGeometryTileFeature(PropertyMap {{ "property", value }});
+}
+
+TEST(PaintPropertyBinder, SourceFunctionRuns) {
+    SourceFunctionPaintPropertyBinder<float, attributes::a_opacity::Type> binder(
+        SourceFunction<float>("property", IntervalStops<float>({{ 0.0f, 0.0f }, { 1.0f, 1.0f }})), 0.0f);
+
+    binder.populateVertexVector(feature(0), 4);
+    const std::size_t runBytes = binder.runByteSize();
+
+    // Consecutive features with the same value extend the last run.
+    binder.populateVertexVector(feature(0), 8);
+    EXPECT_EQ(runBytes, binder.runByteSize());
+
+    binder.populateVertexVector(feature(1), 12);
+    EXPECT_EQ(2 * runBytes, binder.runByteSize());
+
+    // Features without vertices don't add a run.
+    binder.populateVertexVector(feature(0), 12);
+    EXPECT_EQ(2 * runBytes, binder.runByteSize());
+
+    EXPECT_EQ(12 * sizeof(float), binder.attributeByteSize());
+}
+
+TEST(PaintPropertyBinder, ColorAttributes) {
+    SourceFunctionPaintPropertyBinder<Color, attributes::a_color::Type> binder(
+        SourceFunction<Color>("property", IntervalStops<Color>({{ 0.0f, Color::red() }})), Color::black());
+
+    binder.populateVertexVector(feature(0), 10);
+    EXPECT_EQ(10 * 2 * sizeof(uint16_t), binder.attributeByteSize());
+
+    const auto value = attributeValue(Color { 0.2f, 0.4f, 0.6f, 1.0f });
+    EXPECT_EQ(attributes::packUint8Pair(255 * 0.2f, 255 * 0.4f), value[0]);
+    EXPECT_EQ(attributes::packUint8Pair(255 * 0.6f, 255 * 1.0f), value[1]);
+}
+
+TEST(PaintPropertyBinder, CompositeFunctionZoomConstant) {
+    CompositeFunction<float> function("property", CompositeIntervalStops<float>({
+        {0.0f, {{ 0.0f, 1.0f }}},
+        {10.0f, {{ 0.0f, 2.0f }}}
+    }), 0.0f);
+
+    // Beyond the last zoom stop, every feature has the same value at both ends of the zoom range.
+    CompositeFunctionPaintPropertyBinder<float, attributes::a_opacity::Type> constant(function, 12.0f, 0.0f);
+    constant.populateVertexVector(feature(0), 4);
+    EXPECT_EQ(4 * sizeof(float), constant.attributeByteSize());
+    EXPECT_EQ(0.0f, constant.interpolationFactor(12.5f));
+
+    CompositeFunctionPaintPropertyBinder<float, attributes::a_opacity::Type> interpolated(function, 5.0f, 0.0f);
+    interpolated.populateVertexVector(feature(0), 4);
+    EXPECT_EQ(4 * 2 * sizeof(float), interpolated.attributeByteSize());
+    EXPECT_FLOAT_EQ(0.5f, interpolated.interpolationFactor(5.5f));
+}
@@ -0,0 +1,98 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/style_diff.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+static Immutable<std::vector<ImmutableLayer>> toImpls(const std::vector<std::unique_ptr<Layer>>& layers) {
+    auto result = makeMutable<std::vector<ImmutableLayer>>();
+    for (auto& layer : layers) {
+        result->push_back(layer->baseImpl);
+    }
+    return std::move(result);
+}
+
+static std::vector<std::unique_ptr<Layer>> makeLayers(std::size_t count) {
+    std::vector<std::unique_ptr<Layer>> layers;
+    for (std::size_t i = 0; i < count; ++i) {
+        layers.push_back(std::make_unique<FillLayer>("layer-" + std::to_string(i), "source"));
+    }
+    return layers;
+}
+
+TEST(StyleDiff, Unchanged) {
+    auto layers = makeLayers(3);
+    auto impls = toImpls(layers);
+
+    LayerDifference result = diffLayers(impls, toImpls(layers));
+    EXPECT_TRUE(result.added.empty());
+    EXPECT_TRUE(result.removed.empty());
+    EXPECT_TRUE(result.changed.empty());
+}
+
+TEST(StyleDiff, ChangedInPlace) {
+    auto layers = makeLayers(5);
+    auto before = toImpls(layers);
+
+    layers[0]->as<FillLayer>()->setFillOpacity(0.5f);
+    layers[3]->as<FillLayer>()->setFillOpacity(0.5f);
+
+    LayerDifference result = diffLayers(before, toImpls(layers));
+    EXPECT_TRUE(result.added.empty());
+    EXPECT_TRUE(result.removed.empty());
+    ASSERT_EQ(2u, result.changed.size());
+    EXPECT_EQ(layers[0]->baseImpl.get(), result.changed.at("layer-0").after.get());
+    EXPECT_EQ(before->at(3).get(), result.changed.at("layer-3").before.get());
+}
+
+TEST(StyleDiff, AddedAndRemoved) {
+    auto layers = makeLayers(5);
+    auto before = toImpls(layers);
+
+    layers.erase(layers.begin() + 1);
+    layers.insert(layers.begin() + 3, std::make_unique<LineLayer>("line", "source"));
+    layers.push_back(std::make_unique<FillLayer>("last", "source"));
+    layers[2]->as<FillLayer>()->setFillOpacity(0.5f);
+
+    LayerDifference result = diffLayers(before, toImpls(layers));
+    ASSERT_EQ(2u, result.added.size());
+    EXPECT_EQ(1u, result.added.count("line"));
+    EXPECT_EQ(1u, result.added.count("last"));
+    ASSERT_EQ(1u, result.removed.size());
+    EXPECT_EQ(1u, result.removed.count("layer-1"));
+    ASSERT_EQ(1u, result.changed.size());
+    EXPECT_EQ(1u, result.changed.count("layer-3"));
+}
+
+TEST(StyleDiff, Moved) {
+    auto layers = makeLayers(5);
+    auto before = toImpls(layers);
+
+    // A moved layer is reported as removed and re-added, which forces a relayout.
+    std::rotate(layers.begin() + 1, layers.begin() + 3, layers.begin() + 4);
+
+    LayerDifference result = diffLayers(before, toImpls(layers));
+    EXPECT_EQ(1u, result.added.size());
+    EXPECT_EQ(1u, result.removed.size());
+    EXPECT_EQ(1u, result.added.count("layer-3"));
+    EXPECT_EQ(1u, result.removed.count("layer-3"));
+    EXPECT_TRUE(result.changed.empty());
+}
+
+TEST(StyleDiff, TypeChanged) {
+    std::vector<std::unique_ptr<Layer>> layers;
+    layers.push_back(std::make_unique<FillLayer>("a", "source"));
+    auto before = toImpls(layers);
+
+    layers[0] = std::make_unique<LineLayer>("a", "source");
+
+    LayerDifference result = diffLayers(before, toImpls(layers));
+    EXPECT_EQ(1u, result.added.count("a"));
+    EXPECT_EQ(1u, result.removed.count("a"));
+    EXPECT_TRUE(result.changed.empty());
+}
@@ -35,6 +35,25 @@ TEST(HTTPFileSource, TEST_REQUIRES_SERVER(HTTP200)) {
     loop.run();
 }
 
+TEST(HTTPFileSource, TEST_REQUIRES_SERVER(HTTP200RawDeflate)) {
+    util::RunLoop loop;
+    HTTPFileSource fs;
+
+    // Bodies are passed through compressed only if `util::decompress` can inflate them.
+    Resource resource { Resource::Tile, "http://127.0.0.1:3000/deflate-raw" };
+    resource.acceptsCompressedData = true;
+
+    auto req = fs.request(resource, [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_FALSE(res.compressed);
+        EXPECT_EQ("Hello World!", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
 TEST(HTTPFileSource, TEST_REQUIRES_SERVER(HTTP404)) {
     util::RunLoop loop;
     HTTPFileSource fs;
@@ -122,3 +122,27 @@ TEST(LocalFileSource, URLLimit) {
 
     loop.run();
 }
+
+TEST(LocalFileSource, ConcurrentRequests) {
+    util::RunLoop loop;
+
+    LocalFileSource fs(4);
+
+    const std::size_t count = 64;
+    std::size_t responses = 0;
+
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    for (std::size_t i = 0; i < count; i++) {
+        requests.push_back(fs.request({ Resource::Unknown, toAbsoluteURL("nonempty") }, [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("content is here\n", *res.data);
+            if (++responses == count) {
+                loop.stop();
+            }
+        }));
+    }
+
+    loop.run();
+    EXPECT_EQ(count, responses);
+}
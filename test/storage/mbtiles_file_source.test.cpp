@@ -0,0 +1,142 @@
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <unistd.h>
+#include <climits>
+#include <gtest/gtest.h>
+
+namespace {
+
+std::string toAbsoluteURL(const std::string& fileName) {
+    char buff[PATH_MAX + 1];
+    char* cwd = getcwd( buff, PATH_MAX + 1 );
+    std::string url = { "mbtiles://" + std::string(cwd) + "/test/fixtures/storage/mbtiles/" + fileName };
+    assert(url.size() <= PATH_MAX);
+    return url;
+}
+
+mbgl::Response request(mbgl::FileSource& fs, const mbgl::Resource& resource) {
+    mbgl::util::RunLoop loop;
+    mbgl::Response response;
+
+    std::unique_ptr<mbgl::AsyncRequest> req = fs.request(resource, [&](mbgl::Response res) {
+        req.reset();
+        response = res;
+        loop.stop();
+    });
+
+    loop.run();
+    return response;
+}
+
+} // namespace
+
+using namespace mbgl;
+
+TEST(MBTilesFileSource, AcceptsURL) {
+    EXPECT_TRUE(MBTilesFileSource::acceptsURL("mbtiles:///data/test.mbtiles"));
+    EXPECT_FALSE(MBTilesFileSource::acceptsURL("file:///data/test.mbtiles"));
+    EXPECT_FALSE(MBTilesFileSource::acceptsURL("http://example.com/test.mbtiles"));
+}
+
+TEST(MBTilesFileSource, TileJSON) {
+    MBTilesFileSource fs;
+
+    const std::string url = toAbsoluteURL("test.mbtiles");
+    Response res = request(fs, Resource::source(url));
+    EXPECT_EQ(nullptr, res.error);
+    ASSERT_TRUE(res.data.get());
+
+    JSDocument doc;
+    doc.Parse<0>(res.data->c_str());
+    ASSERT_FALSE(doc.HasParseError());
+
+    EXPECT_EQ("tms", std::string(doc["scheme"].GetString()));
+    ASSERT_EQ(1u, doc["tiles"].Size());
+    EXPECT_EQ(url + "?z={z}&x={x}&y={y}", std::string(doc["tiles"][0].GetString()));
+    EXPECT_EQ(0, doc["minzoom"].GetDouble());
+    EXPECT_EQ(1, doc["maxzoom"].GetDouble());
+    EXPECT_EQ("© test", std::string(doc["attribution"].GetString()));
+    EXPECT_EQ(4u, doc["bounds"].Size());
+    EXPECT_EQ(3u, doc["center"].Size());
+    ASSERT_EQ(1u, doc["vector_layers"].Size());
+    EXPECT_EQ("water", std::string(doc["vector_layers"][0]["id"].GetString()));
+}
+
+TEST(MBTilesFileSource, Tile) {
+    MBTilesFileSource fs;
+
+    const std::string urlTemplate = toAbsoluteURL("test.mbtiles") + "?z={z}&x={x}&y={y}";
+    Response res = request(fs, Resource::tile(urlTemplate, 1, 0, 0, 1, Tileset::Scheme::TMS));
+    EXPECT_EQ(nullptr, res.error);
+    ASSERT_TRUE(res.data.get());
+    EXPECT_FALSE(res.compressed);
+    EXPECT_EQ("uncompressed tile", *res.data);
+}
+
+TEST(MBTilesFileSource, CompressedTile) {
+    MBTilesFileSource fs;
+
+    const std::string urlTemplate = toAbsoluteURL("test.mbtiles") + "?z={z}&x={x}&y={y}";
+    Resource resource = Resource::tile(urlTemplate, 1, 0, 0, 0, Tileset::Scheme::TMS);
+
+    Response inflated = request(fs, resource);
+    EXPECT_EQ(nullptr, inflated.error);
+    ASSERT_TRUE(inflated.data.get());
+    EXPECT_FALSE(inflated.compressed);
+    EXPECT_EQ("compressed tile", *inflated.data);
+
+    resource.acceptsCompressedData = true;
+    Response passedThrough = request(fs, resource);
+    EXPECT_EQ(nullptr, passedThrough.error);
+    ASSERT_TRUE(passedThrough.data.get());
+    EXPECT_TRUE(passedThrough.compressed);
+    EXPECT_EQ("compressed tile", util::decompress(*passedThrough.data));
+}
+
+TEST(MBTilesFileSource, MissingTile) {
+    MBTilesFileSource fs;
+
+    const std::string urlTemplate = toAbsoluteURL("test.mbtiles") + "?z={z}&x={x}&y={y}";
+    Response res = request(fs, Resource::tile(urlTemplate, 1, 1, 1, 1, Tileset::Scheme::TMS));
+    EXPECT_EQ(nullptr, res.error);
+    EXPECT_TRUE(res.noContent);
+    EXPECT_FALSE(res.data.get());
+}
+
+TEST(MBTilesFileSource, NonExistentArchive) {
+    MBTilesFileSource fs;
+
+    Response res = request(fs, Resource::source(toAbsoluteURL("does_not_exist.mbtiles")));
+    ASSERT_NE(nullptr, res.error);
+    EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
+    EXPECT_FALSE(res.data.get());
+}
+
+TEST(MBTilesFileSource, ConcurrentRequests) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs(4);
+
+    const std::string urlTemplate = toAbsoluteURL("test.mbtiles") + "?z={z}&x={x}&y={y}";
+    const std::size_t count = 64;
+    std::size_t responses = 0;
+
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    for (std::size_t i = 0; i < count; i++) {
+        requests.push_back(fs.request(Resource::tile(urlTemplate, 1, 0, 0, 1, Tileset::Scheme::TMS), [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("uncompressed tile", *res.data);
+            if (++responses == count) {
+                loop.stop();
+            }
+        }));
+    }
+
+    loop.run();
+    EXPECT_EQ(count, responses);
+}
@@ -4,6 +4,7 @@
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 
@@ -219,6 +220,49 @@ TEST(OfflineDatabase, PutTile) {
     EXPECT_EQ("second", *updateGetResult->data);
 }
 
+TEST(OfflineDatabase, PutCompressedTile) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+
+    Resource resource { Resource::Tile, "http://example.com/" };
+    resource.tileData = Resource::TileData {
+        "http://example.com/",
+        1,
+        0,
+        0,
+        0
+    };
+    Response response;
+
+    // Compressed responses are stored as-is.
+    const std::string raw(1024, 'x');
+    response.data = std::make_shared<std::string>(util::compress(raw));
+    response.compressed = true;
+    auto putResult = db.put(resource, response);
+    EXPECT_TRUE(putResult.first);
+    EXPECT_EQ(response.data->size(), putResult.second);
+
+    // Requestors that don't accept compressed data get it inflated.
+    auto inflated = db.get(resource);
+    EXPECT_FALSE(inflated->compressed);
+    EXPECT_EQ(raw, *inflated->data);
+
+    resource.acceptsCompressedData = true;
+    auto passedThrough = db.get(resource);
+    EXPECT_TRUE(passedThrough->compressed);
+    EXPECT_EQ(*response.data, *passedThrough->data);
+    EXPECT_EQ(raw, util::decompress(*passedThrough->data));
+
+    // Data the database compressed itself is passed through as well.
+    response.data = std::make_shared<std::string>(raw);
+    response.compressed = false;
+    db.put(resource, response);
+    auto recompressed = db.get(resource);
+    EXPECT_TRUE(recompressed->compressed);
+    EXPECT_EQ(raw, util::decompress(*recompressed->data));
+}
+
 TEST(OfflineDatabase, PutResourceNoContent) {
     using namespace mbgl;
 
@@ -634,6 +678,14 @@ static int databaseSyncMode(const std::string& path) {
     return stmt.get<int>(0);
 }
 
+static int64_t databaseTableRowCount(const std::string& path, const std::string& name) {
+    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
+    const auto sql = std::string("SELECT COUNT(*) FROM ") + name;
+    mapbox::sqlite::Statement stmt = db.prepare(sql.c_str());
+    stmt.run();
+    return stmt.get<int64_t>(0);
+}
+
 static std::vector<std::string> databaseTableColumns(const std::string& path, const std::string& name) {
     mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
     const auto sql = std::string("pragma table_info(") + name + ")";
@@ -661,7 +713,7 @@ TEST(OfflineDatabase, MigrateFromV2Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
     EXPECT_LT(databasePageCount("test/fixtures/offline_database/migrated.db"),
               databasePageCount("test/fixtures/offline_database/v2.db"));
 }
@@ -682,7 +734,7 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
 }
 
 TEST(OfflineDatabase, MigrateFromV4Schema) {
@@ -701,7 +753,7 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
 
     // Journal mode should be DELETE after migration to v5.
     EXPECT_EQ("delete", databaseJournalMode("test/fixtures/offline_database/migrated.db"));
@@ -727,13 +779,133 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
 
-    EXPECT_EQ((std::vector<std::string>{ "id", "url_template", "pixel_ratio", "z", "x", "y",
-                                         "expires", "modified", "etag", "data", "compressed",
-                                         "accessed", "must_revalidate" }),
+    EXPECT_EQ((std::vector<std::string>{ "id", "url_template_id", "pixel_ratio", "z", "x", "y",
+                                         "expires", "modified", "etag", "data_id", "accessed",
+                                         "must_revalidate" }),
               databaseTableColumns("test/fixtures/offline_database/migrated.db", "tiles"));
     EXPECT_EQ((std::vector<std::string>{ "id", "url", "kind", "expires", "modified", "etag", "data",
                                          "compressed", "accessed", "must_revalidate" }),
               databaseTableColumns("test/fixtures/offline_database/migrated.db", "resources"));
 }
+
+TEST(OfflineDatabase, MigrateFromV6Schema) {
+    using namespace mbgl;
+
+    // v6.db is a v6 database with a single offline region. Three of its tiles, from two
+    // different sources, have the same content, and one tile has no content.
+
+    deleteFile("test/fixtures/offline_database/migrated.db");
+    writeFile("test/fixtures/offline_database/migrated.db", util::read_file("test/fixtures/offline_database/v6.db"));
+
+    const std::string vector = "http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf";
+    const std::string raster = "http://127.0.0.1:3000/{z}-{x}-{y}.png";
+
+    {
+        OfflineDatabase db("test/fixtures/offline_database/migrated.db", 0);
+
+        EXPECT_EQ("ocean", *db.get(Resource::tile(vector, 1, 0, 0, 0, Tileset::Scheme::XYZ))->data);
+        EXPECT_EQ("ocean", *db.get(Resource::tile(vector, 1, 0, 0, 1, Tileset::Scheme::XYZ))->data);
+        EXPECT_EQ("land", *db.get(Resource::tile(vector, 1, 1, 0, 1, Tileset::Scheme::XYZ))->data);
+        EXPECT_EQ("ocean", *db.get(Resource::tile(raster, 1, 0, 0, 0, Tileset::Scheme::XYZ))->data);
+        EXPECT_TRUE(db.get(Resource::tile(raster, 1, 0, 0, 1, Tileset::Scheme::XYZ))->noContent);
+        EXPECT_FALSE(bool(db.get(Resource::tile(raster, 1, 1, 0, 1, Tileset::Scheme::XYZ))));
+    }
+
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+    EXPECT_EQ(2, databaseTableRowCount("test/fixtures/offline_database/migrated.db", "url_templates"));
+    EXPECT_EQ(2, databaseTableRowCount("test/fixtures/offline_database/migrated.db", "tile_data"));
+
+    {
+        OfflineDatabase db("test/fixtures/offline_database/migrated.db", 0);
+        auto regions = db.listRegions();
+        for (auto& region : regions) {
+            db.deleteRegion(std::move(region));
+        }
+    }
+
+    // Evicting the tiles releases their payloads.
+    EXPECT_EQ(0, databaseTableRowCount("test/fixtures/offline_database/migrated.db", "tiles"));
+    EXPECT_EQ(0, databaseTableRowCount("test/fixtures/offline_database/migrated.db", "tile_data"));
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(PutTileDeduplicatesData)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+    const std::string path("test/fixtures/offline_database/offline.db");
+
+    Resource first = Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, 0, 0, 1, Tileset::Scheme::XYZ);
+    Resource second = Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, 1, 0, 1, Tileset::Scheme::XYZ);
+    Resource third = Resource::tile("http://example.org/{z}-{x}-{y}", 1.0, 0, 0, 1, Tileset::Scheme::XYZ);
+
+    Response ocean;
+    ocean.data = std::make_shared<std::string>(1000, 'o');
+    Response land;
+    land.data = std::make_shared<std::string>("land");
+
+    {
+        OfflineDatabase db(path);
+        OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+        OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+        db.putRegionResource(region.getID(), first, ocean);
+        db.putRegionResource(region.getID(), second, ocean);
+        db.putRegionResource(region.getID(), third, ocean);
+    }
+
+    EXPECT_EQ(3, databaseTableRowCount(path, "tiles"));
+    EXPECT_EQ(2, databaseTableRowCount(path, "url_templates"));
+    EXPECT_EQ(1, databaseTableRowCount(path, "tile_data"));
+
+    {
+        OfflineDatabase db(path);
+
+        // Replacing the content of one tile doesn't affect the others.
+        db.put(first, land);
+        EXPECT_EQ("land", *db.get(first)->data);
+        EXPECT_EQ(*ocean.data, *db.get(second)->data);
+        EXPECT_EQ(*ocean.data, *db.get(third)->data);
+
+        // Sizes are reported per tile.
+        auto status = db.getRegionCompletedStatus(db.listRegions().at(0).getID());
+        EXPECT_EQ(3u, status.completedTileCount);
+    }
+
+    EXPECT_EQ(2, databaseTableRowCount(path, "tile_data"));
+
+    {
+        OfflineDatabase db(path);
+        db.put(first, ocean);
+    }
+
+    // The payload that is no longer used is deleted.
+    EXPECT_EQ(1, databaseTableRowCount(path, "tile_data"));
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(EvictionDeletesUnusedURLTemplates)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+    const std::string path("test/fixtures/offline_database/offline.db");
+
+    {
+        OfflineDatabase db(path, 1024 * 100);
+
+        for (uint32_t i = 1; i <= 100; i++) {
+            // Distinct payloads, so that they can't share tile data.
+            Response response;
+            response.data = std::make_shared<std::string>(*randomString(1024) + util::toString(i));
+            db.put(Resource::tile("http://example.com/"s + util::toString(i) + "/{z}-{x}-{y}", 1.0, 0, 0, 0,
+                                  Tileset::Scheme::XYZ), response);
+        }
+    }
+
+    // Every template left is used by a tile.
+    const int64_t tiles = databaseTableRowCount(path, "tiles");
+    EXPECT_LT(tiles, 100);
+    EXPECT_EQ(tiles, databaseTableRowCount(path, "url_templates"));
+}
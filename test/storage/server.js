@@ -10,6 +10,7 @@ process.stdin.on('end', function() { process.exit(0); });
 
 
 var fs = require('fs');
+var zlib = require('zlib');
 var express = require('express');
 var app = express();
 
@@ -93,6 +94,12 @@ app.get('/empty-data', function(req, res) {
     res.status(200).send();
 });
 
+app.get('/deflate-raw', function(req, res) {
+    // Raw deflate data without a zlib header, as some servers send for this encoding.
+    res.setHeader('Content-Encoding', 'deflate');
+    res.status(200).send(zlib.deflateRawSync('Hello World!'));
+});
+
 app.get('/no-content', function(req, res) {
     res.status(204).send();
 });
@@ -0,0 +1,98 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/style/filter.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
+#include <mbgl/style/rapidjson_conversion.hpp>
+#include <mbgl/style/conversion.hpp>
+#include <mbgl/style/conversion/filter.hpp>
+
+#include <rapidjson/document.h>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+static Filter parseFilter(const char * expression) {
+    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> doc;
+    doc.Parse<0>(expression);
+    conversion::Error error;
+    optional<Filter> filter = conversion::convert<Filter, JSValue>(doc, error);
+    EXPECT_TRUE(bool(filter));
+    return *filter;
+}
+
+TEST(CompiledFilter, MatchesFilter) {
+    const std::vector<const char*> expressions = {
+        R"(["==", "foo", "bar"])",
+        R"(["==", "foo", 0])",
+        R"(["!=", "foo", 0])",
+        R"(["<", "foo", 1])",
+        R"(["<=", "foo", 1])",
+        R"([">", "foo", 0])",
+        R"([">=", "foo", "bar"])",
+        R"(["in", "foo", "bar", 1, true])",
+        R"(["!in", "foo", "bar", 1, true])",
+        R"(["has", "foo"])",
+        R"(["!has", "foo"])",
+        R"(["==", "$type", "LineString"])",
+        R"(["!=", "$type", "Point"])",
+        R"(["in", "$type", "LineString", "Polygon"])",
+        R"(["!in", "$type", "LineString", "Polygon"])",
+        R"(["==", "$id", 1234])",
+        R"(["!=", "$id", 1234])",
+        R"(["in", "$id", 1, "1234"])",
+        R"(["!in", "$id", 1, "1234"])",
+        R"(["has", "$id"])",
+        R"(["!has", "$id"])",
+        R"(["any"])",
+        R"(["all"])",
+        R"(["none"])",
+        R"(["any", ["==", "foo", "bar"], ["==", "$type", "Point"]])",
+        R"(["all", ["has", "foo"], ["in", "$type", "Point", "Polygon"], ["!=", "$id", 1]])",
+        R"(["none", ["all", ["==", "foo", 1], ["==", "bar", 1]], ["any", ["!has", "bar"], ["==", "$type", "Polygon"]]])",
+        R"(["all", ["any", ["==", "foo", 1], ["==", "bar", 1]], ["none", ["<", "foo", 0]], ["in", "$type", "Point"]])",
+    };
+
+    const std::vector<StubGeometryTileFeature> features = {
+        { {}, FeatureType::Point, {}, {} },
+        { FeatureIdentifier(uint64_t(1234)), FeatureType::LineString, {}, {{ "foo", std::string("bar") }} },
+        { FeatureIdentifier(std::string("1234")), FeatureType::Polygon, {}, {{ "foo", uint64_t(1) }} },
+        { FeatureIdentifier(int64_t(1)), FeatureType::Point, {}, {{ "foo", int64_t(0) }, { "bar", double(1) }} },
+        { FeatureIdentifier(double(1)), FeatureType::LineString, {}, {{ "foo", double(1) }, { "bar", std::string("1") }} },
+        { {}, FeatureType::Polygon, {}, {{ "foo", true }} },
+        { {}, FeatureType::Point, {}, {{ "foo", false }, { "bar", int64_t(1) }} },
+        { {}, FeatureType::Point, {}, {{ "foo", int64_t(-1) }} },
+    };
+
+    for (const auto expression : expressions) {
+        const Filter filter = parseFilter(expression);
+        const CompiledFilter compiled(filter);
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            EXPECT_EQ(filter(features[i]), compiled(features[i])) << expression << " feature " << i;
+        }
+    }
+}
+
+TEST(CompiledFilter, LargeIn) {
+    std::string expression = R"(["in", "class")";
+    for (int i = 0; i < 100; ++i) {
+        expression += ", \"class-" + std::to_string(i) + "\", " + std::to_string(i);
+    }
+    expression += "]";
+
+    const CompiledFilter compiled(parseFilter(expression.c_str()));
+
+    EXPECT_TRUE(compiled(StubGeometryTileFeature({{ "class", std::string("class-42") }})));
+    EXPECT_TRUE(compiled(StubGeometryTileFeature({{ "class", uint64_t(42) }})));
+    EXPECT_TRUE(compiled(StubGeometryTileFeature({{ "class", double(42) }})));
+    EXPECT_FALSE(compiled(StubGeometryTileFeature({{ "class", std::string("42") }})));
+    EXPECT_FALSE(compiled(StubGeometryTileFeature({{ "class", double(42.5) }})));
+    EXPECT_FALSE(compiled(StubGeometryTileFeature({{ "class", true }})));
+    EXPECT_FALSE(compiled(StubGeometryTileFeature({{ "other", std::string("class-42") }})));
+}
+
+TEST(CompiledFilter, InternsKeys) {
+    const CompiledFilter compiled(parseFilter(R"(["all", ["==", "foo", 1], ["!=", "bar", 1], ["has", "foo"]])"));
+    EXPECT_EQ((std::vector<std::string> { "foo", "bar" }), compiled.getKeys());
+}
@@ -0,0 +1,45 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/function/categorical_stops.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+TEST(CategoricalStops, Evaluate) {
+    CategoricalStops<float> stops(std::map<CategoricalValue, float> {
+        { CategoricalValue(std::string("a")), 1.0f },
+        { CategoricalValue(int64_t(1)), 2.0f },
+        { CategoricalValue(true), 3.0f }
+    });
+
+    EXPECT_EQ(1.0f, *stops.evaluate(Value(std::string("a"))));
+    EXPECT_EQ(2.0f, *stops.evaluate(Value(int64_t(1))));
+    EXPECT_EQ(2.0f, *stops.evaluate(Value(uint64_t(1))));
+    EXPECT_EQ(2.0f, *stops.evaluate(Value(double(1))));
+    EXPECT_EQ(3.0f, *stops.evaluate(Value(true)));
+}
+
+TEST(CategoricalStops, NoMatch) {
+    CategoricalStops<float> stops(std::map<CategoricalValue, float> {
+        { CategoricalValue(std::string("1")), 1.0f },
+        { CategoricalValue(true), 2.0f }
+    });
+
+    EXPECT_FALSE(bool(stops.evaluate(Value(std::string("b")))));
+    EXPECT_FALSE(bool(stops.evaluate(Value(int64_t(1)))));
+    EXPECT_FALSE(bool(stops.evaluate(Value(false))));
+    EXPECT_FALSE(bool(stops.evaluate(Value(NullValue()))));
+    EXPECT_FALSE(bool(stops.evaluate(Value(std::vector<Value>()))));
+}
+
+TEST(CategoricalStops, Copy) {
+    optional<CategoricalStops<float>> original;
+    original.emplace(std::map<CategoricalValue, float> {
+        { CategoricalValue(std::string("a")), 1.0f }
+    });
+
+    CategoricalStops<float> copy(*original);
+    original = {};
+
+    EXPECT_EQ(1.0f, *copy.evaluate(Value(std::string("a"))));
+}
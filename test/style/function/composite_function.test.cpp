@@ -69,3 +69,37 @@ TEST(CompositeFunction, Issue8460) {
     EXPECT_NEAR(600.0f, fn2.evaluate(18.0f, oneInteger, -1.0f), 0.00);
     EXPECT_NEAR(600.0f, fn2.evaluate(19.0f, oneInteger, -1.0f), 0.00);
 }
+
+TEST(CompositeFunction, CategoricalStops) {
+    static StubGeometryTileFeature oneString {
+        PropertyMap {{ "property", std::string("one") }}
+    };
+
+    CompositeFunction<float> fn("property", CompositeCategoricalStops<float>({
+        {0.0f, {{std::string("one"), 10.0f}}},
+        {10.0f, {{std::string("one"), 20.0f}, {std::string("two"), 30.0f}}}
+    }), -1.0f);
+
+    EXPECT_EQ(10.0f, fn.evaluate(0.0f, oneString, -2.0f));
+    EXPECT_EQ(15.0f, fn.evaluate(5.0f, oneString, -2.0f));
+    EXPECT_EQ(20.0f, fn.evaluate(10.0f, oneString, -2.0f));
+    EXPECT_EQ(-1.0f, fn.evaluate(10.0f, oneInteger, -2.0f)) << "Use the default value for unmatched categories";
+}
+
+TEST(CompositeFunction, RangeOfCoveringRanges) {
+    CompositeFunction<float> fn("property", CompositeIntervalStops<float>({
+        {2.0f, {{0.0f, 10.0f}}},
+        {4.0f, {{0.0f, 20.0f}}},
+        {6.0f, {{0.0f, 30.0f}}}
+    }), 0.0f);
+
+    auto ranges = fn.rangeOfCoveringRanges({ 4.5f, 5.5f });
+    EXPECT_EQ(Range<float>(4.0f, 6.0f), ranges.min.coveringZoomRange);
+    EXPECT_EQ(Range<float>(4.0f, 6.0f), ranges.max.coveringZoomRange);
+
+    // Covering ranges refer to the function's stops by index, so they remain valid for copies.
+    CompositeFunction<float> copy = fn;
+    Range<float> result = copy.evaluate(ranges, oneInteger, -1.0f);
+    EXPECT_NEAR(22.5f, result.min, 0.01);
+    EXPECT_NEAR(27.5f, result.max, 0.01);
+}
@@ -18,3 +18,28 @@ TEST(ExponentialStops, NonNumericInput) {
     EXPECT_FALSE(bool(stops.evaluate(Value(std::vector<Value>()))));
     EXPECT_FALSE(bool(stops.evaluate(Value(std::unordered_map<std::string, Value>()))));
 }
+
+TEST(ExponentialStops, Evaluate) {
+    ExponentialStops<float> stops(std::map<float, float> {{0.0f, 0.0f}, {10.0f, 100.0f}, {20.0f, 300.0f}});
+    EXPECT_EQ(0.0f, *stops.evaluate(-5.0f));
+    EXPECT_EQ(0.0f, *stops.evaluate(0.0f));
+    EXPECT_EQ(50.0f, *stops.evaluate(5.0f));
+    EXPECT_EQ(100.0f, *stops.evaluate(10.0f));
+    EXPECT_EQ(200.0f, *stops.evaluate(15.0f));
+    EXPECT_EQ(300.0f, *stops.evaluate(20.0f));
+    EXPECT_EQ(300.0f, *stops.evaluate(25.0f));
+    EXPECT_EQ(200.0f, *stops.evaluate(Value(int64_t(15))));
+}
+
+TEST(ExponentialStops, Copy) {
+    optional<ExponentialStops<float>> original;
+    original.emplace(std::map<float, float> {{0.0f, 0.0f}, {10.0f, 100.0f}});
+
+    ExponentialStops<float> copy(*original);
+    ExponentialStops<float> assigned;
+    assigned = *original;
+    original = {};
+
+    EXPECT_EQ(50.0f, *copy.evaluate(5.0f));
+    EXPECT_EQ(50.0f, *assigned.evaluate(5.0f));
+}
@@ -18,3 +18,14 @@ TEST(IntervalStops, NonNumericInput) {
     EXPECT_FALSE(bool(stops.evaluate(Value(std::vector<Value>()))));
     EXPECT_FALSE(bool(stops.evaluate(Value(std::unordered_map<std::string, Value>()))));
 }
+
+TEST(IntervalStops, Evaluate) {
+    IntervalStops<float> stops(std::map<float, float> {{0.0f, 1.0f}, {10.0f, 2.0f}, {20.0f, 3.0f}});
+    EXPECT_EQ(1.0f, *stops.evaluate(-5.0f));
+    EXPECT_EQ(1.0f, *stops.evaluate(0.0f));
+    EXPECT_EQ(1.0f, *stops.evaluate(9.9f));
+    EXPECT_EQ(2.0f, *stops.evaluate(10.0f));
+    EXPECT_EQ(2.0f, *stops.evaluate(19.9f));
+    EXPECT_EQ(3.0f, *stops.evaluate(20.0f));
+    EXPECT_EQ(3.0f, *stops.evaluate(Value(uint64_t(25))));
+}
@@ -34,6 +34,7 @@
 #include <mbgl/annotation/annotation_source.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/tile/tile_trace.hpp>
 
 #include <cstdint>
 
@@ -52,6 +53,7 @@ public:
     AnnotationManager annotationManager { style };
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    TileTracer tileTracer;
 
     TileParameters tileParameters {
         1.0,
@@ -63,7 +65,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        tileTracer
     };
 
     SourceTest() {
@@ -13,6 +13,7 @@
 #include <mbgl/annotation/annotation_tile.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/tile/tile_trace.hpp>
 #include <mbgl/renderer/backend_scope.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/style/style.hpp>
@@ -34,6 +35,7 @@ public:
     RenderStyle renderStyle { threadPool, fileSource };
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    TileTracer tileTracer;
 
     TileParameters tileParameters {
         1.0,
@@ -45,7 +47,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        tileTracer
     };
 };
 
@@ -62,6 +65,7 @@ TEST(AnnotationTile, Issue8289) {
         std::unordered_map<std::string, std::shared_ptr<Bucket>>(),
         std::make_unique<FeatureIndex>(),
         std::move(data),
+        {},
         0
     });
 
@@ -85,6 +89,7 @@ TEST(AnnotationTile, Issue8289) {
         std::unordered_map<std::string, std::shared_ptr<Bucket>>(),
         std::make_unique<FeatureIndex>(),
         std::make_unique<AnnotationTileData>(),
+        {},
         0
     });
 
@@ -13,6 +13,7 @@
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/tile/tile_trace.hpp>
 
 #include <memory>
 
@@ -29,6 +30,7 @@ public:
     AnnotationManager annotationManager { style };
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    TileTracer tileTracer;
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     TileParameters tileParameters {
@@ -41,7 +43,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        tileTracer
     };
 };
 
@@ -105,3 +105,43 @@ TEST(GeometryTileData, limitHoles3) {
     ASSERT_EQ(original.at(3), polygon.at(2));
 
 }
+
+TEST(GeometryTileData, classifyRingsArena) {
+    const GeometryCollection rings = {
+      { {0, 0}, {0, 40}, {40, 40}, {40, 0}, {0, 0} },
+      { {10, 10}, {20, 10}, {20, 20}, {10, 10} },
+      { {50, 50}, {50, 60}, {60, 60}, {60, 50}, {50, 50} },
+      { {70, 70}, {70, 70}, {70, 70} }
+    };
+
+    Arena arena;
+    const std::vector<GeometryCollection> expected = classifyRings(rings);
+    const ArenaVector<ArenaPolygon> polygons = classifyRings(rings, arena);
+
+    ASSERT_EQ(expected.size(), polygons.size());
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected[i].size(), polygons[i].size());
+        for (std::size_t j = 0; j < expected[i].size(); j++) {
+            EXPECT_TRUE(std::equal(expected[i][j].begin(), expected[i][j].end(),
+                                   polygons[i][j].begin(), polygons[i][j].end()));
+        }
+    }
+    EXPECT_LT(0u, arena.allocationCount());
+}
+
+TEST(GeometryTileData, limitHolesArena) {
+    Arena arena;
+    ArenaVector<ArenaPolygon> polygons = classifyRings({
+      { {0, 0}, {0, 40}, {40, 40}, {40, 0}, {0, 0} },
+      { {30, 30}, {32, 30}, {32, 32}, {30, 30} },
+      { {10, 10}, {20, 10}, {20, 20}, {10, 10} }
+    }, arena);
+
+    ASSERT_EQ(polygons.size(), 1u);
+    limitHoles(polygons[0], 1);
+
+    // output: polygon 1 has 1 exterior, 1 interior
+    ASSERT_EQ(polygons[0].size(), 2u);
+    ASSERT_EQ(polygons[0][0][0].x, 0);
+    ASSERT_EQ(polygons[0][1][0].x, 10);
+}
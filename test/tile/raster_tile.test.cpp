@@ -12,6 +12,9 @@
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/tile/tile_trace.hpp>
+#include <mbgl/style/layers/raster_layer.hpp>
+#include <mbgl/gl/context.hpp>
 
 using namespace mbgl;
 
@@ -25,6 +28,7 @@ public:
     AnnotationManager annotationManager { style };
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    TileTracer tileTracer;
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     TileParameters tileParameters {
@@ -37,7 +41,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        tileTracer
     };
 };
 
@@ -76,3 +81,31 @@ TEST(RasterTile, onParsedEmpty) {
     EXPECT_TRUE(tile.isLoaded());
     EXPECT_TRUE(tile.isComplete());
 }
+
+TEST(RasterTile, UploadReleasesImage) {
+    RasterTileTest test;
+    gl::Context context;
+    style::RasterLayer layer("raster", "source");
+
+    RasterTile tile(OverscaledTileID(0, 0, 0), test.tileParameters, test.tileset);
+    tile.onParsed(std::make_unique<RasterBucket>(PremultipliedImage({ 1, 1 })));
+    auto bucket = static_cast<RasterBucket*>(tile.getBucket(*layer.baseImpl));
+    ASSERT_TRUE(bucket);
+
+    tile.upload(context);
+    EXPECT_FALSE(bucket->image);
+    ASSERT_TRUE(bool(bucket->texture));
+    const gl::TextureID textureID = bucket->texture->texture.get();
+
+    // The bucket draws from its texture, without uploading the image again.
+    EXPECT_FALSE(bucket->needsUpload());
+    tile.upload(context);
+    ASSERT_TRUE(bool(bucket->texture));
+    EXPECT_EQ(textureID, bucket->texture->texture.get());
+
+    // Buckets without an image are never uploaded, so they keep what they have.
+    RasterBucket empty { nullptr };
+    empty.upload(context);
+    empty.releaseImage();
+    EXPECT_FALSE(bool(empty.texture));
+}
@@ -0,0 +1,99 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/tile_trace.hpp>
+
+using namespace mbgl;
+
+TEST(TileTrace, Disabled) {
+    TileTracer tracer;
+    TileTrace trace(&tracer);
+
+    trace.begin(TileStage::Layout);
+    trace.end(TileStage::Layout);
+
+    EXPECT_TRUE(trace.getEvents().empty());
+    EXPECT_FALSE(bool(trace.getLastDuration(TileStage::Layout)));
+    EXPECT_EQ(0u, tracer.getTimings()[TileStage::Layout].count);
+}
+
+TEST(TileTrace, Stages) {
+    TileTracer tracer;
+    tracer.setEnabled(true);
+    TileTrace trace(&tracer);
+
+    {
+        TileTrace::Scope scope(trace, TileStage::Layout, 1);
+    }
+
+    // Ends without a matching begin are ignored.
+    trace.end(TileStage::Layout, 1);
+    trace.end(TileStage::Placement, 1);
+
+    const auto events = trace.getEvents();
+    ASSERT_EQ(4u, events.size());
+    EXPECT_EQ(TileStage::Layout, events[0].stage);
+    EXPECT_EQ(TileTrace::Phase::Begin, events[0].phase);
+    EXPECT_EQ(1u, events[0].correlationID);
+    EXPECT_EQ(TileTrace::Phase::End, events[1].phase);
+    EXPECT_LE(events[0].time, events[1].time);
+
+    EXPECT_TRUE(bool(trace.getLastDuration(TileStage::Layout)));
+    EXPECT_FALSE(bool(trace.getLastDuration(TileStage::Placement)));
+
+    const TileTimings timings = tracer.getTimings();
+    EXPECT_EQ(1u, timings[TileStage::Layout].count);
+    EXPECT_EQ(0u, timings[TileStage::Placement].count);
+}
+
+TEST(TileTrace, QueueMatchesCorrelationID) {
+    TileTracer tracer;
+    tracer.setEnabled(true);
+    TileTrace trace(&tracer);
+
+    // Two messages are queued before the worker receives the first one.
+    trace.begin(TileStage::Queue, 1);
+    trace.begin(TileStage::Queue, 2);
+    trace.end(TileStage::Queue, 1);
+    trace.end(TileStage::Queue, 2);
+    trace.end(TileStage::Queue, 3);
+
+    EXPECT_EQ(2u, tracer.getTimings()[TileStage::Queue].count);
+}
+
+TEST(TileTrace, RingBuffer) {
+    TileTracer tracer;
+    tracer.setEnabled(true);
+    TileTrace trace(&tracer);
+
+    for (uint64_t i = 0; i < TileTrace::capacity + 3; i++) {
+        trace.begin(TileStage::Request, i);
+    }
+
+    const auto events = trace.getEvents();
+    ASSERT_EQ(TileTrace::capacity, events.size());
+    EXPECT_EQ(3u, events.front().correlationID);
+    EXPECT_EQ(TileTrace::capacity + 2, events.back().correlationID);
+}
+
+TEST(TileTimings, Histogram) {
+    TileTimings::Histogram histogram;
+    EXPECT_EQ(Duration::zero(), histogram.quantile(0.5));
+
+    histogram.add(std::chrono::microseconds(500));
+    histogram.add(Milliseconds(3));
+    histogram.add(Milliseconds(3));
+    histogram.add(Milliseconds(100));
+    histogram.add(Seconds(60));
+
+    EXPECT_EQ(5u, histogram.count);
+    EXPECT_EQ(1u, histogram.buckets[0]);
+    EXPECT_EQ(2u, histogram.buckets[2]);
+    EXPECT_EQ(1u, histogram.buckets[7]);
+    EXPECT_EQ(1u, histogram.buckets[TileTimings::Histogram::bucketCount - 1]);
+    EXPECT_EQ(Duration(Seconds(60)), histogram.max);
+
+    EXPECT_EQ(Duration(Milliseconds(1)), histogram.quantile(0));
+    EXPECT_EQ(Duration(Milliseconds(4)), histogram.quantile(0.5));
+    EXPECT_EQ(Duration(Milliseconds(128)), histogram.quantile(0.75));
+    EXPECT_EQ(Duration(Seconds(60)), histogram.quantile(1));
+}
@@ -2,9 +2,12 @@
 #include <mbgl/test/fake_file_source.hpp>
 #include <mbgl/tile/vector_tile.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
 
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
@@ -16,6 +19,7 @@
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/tile/tile_trace.hpp>
 
 #include <memory>
 
@@ -31,6 +35,7 @@ public:
     AnnotationManager annotationManager { style };
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    TileTracer tileTracer;
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     TileParameters tileParameters {
@@ -43,7 +48,8 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        tileTracer
     };
 };
 
@@ -94,12 +100,44 @@ TEST(VectorTile, Issue7615) {
         std::unordered_map<std::string, std::shared_ptr<Bucket>>(),
         nullptr,
         nullptr,
+        {},
         0
     });
 
     EXPECT_EQ(symbolBucket.get(), tile.getBucket(*symbolLayer.baseImpl));
 }
 
+TEST(VectorTile, DependsOnImages) {
+    VectorTileTest test;
+    VectorTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, test.tileset);
+
+    EXPECT_FALSE(tile.dependsOnImages({ "marker" }));
+
+    tile.onLayout(GeometryTile::LayoutResult {
+        std::unordered_map<std::string, std::shared_ptr<Bucket>>(),
+        nullptr,
+        nullptr,
+        { "marker", "airport" },
+        0
+    });
+
+    EXPECT_TRUE(tile.dependsOnImages({ "marker" }));
+    EXPECT_TRUE(tile.dependsOnImages({ "park", "airport" }));
+    EXPECT_FALSE(tile.dependsOnImages({ "park" }));
+    EXPECT_FALSE(tile.dependsOnImages({}));
+
+    // A subsequent layout without icons no longer depends on any image.
+    tile.onLayout(GeometryTile::LayoutResult {
+        std::unordered_map<std::string, std::shared_ptr<Bucket>>(),
+        nullptr,
+        nullptr,
+        {},
+        0
+    });
+
+    EXPECT_FALSE(tile.dependsOnImages({ "marker" }));
+}
+
 TEST(VectorTile, Issue8542) {
     VectorTileTest test;
     VectorTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, test.tileset);
@@ -108,3 +146,47 @@ TEST(VectorTile, Issue8542) {
     std::vector<Feature> result;
     tile.querySourceFeatures(result, { { {"layer"} }, {} });
 }
+
+TEST(VectorTileData, IndexedValues) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    std::size_t checked = 0;
+    for (const auto& name : data.layerNames()) {
+        auto layer = data.getLayer(name);
+        ASSERT_TRUE(bool(layer));
+
+        EXPECT_TRUE(bool(layer->getKeyIndex("no-such-key")));
+
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            auto feature = layer->getFeature(i);
+            EXPECT_FALSE(feature->getValue("no-such-key"));
+            EXPECT_FALSE(feature->getIndexedValue(*layer->getKeyIndex("no-such-key")));
+
+            for (const auto& property : feature->getProperties()) {
+                optional<std::size_t> index = layer->getKeyIndex(property.first);
+                ASSERT_TRUE(bool(index));
+                EXPECT_EQ(optional<Value>(property.second), feature->getIndexedValue(*index));
+                EXPECT_EQ(optional<Value>(property.second), feature->getValue(property.first));
+                checked++;
+            }
+        }
+    }
+
+    EXPECT_GT(checked, 0u);
+}
+
+TEST(VectorTileData, Compressed) {
+    const std::string raw = util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf");
+    const std::string compressed = util::compress(raw);
+    VectorTileData plain(std::make_shared<std::string>(raw));
+    VectorTileData data(std::make_shared<std::string>(compressed), true);
+
+    // The data stays compressed until it is parsed.
+    EXPECT_EQ(compressed.size(), data.byteSize());
+
+    ASSERT_EQ(plain.layerNames(), data.layerNames());
+    for (const auto& name : plain.layerNames()) {
+        EXPECT_EQ(plain.getLayer(name)->featureCount(), data.getLayer(name)->featureCount());
+    }
+    EXPECT_EQ(raw.size(), data.byteSize());
+}
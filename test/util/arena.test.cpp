@@ -0,0 +1,54 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/arena.hpp>
+
+#include <cstdint>
+
+using namespace mbgl;
+
+TEST(Arena, Allocate) {
+    Arena arena(64);
+    EXPECT_EQ(0u, arena.capacity());
+
+    auto a = static_cast<char*>(arena.allocate(3, 1));
+    auto b = static_cast<char*>(arena.allocate(8, 8));
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(b) % 8);
+    EXPECT_LE(a + 3, b);
+    EXPECT_EQ(2u, arena.allocationCount());
+    EXPECT_EQ(11u, arena.bytesAllocated());
+    EXPECT_EQ(64u, arena.capacity());
+
+    // Doesn't fit into the first block.
+    arena.allocate(100, 4);
+    EXPECT_EQ(64u + 128u, arena.capacity());
+}
+
+TEST(Arena, Reset) {
+    Arena arena(64);
+    arena.allocate(32, 1);
+    arena.allocate(64, 1);
+    arena.allocate(200, 1);
+    EXPECT_EQ(64u + 128u + 256u, arena.capacity());
+
+    arena.reset();
+    EXPECT_EQ(0u, arena.allocationCount());
+    EXPECT_EQ(0u, arena.bytesAllocated());
+    EXPECT_EQ(256u, arena.capacity());
+
+    // The retained block is reused.
+    arena.allocate(200, 1);
+    EXPECT_EQ(256u, arena.capacity());
+}
+
+TEST(Arena, Vector) {
+    Arena arena;
+    ArenaVector<int> values(arena);
+    for (int i = 0; i < 1000; i++) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(999, values.back());
+    EXPECT_LT(0u, arena.allocationCount());
+
+    ArenaVector<int> copy(values.begin(), values.end(), arena);
+    EXPECT_EQ(values, copy);
+}
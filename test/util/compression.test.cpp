@@ -0,0 +1,40 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <stdexcept>
+
+using namespace mbgl;
+using namespace std::literals::string_literals;
+
+TEST(Compression, RoundTrip) {
+    const std::string raw = util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf");
+
+    // Streams are reused across calls, so compress several times to make sure they're reset.
+    for (int i = 0; i < 3; i++) {
+        const std::string compressed = util::compress(raw);
+        EXPECT_LT(compressed.size(), raw.size());
+        EXPECT_EQ(raw, util::decompress(compressed));
+    }
+
+    EXPECT_EQ("", util::decompress(util::compress("")));
+    EXPECT_EQ(raw, util::zlib().decompress(util::zlib().compress(raw)));
+}
+
+TEST(Compression, Gzip) {
+    // "Hello, World!" as compressed by gzip.
+    const std::string gzip = "\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03\xf3\x48\xcd\xc9\xc9\xd7"
+                             "\x51\x08\xcf\x2f\xca\x49\x51\x04\x00\xd0\xc3\x4a\xec\x0d\x00\x00\x00"s;
+    EXPECT_EQ("Hello, World!", util::decompress(gzip));
+}
+
+TEST(Compression, Invalid) {
+    EXPECT_THROW(util::decompress("invalid"), std::runtime_error);
+
+    const std::string compressed = util::compress(std::string(1024, 'x'));
+    EXPECT_THROW(util::decompress(compressed.substr(0, compressed.size() / 2)), std::runtime_error);
+
+    // A failed call doesn't affect the following ones.
+    EXPECT_EQ(std::string(1024, 'x'), util::decompress(compressed));
+}
@@ -163,3 +163,25 @@ TEST(Image, Premultiply) {
     EXPECT_EQ(0u, rgba.size.width);
     EXPECT_EQ(0u, rgba.size.height);
 }
+
+TEST(Image, PremultiplyAllValues) {
+    // Every combination of color and alpha, plus a pixel left over for the non-vectorized loop.
+    UnassociatedImage rgba({ 256 * 256 + 1, 1 });
+    for (uint32_t i = 0; i < rgba.size.width; i++) {
+        rgba.data[i * 4 + 0] = i / 256;
+        rgba.data[i * 4 + 1] = 255 - i / 256;
+        rgba.data[i * 4 + 2] = i / 256;
+        rgba.data[i * 4 + 3] = i % 256;
+    }
+    const UnassociatedImage expected = rgba.clone();
+
+    PremultipliedImage image = util::premultiply(std::move(rgba));
+    for (uint32_t i = 0; i < image.size.width; i++) {
+        const uint8_t* src = expected.data.get() + i * 4;
+        const uint8_t* dst = image.data.get() + i * 4;
+        for (uint32_t c = 0; c < 3; c++) {
+            ASSERT_EQ((src[c] * src[3] + 127) / 255, dst[c]) << "pixel " << i << ", channel " << c;
+        }
+        ASSERT_EQ(src[3], dst[3]);
+    }
+}
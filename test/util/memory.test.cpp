@@ -168,3 +168,61 @@ TEST(Memory, Footprint) {
     ASSERT_LT(rasterFootprint, 25 * 1024 * 1024) << "\
         mbgl::Map footprint over 25MB for raster styles.";
 }
+
+// Compares the footprint of maps that each own a GL context with maps that share
+// a single backend, and with it one set of compiled programs and static buffers.
+TEST(Memory, SharedBackendFootprint) {
+    if (!shouldRunFootprint()) {
+        return;
+    }
+
+    MemoryTest test;
+
+    class FrontendAndMap {
+    public:
+        FrontendAndMap(MemoryTest& test_, std::shared_ptr<HeadlessBackend> backend)
+            : frontend(Size{ 256, 256 }, 2, test_.fileSource, test_.threadPool, std::move(backend))
+            , map(frontend, MapObserver::nullObserver(), frontend.getSize(), 2, test_.fileSource, test_.threadPool, MapMode::Still) {
+            map.setZoom(16);
+            map.getStyle().loadURL("mapbox://streets");
+            frontend.render(map);
+        }
+
+        HeadlessFrontend frontend;
+        Map map;
+    };
+
+    auto makeBackend = [] {
+        return std::make_shared<HeadlessBackend>(Size{ 512, 512 });
+    };
+
+    // Warm up buffers and cache.
+    for (unsigned i = 0; i < 10; ++i) {
+        FrontendAndMap(test, makeBackend());
+    }
+
+    test.runLoop.runOnce();
+
+    unsigned runs = 15;
+
+    std::vector<std::unique_ptr<FrontendAndMap>> unique;
+    long uniqueInitialRSS = mbgl::test::getCurrentRSS();
+    for (unsigned i = 0; i < runs; ++i) {
+        unique.emplace_back(std::make_unique<FrontendAndMap>(test, makeBackend()));
+    }
+    double uniqueFootprint = (mbgl::test::getCurrentRSS() - uniqueInitialRSS) / double(runs);
+
+    auto backend = makeBackend();
+    std::vector<std::unique_ptr<FrontendAndMap>> shared;
+    long sharedInitialRSS = mbgl::test::getCurrentRSS();
+    for (unsigned i = 0; i < runs; ++i) {
+        shared.emplace_back(std::make_unique<FrontendAndMap>(test, backend));
+    }
+    double sharedFootprint = (mbgl::test::getCurrentRSS() - sharedInitialRSS) / double(runs);
+
+    RecordProperty("uniqueBackendFootprint", uniqueFootprint);
+    RecordProperty("sharedBackendFootprint", sharedFootprint);
+
+    ASSERT_LT(sharedFootprint, uniqueFootprint) << "\
+        Sharing a backend should not cost more memory per map than owning one.";
+}